@@ -0,0 +1,77 @@
+/*!
+ * DetectorGeometry.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef DETECTORGEOMETRY_H_
+#define DETECTORGEOMETRY_H_
+
+#include <stddef.h>
+
+namespace FrameReceiver
+{
+    //! DetectorGeometry - compile-time frame and packet geometry of a detector
+    //!
+    //! This template derives the frame layout of a detector from a geometry traits structure, so
+    //! that decoders templated on the geometry have all packet sizes, counts and offsets as
+    //! compile-time constants in their per-packet code. The traits structure must define the
+    //! following static constants:
+    //!
+    //!   primary_packet_size    - payload size of primary packets in bytes
+    //!   num_primary_packets    - number of primary packets per subframe
+    //!   tail_packet_size       - payload size of the tail packets ending each subframe
+    //!   num_tail_packets       - number of tail packets per subframe
+    //!   num_subframes          - number of subframes per data type
+    //!   num_data_types         - number of data types per frame
+    //!   packet_header_size     - size of the packet header preceding each payload
+    //!   packet_type_offset     - offset of the 8-bit packet (data) type in the header
+    //!   subframe_number_offset - offset of the 8-bit subframe number in the header
+    //!   frame_number_offset    - offset of the 32-bit big-endian frame number in the header
+    //!   packet_number_offset   - offset of the 16-bit big-endian packet number in the header
+    //!
+    //! Frame data are laid out in order of data type, subframe and packet, each subframe holding
+    //! its primary packets followed by its tail packets.
+
+    template<class Traits>
+    struct DetectorGeometry : public Traits
+    {
+        static const size_t num_subframe_packets = Traits::num_primary_packets + Traits::num_tail_packets;
+        static const size_t num_frame_packets    = Traits::num_data_types * Traits::num_subframes * num_subframe_packets;
+        static const size_t subframe_size        = (Traits::num_primary_packets * Traits::primary_packet_size) +
+                (Traits::num_tail_packets * Traits::tail_packet_size);
+        static const size_t data_type_size       = subframe_size * Traits::num_subframes;
+        static const size_t total_frame_size     = data_type_size * Traits::num_data_types;
+
+        //! Returns the index of a packet in the frame, in order of data type, subframe and packet
+        static inline size_t packet_index(unsigned int type, unsigned int subframe, unsigned int packet_number)
+        {
+            return (((type * Traits::num_subframes) + subframe) * num_subframe_packets) + packet_number;
+        }
+
+        //! Returns the offset of the payload of a packet in the frame data
+        static inline size_t payload_offset(unsigned int type, unsigned int subframe, unsigned int packet_number)
+        {
+            size_t packet_offset = (packet_number < Traits::num_primary_packets) ?
+                    (packet_number * Traits::primary_packet_size) :
+                    ((Traits::num_primary_packets * Traits::primary_packet_size) +
+                            ((packet_number - Traits::num_primary_packets) * Traits::tail_packet_size));
+            return (type * data_type_size) + (subframe * subframe_size) + packet_offset;
+        }
+
+        //! Returns the payload size of a packet in a subframe
+        static inline size_t payload_size(unsigned int packet_number)
+        {
+            return (packet_number < Traits::num_primary_packets) ? Traits::primary_packet_size : Traits::tail_packet_size;
+        }
+    };
+
+    template<class Traits> const size_t DetectorGeometry<Traits>::num_subframe_packets;
+    template<class Traits> const size_t DetectorGeometry<Traits>::num_frame_packets;
+    template<class Traits> const size_t DetectorGeometry<Traits>::subframe_size;
+    template<class Traits> const size_t DetectorGeometry<Traits>::data_type_size;
+    template<class Traits> const size_t DetectorGeometry<Traits>::total_frame_size;
+
+} // namespace FrameReceiver
+
+#endif /* DETECTORGEOMETRY_H_ */
@@ -0,0 +1,57 @@
+/*!
+ * EmptyBufferQueue.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef EMPTYBUFFERQUEUE_H_
+#define EMPTYBUFFERQUEUE_H_
+
+#include <stddef.h>
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include "FrameReceiverException.h"
+
+namespace FrameReceiver
+{
+    class EmptyBufferQueueException : public FrameReceiverException
+    {
+    public:
+        EmptyBufferQueueException(const std::string what) : FrameReceiverException(what) { };
+    };
+
+    //! EmptyBufferQueue - lock-free queue of empty buffer IDs between two threads
+    //!
+    //! This class passes empty buffer IDs from a single producer thread, e.g. the main thread
+    //! handling frame release notifications, to a single consumer thread, e.g. an RX thread. IDs
+    //! are held in a lock-free ring and the consumer is woken through a file descriptor that can
+    //! be registered with its reactor. The descriptor is only signalled when the consumer has
+    //! not already been woken, so a burst of releases costs one wakeup.
+
+    class EmptyBufferQueue
+    {
+    public:
+
+        EmptyBufferQueue(size_t capacity);
+        ~EmptyBufferQueue();
+
+        // Producer interface
+        bool push(int buffer_id);
+
+        // Consumer interface
+        int get_notify_fd(void) const;
+        void clear_notification(void);
+        inline bool pop(int& buffer_id) { return queue_.pop(buffer_id); };
+
+    private:
+
+        boost::lockfree::spsc_queue<int> queue_; //!< Ring of buffer IDs
+        volatile int signalled_;                 //!< Set when the consumer has been signalled
+        int notify_fd_;                          //!< Descriptor the consumer polls for notifications
+        int notify_write_fd_;                    //!< Descriptor the producer signals notifications on
+    };
+
+} // namespace FrameReceiver
+
+#endif /* EMPTYBUFFERQUEUE_H_ */
@@ -0,0 +1,123 @@
+/*!
+ * FrameBufferTable.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef FRAMEBUFFERTABLE_H_
+#define FRAMEBUFFERTABLE_H_
+
+#include <vector>
+#include <utility>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include "FrameSlotTable.h"
+
+namespace FrameReceiver
+{
+    //! Callback used to initialise a frame buffer when it is first allocated to a frame number,
+    //! called with the buffer ID, frame number and acquisition number of the allocation
+    typedef boost::function<void(int, uint32_t, uint32_t)> FrameBufferInitialiser;
+
+    //! FrameBufferTable - thread-safe frame number to frame buffer mapping
+    //!
+    //! This class holds the queue of empty frame buffers and the mapping of frame numbers to the
+    //! buffers they are being assembled into. A single table may be shared by the frame decoders of
+    //! several RX threads, so that a frame whose packets arrive on different ports or sockets is
+    //! assembled into a single buffer. Decoders only need to consult the table when the frame number
+    //! of incoming packets changes, so access is serialised with a mutex.
+    //!
+    //! The table is sized once for the number of frame buffers in circulation, after which pushing,
+    //! acquiring and releasing buffers does not allocate memory and buffer IDs outside that number
+    //! are rejected.
+    //!
+    //! Each allocation of a buffer to a frame is given an acquisition number, so that a release
+    //! tracked for one allocation, e.g. a frame timeout, cannot release a later allocation of the
+    //! same frame number to the same buffer.
+    //!
+    //! Decoders sharing a table write packets into a frame buffer between begin_write() and
+    //! end_write(). A successful release_buffer() only returns once no decoder is writing to the
+    //! buffer, and a decoder beginning to write after the release sees it and backs off, so a frame
+    //! released by one decoder, e.g. on timeout, is never written to by another once handed on.
+    //! Shared tables must be sized with reserve_buffers() before decoders start writing.
+
+    class FrameBufferTable
+    {
+    public:
+
+        FrameBufferTable();
+        ~FrameBufferTable();
+
+        void attach_decoder(void);
+        bool is_shared(void) const;
+
+        void reserve_buffers(size_t num_buffers);
+        bool push_empty_buffer(int buffer_id);
+        const size_t get_num_empty_buffers(void);
+        const size_t get_num_mapped_buffers(void);
+
+        int acquire_buffer(uint32_t frame_number, const FrameBufferInitialiser& initialiser);
+        bool release_buffer(uint32_t frame_number, int buffer_id);
+        bool release_buffer(uint32_t frame_number, int buffer_id, uint32_t acquisition);
+        void get_mapped_buffers(std::vector<std::pair<uint32_t, int> >& mapped_buffers);
+
+        //! Returns the number of buffers released from the table so far. Decoders compare this
+        //! against a cached value to detect, without locking, that a frame they are receiving may
+        //! have been released by another thread. The acquire load pairs with the release increment
+        //! in release_buffer(), so a changed count is seen no earlier than the table update.
+        inline const uint32_t get_release_count(void) const
+        {
+            return __atomic_load_n(&release_count_, __ATOMIC_ACQUIRE);
+        };
+
+        //! Registers a decoder as writing to a buffer it looked up when the release count was as
+        //! specified. Returns false, without registering, if a buffer has been released since, in
+        //! which case the decoder must look the buffer up again. The full barrier of the increment
+        //! orders it before the release count is re-read, pairing with the barrier in
+        //! release_buffer() between releasing and checking for writers.
+        inline bool begin_write(int buffer_id, uint32_t release_count)
+        {
+            __sync_fetch_and_add(&writers_[buffer_id], 1);
+            if (get_release_count() != release_count)
+            {
+                end_write(buffer_id);
+                return false;
+            }
+            return true;
+        };
+
+        //! Deregisters a decoder as writing to a buffer
+        inline void end_write(int buffer_id)
+        {
+            __sync_fetch_and_sub(&writers_[buffer_id], 1);
+        };
+
+    private:
+
+        void resize(size_t num_buffers);
+        void wait_for_writers(int buffer_id);
+
+        boost::mutex            mutex_;               //!< Mutex serialising access to the table
+        size_t                  num_buffers_;         //!< Number of frame buffers in circulation, zero if the table is unsized
+        std::vector<int>        empty_buffers_;       //!< Ring of empty buffer IDs
+        size_t                  empty_head_;          //!< Index of the next empty buffer in the ring
+        size_t                  num_empty_;           //!< Number of empty buffers in the ring
+        FrameSlotTable          frame_slot_table_;    //!< Mapping of frame number to buffer ID
+        std::vector<uint32_t>   acquisitions_;        //!< Acquisition number of the frame mapped to each buffer, by buffer ID
+        uint32_t                last_acquisition_;    //!< Acquisition number of the last buffer allocated
+        std::vector<uint32_t>   writers_;             //!< Number of decoders writing to each buffer, by buffer ID, accessed atomically
+        uint32_t                release_count_;       //!< Count of buffers released from the mapping, accessed atomically
+        unsigned int            num_decoders_;        //!< Number of frame decoders using the table
+    };
+
+    typedef boost::shared_ptr<FrameBufferTable> FrameBufferTablePtr;
+
+} // namespace FrameReceiver
+
+#endif /* FRAMEBUFFERTABLE_H_ */
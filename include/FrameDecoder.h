@@ -8,12 +8,13 @@
 #ifndef INCLUDE_FRAMEDECODER_H_
 #define INCLUDE_FRAMEDECODER_H_
 
-#include <queue>
-#include <map>
-
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <netinet/in.h>
+#include <time.h>
+#include <map>
+#include <string>
 
 #include <boost/shared_ptr.hpp>
 #include <boost/function.hpp>
@@ -25,6 +26,7 @@ using namespace log4cxx::helpers;
 
 #include "FrameReceiverException.h"
 #include "SharedBufferManager.h"
+#include "FrameBufferTable.h"
 
 namespace FrameReceiver
 {
@@ -36,6 +38,19 @@ namespace FrameReceiver
 
     typedef boost::function<void(int, int)> FrameReadyCallback;
 
+    //! Decoder-specific configuration parameters, by name
+    typedef std::map<std::string, std::string> FrameDecoderParams;
+
+    //! Datagram received by an RX thread, with its packet header and payload in separate buffers
+    typedef struct
+    {
+        const void*         header;         //!< Packet header, of the size given by the decoder
+        const void*         payload;        //!< Payload following the header
+        size_t              bytes_received; //!< Total size of the datagram received, including the header
+        int                 port;           //!< Port the datagram was received on
+        struct sockaddr_in* from_addr;      //!< Source address of the datagram
+    } ReceivedDatagram;
+
     class FrameDecoder
     {
     public:
@@ -51,17 +66,27 @@ namespace FrameReceiver
 
         FrameDecoder(LoggerPtr& logger, bool enable_packet_logging) :
             logger_(logger),
-            enable_packet_logging_(enable_packet_logging)
+            enable_packet_logging_(enable_packet_logging),
+            frame_buffer_table_(new FrameBufferTable())
         {
+            frame_buffer_table_->attach_decoder();
+
             // Retrieve the packet logger instance
             packet_logger_ = Logger::getLogger("PacketLogger");
         };
 
         virtual ~FrameDecoder() = 0;
 
+        // Decoders may take specific configuration parameters, which are applied once after
+        // construction. Decoders should throw a FrameDecoderException for invalid parameters.
+        virtual void configure(const FrameDecoderParams& params) { }
+
+        // The frame buffer table is sized for the buffers of the buffer manager when it is
+        // registered, so that it does not allocate memory while frames are received
         void register_buffer_manager(SharedBufferManagerPtr buffer_manager)
         {
             buffer_manager_ = buffer_manager;
+            frame_buffer_table_->reserve_buffers(buffer_manager_->get_num_buffers());
         }
 
         void register_frame_ready_callback(FrameReadyCallback callback)
@@ -69,34 +94,114 @@ namespace FrameReceiver
         	ready_callback_ = callback;
         }
 
+        // Decoders have a private frame buffer table by default. Decoders running in separate RX
+        // threads can share a table so that frames are assembled into a single buffer whichever
+        // thread receives their packets.
+        void register_frame_buffer_table(FrameBufferTablePtr frame_buffer_table)
+        {
+            frame_buffer_table_ = frame_buffer_table;
+            frame_buffer_table_->attach_decoder();
+            if (buffer_manager_)
+            {
+                frame_buffer_table_->reserve_buffers(buffer_manager_->get_num_buffers());
+            }
+        }
+
+        // Frame data is received into the frame buffers, while the frame header is held in the
+        // separate metadata slot of each buffer in the shared buffer manager
         virtual const size_t get_frame_buffer_size(void) const = 0;
         virtual const size_t get_frame_header_size(void) const = 0;
 
+        // Decoders requiring a header peek have process_packet_header() called on a peeked copy of
+        // the packet header before each receive, so that the payload is received directly into the
+        // buffer returned by get_next_payload_buffer(). Otherwise the decoder operates in
+        // decode-after-receive mode: the whole datagram is received into the header buffer and the
+        // payload location offered in advance by get_next_payload_buffer(), after which
+        // process_packet_header() is called and the decoder must relocate the payload if it was
+        // not received into its final destination.
         virtual const bool requires_header_peek(void) const = 0;
 
         virtual const size_t get_packet_header_size(void) const = 0;
         virtual void* get_packet_header_buffer(void) = 0;
 		virtual void process_packet_header(size_t bytes_received, int port, struct sockaddr_in* from_addr) = 0;
 
+        // A decoder may offer a next payload size of zero to discard the payload of a packet it
+        // does not want, e.g. one belonging to a frame that is being dropped, in which case the
+        // datagram is received truncated to its header without copying the payload
         virtual void* get_next_payload_buffer(void) const = 0;
         virtual size_t get_next_payload_size(void) const = 0;
+        virtual const size_t get_max_payload_size(void) const = 0;
         virtual FrameReceiveState process_packet(size_t bytes_received) = 0;
 
+        // Decoders may handle a batch of datagrams already received into staging buffers, e.g. by
+        // recvmmsg, in a single call. The default implementation hands each datagram to the per-packet
+        // methods above in turn, copying its payload into the location offered by the decoder.
+        // Decoders should override this to decode each header once and place payloads directly.
+        virtual void process_packets(const ReceivedDatagram* datagrams, size_t num_datagrams)
+        {
+            size_t header_size = get_packet_header_size();
+            bool   header_peek = requires_header_peek();
+
+            for (size_t idx = 0; idx < num_datagrams; idx++)
+            {
+                const ReceivedDatagram& datagram = datagrams[idx];
+                size_t payload_bytes = (datagram.bytes_received > header_size) ? (datagram.bytes_received - header_size) : 0;
+
+                memcpy(get_packet_header_buffer(), datagram.header, header_size);
+
+                if (header_peek)
+                {
+                    process_packet_header(datagram.bytes_received, datagram.port, datagram.from_addr);
+                }
+
+                size_t payload_size = get_next_payload_size();
+                memcpy(get_next_payload_buffer(), datagram.payload, (payload_bytes < payload_size) ? payload_bytes : payload_size);
+
+                // Decoders without a header peek decode the header after the payload has been placed at
+                // the predicted location, relocating it if the prediction was wrong
+                if (!header_peek)
+                {
+                    process_packet_header(datagram.bytes_received, datagram.port, datagram.from_addr);
+                }
+
+                process_packet(datagram.bytes_received);
+            }
+        }
+
         virtual void monitor_buffers(void) = 0;
 
-        void push_empty_buffer(int buffer_id)
+        // Decoders may release incomplete frames whose timeout has expired. This is called at a short
+        // interval from the RX thread reactor, so should only touch frames that have actually expired.
+        virtual void check_frame_timeouts(void) { }
+
+        // Decoders may report the receive state and start time recorded in the header of a frame
+        // buffer, for inclusion in binary frame ready notifications. Returns false if unsupported.
+        virtual bool get_frame_status(int buffer_id, FrameReceiveState& frame_state, struct timespec& frame_start_time) const
+        {
+            return false;
+        }
+
+        // Decoders may report the number of frames dropped, e.g. for lack of a free buffer, for
+        // inclusion in the RX thread statistics.
+        virtual const unsigned int get_num_dropped_frames(void) const
+        {
+            return 0;
+        }
+
+        // Returns false if the buffer ID is outside the buffers of the registered buffer manager
+        bool push_empty_buffer(int buffer_id)
         {
-        	empty_buffer_queue_.push(buffer_id);
+        	return frame_buffer_table_->push_empty_buffer(buffer_id);
         }
 
         const size_t get_num_empty_buffers(void) const
         {
-        	return empty_buffer_queue_.size();
+        	return frame_buffer_table_->get_num_empty_buffers();
         }
 
         const size_t get_num_mapped_buffers(void) const
         {
-            return frame_buffer_map_.size();
+            return frame_buffer_table_->get_num_mapped_buffers();
         }
 
     protected:
@@ -108,8 +213,7 @@ namespace FrameReceiver
         SharedBufferManagerPtr buffer_manager_;
         FrameReadyCallback   ready_callback_;
 
-        std::queue<int>    empty_buffer_queue_;
-        std::map<uint32_t, int> frame_buffer_map_;
+        FrameBufferTablePtr  frame_buffer_table_;
     };
 
     inline FrameDecoder::~FrameDecoder() {};
@@ -0,0 +1,82 @@
+/*!
+ * FrameDecoderRegistry.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef FRAMEDECODERREGISTRY_H_
+#define FRAMEDECODERREGISTRY_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FrameDecoder.h"
+#include "FrameReceiverException.h"
+
+namespace FrameReceiver
+{
+    class FrameDecoderRegistryException : public FrameReceiverException
+    {
+    public:
+        FrameDecoderRegistryException(const std::string what) : FrameReceiverException(what) { };
+    };
+
+    //! Factory function creating a frame decoder instance, taking the arguments common to all decoders
+    typedef FrameDecoder* (*FrameDecoderFactory)(LoggerPtr& logger, bool enable_packet_logging,
+            unsigned int frame_timeout_ms);
+
+    //! Default factory function for decoder classes with the common constructor signature
+    template<class DecoderType>
+    FrameDecoder* create_frame_decoder(LoggerPtr& logger, bool enable_packet_logging, unsigned int frame_timeout_ms)
+    {
+        return new DecoderType(logger, enable_packet_logging, frame_timeout_ms);
+    }
+
+    class FrameDecoderRegistry;
+
+    //! Entry point of a decoder plugin library, registering the decoders it provides
+    typedef void (*FrameDecoderPluginEntry)(FrameDecoderRegistry& registry);
+
+    //! FrameDecoderRegistry - registry of the frame decoders available by sensor type name
+    //!
+    //! This class maps sensor type names to factory functions creating the frame decoder for that
+    //! sensor. The decoders built into the frame receiver are registered on construction. Further
+    //! decoders can be loaded at runtime from plugin shared libraries, each of which must export
+    //! an entry point with C linkage that registers its decoders, e.g.
+    //!
+    //!   extern "C" void register_frame_decoders(FrameReceiver::FrameDecoderRegistry& registry)
+    //!   {
+    //!       registry.register_decoder("mydetector", &FrameReceiver::create_frame_decoder<MyDetectorFrameDecoder>);
+    //!   }
+    //!
+    //! Plugins are built against the frame receiver headers and resolve the symbols of common
+    //! classes such as FrameBufferTable from the frame receiver executable. Plugin libraries are
+    //! never unloaded, since decoders created from them may outlive the registry.
+
+    class FrameDecoderRegistry
+    {
+    public:
+
+        static const char* plugin_entry_symbol; //!< Name of the entry point exported by decoder plugins
+
+        FrameDecoderRegistry();
+
+        void register_decoder(const std::string& sensor_name, FrameDecoderFactory factory);
+        void load_plugin(const std::string& plugin_path);
+
+        bool has_decoder(const std::string& sensor_name) const;
+        std::vector<std::string> get_sensor_names(void) const;
+
+        FrameDecoderPtr create_decoder(const std::string& sensor_name, LoggerPtr& logger,
+                bool enable_packet_logging, unsigned int frame_timeout_ms,
+                const FrameDecoderParams& params) const;
+
+    private:
+
+        std::map<std::string, FrameDecoderFactory> factories_; //!< Decoder factories by sensor type name
+    };
+
+} // namespace FrameReceiver
+
+#endif /* FRAMEDECODERREGISTRY_H_ */
@@ -9,6 +9,7 @@
 #define FRAMERECEIVERAPP_H_
 
 #include <string>
+#include <vector>
 using namespace std;
 
 #include <time.h>
@@ -32,7 +33,11 @@ using namespace log4cxx::helpers;
 #include "FrameReceiverConfig.h"
 #include "FrameReceiverRxThread.h"
 #include "FrameDecoder.h"
-#include "PercivalEmulatorFrameDecoder.h"
+#include "FrameDecoderRegistry.h"
+#include "FrameBufferTable.h"
+#include "IpcFrameNotification.h"
+#include "NotificationRing.h"
+#include "NotificationRingWatcher.h"
 #include "FrameReceiverException.h"
 
 namespace FrameReceiver
@@ -64,22 +69,34 @@ namespace FrameReceiver
         void initialise_frame_decoder(void);
         void initialise_buffer_manager(void);
         void precharge_buffers(void);
+        void configure_rx_notifications(void);
+        void initialise_notification_rings(void);
 
         void handle_ctrl_channel(void);
-        void handle_rx_channel(void);
+        void handle_rx_channel(unsigned int rx_thread);
         void handle_frame_release_channel(void);
+        void handle_frame_release(int frame_number, int buffer_id);
+        bool push_ready_ring(const IpcFrameNotification& ready_notification);
+        void handle_release_ring(void);
+        void release_empty_buffer(int buffer_id);
+        void add_status_params(IpcMessage& status_reply);
         void rx_ping_timer_handler(void);
         void timer_handler2(void);
 
 		LoggerPtr             logger_;                           //!< Log4CXX logger instance pointer
 		FrameReceiverConfig   config_;                           //!< Configuration storage object
-		boost::scoped_ptr<FrameReceiverRxThread> rx_thread_;     //!< Receiver thread object
-		FrameDecoderPtr frame_decoder_;          //!< Frame decoder object
+		std::vector<boost::shared_ptr<FrameReceiverRxThread> > rx_threads_; //!< Receiver thread objects
+		unsigned int next_rx_thread_;            //!< Index of RX thread to release the next empty buffer to
+		FrameDecoderRegistry  decoder_registry_;                 //!< Registry of available frame decoders
+		std::vector<FrameDecoderPtr> frame_decoders_; //!< Frame decoder objects, one per receiver thread
 		SharedBufferManagerPtr buffer_manager_;  //!< Buffer manager object
+		boost::scoped_ptr<NotificationRing> ready_ring_;   //!< Shared memory frame ready notification ring
+		boost::scoped_ptr<NotificationRing> release_ring_; //!< Shared memory frame release notification ring
+		boost::scoped_ptr<NotificationRingWatcher> release_ring_watcher_; //!< Wakes the reactor when releases are pushed onto the ring
 
 		static bool terminate_frame_receiver_;
 
-		IpcChannel rx_channel_;
+		std::vector<boost::shared_ptr<IpcChannel> > rx_channels_;
 		IpcChannel ctrl_channel_;
 		IpcChannel frame_ready_channel_;
 		IpcChannel frame_release_channel_;
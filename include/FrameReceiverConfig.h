@@ -15,6 +15,8 @@
 #include <map>
 #include <vector>
 #include <iostream>
+#include <sstream>
+#include <cstdlib>
 #include "FrameReceiverDefaults.h"
 
 namespace FrameReceiver
@@ -28,13 +30,26 @@ namespace FrameReceiver
 		    sensor_type_(Defaults::SensorTypeIllegal),
 		    rx_address_(Defaults::default_rx_address),
 		    rx_recv_buffer_size_(Defaults::default_rx_recv_buffer_size),
+		    rx_batch_size_(Defaults::default_rx_batch_size),
+		    rx_threads_(Defaults::default_rx_threads),
+		    rx_reuse_port_(Defaults::default_rx_reuse_port),
+		    main_cpu_(Defaults::default_main_cpu),
+		    rx_priority_(Defaults::default_rx_priority),
+		    numa_node_(Defaults::numa_node_none),
+		    notify_format_(Defaults::NotificationFormatJson),
+		    notify_ring_(Defaults::default_notify_ring),
 		    rx_channel_endpoint_(Defaults::default_rx_chan_endpoint),
 		    ctrl_channel_endpoint_(Defaults::default_ctrl_chan_endpoint),
 		    frame_ready_endpoint_(Defaults::default_frame_ready_endpoint),
 		    frame_release_endpoint_(Defaults::default_frame_release_endpoint),
 		    shared_buffer_name_(Defaults::default_shared_buffer_name),
+		    buffer_huge_pages_(Defaults::default_buffer_huge_pages),
+		    buffer_prefault_(Defaults::default_buffer_prefault),
+		    buffer_lock_(Defaults::default_buffer_lock),
 		    frame_timeout_ms_(Defaults::default_frame_timeout_ms),
-		    enable_packet_logging_(Defaults::default_enable_packet_logging)
+		    frame_timeout_check_ms_(Defaults::default_frame_timeout_check_ms),
+		    enable_packet_logging_(Defaults::default_enable_packet_logging),
+		    rx_capture_file_(Defaults::default_rx_capture_file)
 		{
 		    tokenize_port_list(rx_ports_, Defaults::default_rx_port_list);
 		};
@@ -58,6 +73,93 @@ namespace FrameReceiver
             }
 		}
 
+		void tokenize_cpu_list(std::vector<int>& cpu_list, const std::string cpu_list_str)
+		{
+		    std::stringstream ss(cpu_list_str);
+		    std::string cpu_str;
+
+		    while (std::getline(ss, cpu_str, ','))
+		    {
+		        char* end_ptr;
+		        long cpu = strtol(cpu_str.c_str(), &end_ptr, 0);
+		        if ((end_ptr != cpu_str.c_str()) && (cpu >= 0))
+		        {
+		            cpu_list.push_back(static_cast<int>(cpu));
+		        }
+		    }
+		}
+
+		// Maps a NUMA node option value, which may be "none", "auto" or a node number, to a node
+		int map_numa_node_option(const std::string& numa_node_str)
+		{
+		    if (numa_node_str == "auto")
+		    {
+		        return Defaults::numa_node_auto;
+		    }
+
+		    char* end_ptr;
+		    long numa_node = strtol(numa_node_str.c_str(), &end_ptr, 0);
+		    if ((end_ptr == numa_node_str.c_str()) || (*end_ptr != '\0') || (numa_node < 0))
+		    {
+		        return Defaults::numa_node_none;
+		    }
+		    return static_cast<int>(numa_node);
+		}
+
+		// Maps a notification format name, "json" or "binary", to a format
+		Defaults::NotificationFormat map_notify_format_name(const std::string& format_name)
+		{
+		    if (format_name == "json")
+		    {
+		        return Defaults::NotificationFormatJson;
+		    }
+		    if (format_name == "binary")
+		    {
+		        return Defaults::NotificationFormatBinary;
+		    }
+		    return Defaults::NotificationFormatIllegal;
+		}
+
+		// Adds a decoder parameter given as "name=value", returning false if it is malformed
+		bool add_decoder_param(const std::string& param_str)
+		{
+		    std::size_t separator = param_str.find('=');
+		    if ((separator == std::string::npos) || (separator == 0))
+		    {
+		        return false;
+		    }
+		    decoder_params_[param_str.substr(0, separator)] = param_str.substr(separator + 1);
+		    return true;
+		}
+
+		// Returns the IPC channel endpoint for communication with the specified RX thread. A single
+		// RX thread uses the configured endpoint, multiple threads each have an indexed endpoint.
+		std::string get_rx_channel_endpoint(unsigned int rx_thread) const
+		{
+		    if (rx_threads_ <= 1)
+		    {
+		        return rx_channel_endpoint_;
+		    }
+
+		    std::stringstream ss;
+		    ss << rx_channel_endpoint_ << "_" << rx_thread;
+		    return ss.str();
+		}
+
+		// Returns the packet capture file name for the specified RX thread. A single RX thread uses
+		// the configured name, multiple threads each capture to a file with an indexed name.
+		std::string get_rx_capture_file(unsigned int rx_thread) const
+		{
+		    if (rx_capture_file_.empty() || (rx_threads_ <= 1))
+		    {
+		        return rx_capture_file_;
+		    }
+
+		    std::stringstream ss;
+		    ss << rx_capture_file_ << "." << rx_thread;
+		    return ss.str();
+		}
+
 		Defaults::SensorType map_sensor_name_to_type(std::string& sensor_name)
 		{
 
@@ -85,17 +187,34 @@ namespace FrameReceiver
 
 		std::size_t           max_buffer_mem_;         //!< Amount of shared buffer memory to allocate for frame buffers
 		Defaults::SensorType  sensor_type_;            //!< Sensor type receiving data for - drives frame size
+		std::string           sensor_name_;            //!< Sensor type name selecting the frame decoder
+		std::vector<std::string> decoder_plugins_;     //!< Paths of frame decoder plugin libraries to load
+		std::map<std::string, std::string> decoder_params_; //!< Decoder-specific configuration parameters
 		std::vector<uint16_t> rx_ports_;               //!< Port(s) to receive frame data on
 		std::string           rx_address_;             //!< IP address to receive frame data on
 		int                   rx_recv_buffer_size_;    //!< Receive socket buffer size
+		unsigned int          rx_batch_size_;          //!< Maximum number of datagrams to receive per socket wakeup
+		unsigned int          rx_threads_;             //!< Number of RX threads receiving frame data
+		bool                  rx_reuse_port_;          //!< Share all ports between RX threads with SO_REUSEPORT
+		std::vector<int>      rx_cpus_;                //!< CPU(s) to pin RX threads to, assigned to threads in turn
+		int                   main_cpu_;               //!< CPU to pin the main thread to, -1 for no pinning
+		int                   rx_priority_;            //!< SCHED_FIFO priority of RX threads, 0 for normal scheduling
+		int                   numa_node_;              //!< NUMA node to bind frame buffer memory to
+		Defaults::NotificationFormat notify_format_;   //!< Initial format of frame ready notifications sent to other processes
+		bool                  notify_ring_;            //!< Exchange frame notifications through rings in shared memory
 		std::string           rx_channel_endpoint_;    //!< IPC channel endpoint for RX thread communication
 		std::string           ctrl_channel_endpoint_;  //!< IPC channel endpoint for control communication with other processes
 		std::string           frame_ready_endpoint_;   //!< IPC channel endpoint for transmitting frame ready notifications to other processes
         std::string           frame_release_endpoint_; //!< IPC channel endpoint for receiving frame release notifications from other processes
 		std::string           shared_buffer_name_;     //!< Shared memory frame buffer name
+		bool                  buffer_huge_pages_;      //!< Back the shared frame buffer with huge pages
+		bool                  buffer_prefault_;        //!< Fault in the shared frame buffer at startup
+		bool                  buffer_lock_;            //!< Lock the shared frame buffer into memory
 		unsigned int          frame_timeout_ms_;       //!< Incomplete frame timeout in milliseconds
+		unsigned int          frame_timeout_check_ms_; //!< Interval between incomplete frame timeout checks in milliseconds
 		unsigned int          frame_count_;            //!< Number of frames to receive before terminating
 		bool                  enable_packet_logging_;  //!< Enable packet diagnostic logging
+		std::string           rx_capture_file_;        //!< File to capture received datagrams to, none if empty
 
 		friend class FrameReceiverApp;
 		friend class FrameReceiverRxThread;
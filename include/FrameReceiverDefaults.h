@@ -25,20 +25,43 @@ namespace FrameReceiver
 			SensorTypeExcalibur3M,
 		};
 
+		enum NotificationFormat
+		{
+			NotificationFormatIllegal = -1,
+			NotificationFormatJson,
+			NotificationFormatBinary,
+		};
+
 		const int          default_node                   = 1;
 		const std::size_t  default_max_buffer_mem         = 1048576;
 		const SensorType   default_sensor_type            = SensorTypeIllegal;
         const std::string  default_rx_port_list           = "8989,8990";
 		const std::string  default_rx_address             = "0.0.0.0";
 		const int          default_rx_recv_buffer_size    = 30000000;
+		const unsigned int default_rx_batch_size          = 1;
+		const unsigned int default_rx_threads             = 1;
+		const bool         default_rx_reuse_port          = false;
+		const std::string  default_rx_cpu_list            = "";
+		const int          default_main_cpu               = -1;
+		const int          default_rx_priority            = 0;
+		const int          numa_node_none                 = -1;
+		const int          numa_node_auto                 = -2;
+		const std::string  default_numa_node              = "none";
+		const std::string  default_notify_format          = "json";
+		const bool         default_notify_ring            = false;
 		const std::string  default_rx_chan_endpoint       = "inproc://rx_channel";
 		const std::string  default_ctrl_chan_endpoint     = "tcp://*:5000";
 		const std::string  default_frame_ready_endpoint   = "tcp://*:5001";
 		const std::string  default_frame_release_endpoint = "tcp://*:5002";
 		const std::string  default_shared_buffer_name     = "FrameReceiverBuffer";
+		const bool         default_buffer_huge_pages      = false;
+		const bool         default_buffer_prefault        = false;
+		const bool         default_buffer_lock            = false;
 		const unsigned int default_frame_timeout_ms       = 1000;
+		const unsigned int default_frame_timeout_check_ms = 5;
 		const unsigned int default_frame_count            = 0;
 		const bool         default_enable_packet_logging  = false;
+		const std::string  default_rx_capture_file        = "";
 
 	}
 }
@@ -0,0 +1,140 @@
+/*!
+ * FrameReceiverRxStats.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef FRAMERECEIVERRXSTATS_H_
+#define FRAMERECEIVERRXSTATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "IpcMessage.h"
+
+namespace FrameReceiver
+{
+    //! FrameReceiverRxStats - lock-free statistics block of an RX thread
+    //!
+    //! This class holds the operational counters of a single RX thread: packets and bytes received
+    //! in total and per port, receive system calls, frames released complete or timed out, frames
+    //! dropped by the decoder and the depths of the frame buffer queues. The counters are only
+    //! written by the RX thread and may be read at any time by other threads, e.g. the main thread
+    //! handling a status request, without pausing the RX thread. As there is a single writer, each
+    //! update is a relaxed atomic load and store rather than a locked read-modify-write, so
+    //! counting costs the RX thread no more than a plain increment. Readers see each counter
+    //! consistently, though not a consistent set of counters.
+    //!
+    //! Ports must be added before the RX thread starts updating the counters.
+
+    class FrameReceiverRxStats
+    {
+    public:
+
+        //! Counters of a receive port
+        typedef struct
+        {
+            uint16_t port;             //!< Port number
+            uint64_t packets_received; //!< Datagrams received on the port
+            uint64_t bytes_received;   //!< Bytes received on the port, including packet headers
+        } PortCounters;
+
+        //! Copy of the counters taken by a reader
+        typedef struct
+        {
+            uint64_t packets_received;  //!< Datagrams received on all ports
+            uint64_t bytes_received;    //!< Bytes received on all ports
+            uint64_t receive_calls;     //!< Receive system calls made, including those returning no data
+            uint64_t frames_complete;   //!< Frames released with all packets received
+            uint64_t frames_timedout;   //!< Frames released incomplete on timeout
+            uint64_t frames_released;   //!< All frames released, including those of unknown state
+            uint64_t frames_dropped;    //!< Frames dropped by the decoder for lack of a free buffer
+            uint64_t buffers_released;  //!< Empty buffers drained from the release queue
+            uint64_t empty_buffers;     //!< Depth of the empty frame buffer queue
+            uint64_t mapped_buffers;    //!< Frame buffers mapped to frames being received
+            std::vector<PortCounters> ports;
+        } Snapshot;
+
+        FrameReceiverRxStats();
+
+        unsigned int add_port(uint16_t port);
+        size_t get_num_ports(void) const;
+
+        // Writer interface, to be called from the RX thread only
+        inline void count_receive_calls(uint64_t calls)
+        {
+            increment(receive_calls_, calls);
+        }
+
+        inline void count_packets(unsigned int port_slot, uint64_t packets, uint64_t bytes)
+        {
+            increment(packets_received_, packets);
+            increment(bytes_received_, bytes);
+            increment(ports_[port_slot].packets_received, packets);
+            increment(ports_[port_slot].bytes_received, bytes);
+        }
+
+        inline void count_frame_released(bool complete, bool timedout)
+        {
+            increment(frames_released_, 1);
+            if (complete)
+            {
+                increment(frames_complete_, 1);
+            }
+            else if (timedout)
+            {
+                increment(frames_timedout_, 1);
+            }
+        }
+
+        inline void count_buffers_released(uint64_t buffers)
+        {
+            increment(buffers_released_, buffers);
+        }
+
+        inline void update_decoder_state(uint64_t frames_dropped, uint64_t empty_buffers, uint64_t mapped_buffers)
+        {
+            store(frames_dropped_, frames_dropped);
+            store(empty_buffers_, empty_buffers);
+            store(mapped_buffers_, mapped_buffers);
+        }
+
+        // Reader interface, may be called from any thread
+        void snapshot(Snapshot& snapshot) const;
+        void add_params(IpcMessage& msg, const std::string& prefix) const;
+
+    private:
+
+        static inline uint64_t load(const uint64_t& counter)
+        {
+            return __atomic_load_n(&counter, __ATOMIC_RELAXED);
+        }
+
+        static inline void store(uint64_t& counter, uint64_t value)
+        {
+            __atomic_store_n(&counter, value, __ATOMIC_RELAXED);
+        }
+
+        static inline void increment(uint64_t& counter, uint64_t value)
+        {
+            store(counter, load(counter) + value);
+        }
+
+        uint64_t packets_received_;
+        uint64_t bytes_received_;
+        uint64_t receive_calls_;
+        uint64_t frames_complete_;
+        uint64_t frames_timedout_;
+        uint64_t frames_released_;
+        uint64_t frames_dropped_;
+        uint64_t buffers_released_;
+        uint64_t empty_buffers_;
+        uint64_t mapped_buffers_;
+        std::vector<PortCounters> ports_; //!< Port counters, indexed by the slot returned by add_port()
+    };
+
+} // namespace FrameReceiver
+
+#endif /* FRAMERECEIVERRXSTATS_H_ */
@@ -11,6 +11,9 @@
 #include <boost/thread.hpp>
 #include <boost/asio.hpp>
 
+#include <vector>
+#include <sys/socket.h>
+
 #include <log4cxx/logger.h>
 using namespace log4cxx;
 using namespace log4cxx::helpers;
@@ -21,6 +24,9 @@ using namespace log4cxx::helpers;
 #include "IpcReactor.h"
 #include "SharedBufferManager.h"
 #include "FrameDecoder.h"
+#include "EmptyBufferQueue.h"
+#include "PacketCapture.h"
+#include "FrameReceiverRxStats.h"
 
 #include "FrameReceiverConfig.h"
 #include "FrameReceiverException.h"
@@ -39,33 +45,63 @@ namespace FrameReceiver
     public:
         FrameReceiverRxThread(FrameReceiverConfig& config, LoggerPtr& logger,
                 SharedBufferManagerPtr buffer_manager, FrameDecoderPtr frame_decoder,
-                unsigned int tick_period_ms=100);
+                unsigned int tick_period_ms=100, unsigned int thread_index=0);
         virtual ~FrameReceiverRxThread();
 
         void start();
         void stop();
 
         void frame_ready(int buffer_id, int frame_number);
+        bool push_empty_buffer(int buffer_id);
+        const FrameReceiverRxStats& get_stats(void) const;
 
     private:
 
         void run_service(void);
 
         void handle_rx_channel(void);
-        void handle_receive_socket(int socket_fd, int recv_port);
+        void handle_empty_buffer_queue(void);
+        void handle_receive_socket(int socket_fd, int recv_port, unsigned int port_slot);
+        void handle_receive_socket_batch(int socket_fd, int recv_port, unsigned int port_slot);
+        void log_receive_error(int recv_port);
+        void initialise_batch_receive(void);
+        void capture_datagram(struct sockaddr_in* from_addr, int recv_port, const void* header,
+                const void* payload, size_t bytes_received);
+        void stop_capture(void);
+        bool handles_port(unsigned int port_index) const;
         void tick_timer(void);
         void buffer_monitor_timer(void);
+        void frame_timeout_timer(void);
+        void update_decoder_stats(void);
 
         FrameReceiverConfig&   config_;
         LoggerPtr              logger_;
         SharedBufferManagerPtr buffer_manager_;
         FrameDecoderPtr        frame_decoder_;
         unsigned int           tick_period_ms_;
+        unsigned int           thread_index_;
+        std::string            rx_channel_endpoint_;
 
         IpcChannel             rx_channel_;
+        bool                   binary_notifications_; //!< Send frame ready notifications in binary format
         int                    recv_socket_;
         std::vector<int>       recv_sockets_;
         IpcReactor             reactor_;
+        EmptyBufferQueue       empty_buffer_queue_;
+
+        unsigned int                    rx_batch_size_;          //!< Maximum datagrams received per wakeup
+        std::vector<struct mmsghdr>     batch_msgs_;             //!< Message headers for batched receive
+        std::vector<struct iovec>       batch_iovecs_;           //!< Header/payload scatter vectors for batched receive
+        std::vector<struct sockaddr_in> batch_from_addrs_;       //!< Source addresses for batched receive
+        std::vector<ReceivedDatagram>   batch_datagrams_;        //!< Datagram descriptors passed to the decoder for batched receive
+        std::vector<uint8_t>            batch_headers_;          //!< Packet header staging area for batched receive
+        std::vector<uint8_t>            batch_payloads_;         //!< Packet payload staging area for batched receive
+        uint64_t                        batch_receive_calls_;    //!< Number of batched receive calls returning data
+        uint64_t                        batch_packets_received_; //!< Number of datagrams received by batched receive calls
+
+        boost::shared_ptr<PacketCaptureWriter> capture_writer_; //!< Writer capturing received datagrams, if enabled
+
+        FrameReceiverRxStats   stats_;                 //!< Statistics block, readable by other threads
 
         bool                   run_thread_;
         bool                   thread_running_;
@@ -0,0 +1,75 @@
+/*!
+ * FrameSlotTable.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef FRAMESLOTTABLE_H_
+#define FRAMESLOTTABLE_H_
+
+#include <vector>
+#include <utility>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace FrameReceiver
+{
+    //! FrameSlotTable - fixed-size open-addressed mapping of frame numbers to buffer IDs
+    //!
+    //! Frame numbers are mapped to slots by their value modulo the power-of-two capacity of the
+    //! table, so frames received in sequence occupy consecutive slots. Collisions, e.g. from frame
+    //! numbers far apart or wrapping around, are resolved by linear probing, and entries are
+    //! erased by shifting subsequent entries back so no tombstones accumulate. The table does not
+    //! allocate memory other than when reserving capacity.
+
+    class FrameSlotTable
+    {
+    public:
+
+        FrameSlotTable(size_t min_entries=8);
+
+        void reserve(size_t num_entries);
+
+        //! Find the buffer ID mapped to a frame number, returning -1 if it is not mapped
+        inline int find(uint32_t frame_number) const
+        {
+            size_t slot = frame_number & slot_mask_;
+            while (slots_[slot].buffer_id >= 0)
+            {
+                if (slots_[slot].frame_number == frame_number)
+                {
+                    return slots_[slot].buffer_id;
+                }
+                slot = (slot + 1) & slot_mask_;
+            }
+            return -1;
+        }
+
+        bool insert(uint32_t frame_number, int buffer_id);
+        bool erase(uint32_t frame_number);
+        void clear(void);
+
+        void get_entries(std::vector<std::pair<uint32_t, int> >& entries) const;
+
+        inline const size_t size(void) const { return num_entries_; };
+        inline const size_t capacity(void) const { return slots_.size(); };
+        inline const uint64_t get_num_collisions(void) const { return num_collisions_; };
+
+    private:
+
+        typedef struct
+        {
+            uint32_t frame_number;
+            int32_t  buffer_id;     // Negative when the slot is empty
+        } Slot;
+
+        std::vector<Slot> slots_;          //!< Slot storage, size is a power of two
+        size_t            slot_mask_;      //!< Mask mapping frame numbers to slot indices
+        size_t            num_entries_;    //!< Number of occupied slots
+        uint64_t          num_collisions_; //!< Number of insertions displaced from their home slot
+    };
+
+} // namespace FrameReceiver
+
+#endif /* FRAMESLOTTABLE_H_ */
@@ -12,9 +12,11 @@
 #include <iostream>
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace FrameReceiver
 {
+    struct IpcReactorHandler;
 
     class IpcContext
     {
@@ -55,8 +57,11 @@ namespace FrameReceiver
 
     private:
 
+        void notify_reactor(void);
+
         IpcContext& context_;
         zmq::socket_t socket_;
+        boost::shared_ptr<IpcReactorHandler> reactor_handler_; //!< Handler of the reactor the channel is registered with, if any
 
 
     };
@@ -0,0 +1,105 @@
+/*!
+ * IpcFrameNotification.h - Frame Receiver binary frame notification message format class
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef IPCFRAMENOTIFICATION_H_
+#define IPCFRAMENOTIFICATION_H_
+
+#include <string>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "IpcMessage.h"
+
+namespace FrameReceiver
+{
+    //! IpcFrameNotification - compact binary frame ready/release notification message
+    //!
+    //! This class implements a fixed-layout binary alternative to the JSON IpcMessage encoding of
+    //! frame ready and frame release notifications, avoiding JSON encoding, parsing and timestamp
+    //! formatting on every frame. The format of frame ready notifications is global to the frame
+    //! receiver: it is set at startup and can be changed by any processor with a configure command
+    //! carrying a notification_format parameter, the change applying to every subscriber of the
+    //! frame ready channel. Encoded messages start with a magic number which cannot begin a JSON
+    //! document, so a receiver can accept both formats on the same channel, as the frame receiver
+    //! does for frame release notifications.
+    //!
+    //! The encoded message is 40 bytes, little-endian:
+    //!
+    //!   offset  size  field
+    //!        0     4  magic (0x4E5246F5)
+    //!        4     2  version
+    //!        6     1  message type (IpcMessage::MsgType)
+    //!        7     1  message value (IpcMessage::MsgVal)
+    //!        8     4  frame number
+    //!       12     4  buffer ID
+    //!       16     4  frame state (FrameDecoder::FrameReceiveState)
+    //!       20     4  reserved
+    //!       24     8  frame start time, ns since the epoch (0 if unknown)
+    //!       32     8  message timestamp, ns since the epoch
+
+    class IpcFrameNotification
+    {
+    public:
+
+        static const uint32_t magic        = 0x4E5246F5; //!< Magic number identifying a binary notification
+        static const uint16_t version      = 1;          //!< Version of the binary layout
+        static const size_t   encoded_size = 40;         //!< Size of an encoded notification in bytes
+
+        IpcFrameNotification(IpcMessage::MsgVal msg_val, int frame_number, int buffer_id,
+                int frame_state=0, uint64_t frame_start_time_ns=0);
+        IpcFrameNotification(const std::string& encoded);
+
+        static bool is_binary(const std::string& encoded);
+        static uint64_t timespec_to_ns(const struct timespec& ts);
+
+        std::string encode(void) const;
+        std::string encode_json(void) const;
+
+        //! Returns the message type of the notification
+        IpcMessage::MsgType get_msg_type(void) const { return msg_type_; };
+        //! Returns the message value of the notification
+        IpcMessage::MsgVal get_msg_val(void) const { return msg_val_; };
+        //! Returns the frame number
+        int get_frame_number(void) const { return frame_number_; };
+        //! Returns the frame buffer ID
+        int get_buffer_id(void) const { return buffer_id_; };
+        //! Returns the frame receive state
+        int get_frame_state(void) const { return frame_state_; };
+        //! Returns the frame start time in ns since the epoch, or 0 if unknown
+        uint64_t get_frame_start_time_ns(void) const { return frame_start_time_ns_; };
+        //! Returns the message timestamp in ns since the epoch
+        uint64_t get_msg_timestamp_ns(void) const { return msg_timestamp_ns_; };
+
+    private:
+
+        //! Encoded message layout
+        typedef struct
+        {
+            uint32_t magic;
+            uint16_t version;
+            uint8_t  msg_type;
+            uint8_t  msg_val;
+            uint32_t frame_number;
+            int32_t  buffer_id;
+            uint32_t frame_state;
+            uint32_t reserved;
+            uint64_t frame_start_time_ns;
+            uint64_t msg_timestamp_ns;
+        } Layout;
+
+        IpcMessage::MsgType msg_type_;            //!< Message type
+        IpcMessage::MsgVal  msg_val_;             //!< Message value
+        int                 frame_number_;        //!< Frame number
+        int                 buffer_id_;           //!< Frame buffer ID
+        int                 frame_state_;         //!< Frame receive state
+        uint64_t            frame_start_time_ns_; //!< Frame start time in ns since the epoch
+        uint64_t            msg_timestamp_ns_;    //!< Message timestamp in ns since the epoch
+    };
+
+} // namespace FrameReceiver
+
+#endif /* IPCFRAMENOTIFICATION_H_ */
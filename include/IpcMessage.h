@@ -87,6 +87,7 @@ namespace FrameReceiver
 			MsgValCmdStatus,          //!< Status command message
 			MsgValNotifyFrameReady,   //!< Frame ready notification message
 			MsgValNotifyFrameRelease, //!< Frame release notification message
+			MsgValCmdConfigure,       //!< Configure command message
 		};
 
 		//! Internal bi-directional mapping of message type from string to enumerated MsgType
@@ -10,6 +10,18 @@
  * or run indefinitely. The reactor polls all registered channels with a 'tickless' event
  * loop to minimise load.
  *
+ * On Linux the reactor waits on an epoll instance. Raw sockets are registered directly and
+ * ZMQ channels via their ZMQ_FD notification descriptor, with a pointer to the handler stored
+ * in the epoll event data, so dispatch cost depends only on the number of ready sockets. As
+ * the ZMQ_FD descriptor only signals changes of state, the event state of a channel is checked
+ * when its descriptor wakes the reactor, after its callback has run and after it has been sent
+ * or received on elsewhere, channels to check being kept on a short pending list. Other
+ * platforms fall back to zmq::poll over a rebuilt array of poll items.
+ *
+ * Timers are kept in a min-heap ordered by due time, with nanosecond resolution, and the
+ * clock is read once per loop iteration to fire them. On Linux the reactor wakes for the next
+ * timer via a timerfd armed with its absolute due time rather than a poll timeout.
+ *
  *  Created on: Feb 16, 2015
  *      Author: Tim Nicholls, STFC Application Engineering Group
  */
@@ -26,9 +38,16 @@
 #include <boost/function.hpp>
 #include <boost/ref.hpp>
 #include <boost/shared_ptr.hpp>
+#include <functional>
 #include <map>
+#include <queue>
+#include <vector>
 #include <time.h>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 namespace FrameReceiver
 {
 
@@ -44,12 +63,15 @@ namespace FrameReceiver
     //! Reactor millisecond time type
     typedef int64_t TimeMs;
 
+    //! Reactor nanosecond time type
+    typedef int64_t TimeNs;
+
     //! IpcReactorTimer - timer objects for use in the IpcReactor class
     class IpcReactorTimer
     {
     public:
 
-        IpcReactorTimer(size_t delay_ms, size_t times, TimerCallback callback);
+        IpcReactorTimer(TimeNs delay_ns, size_t times, TimerCallback callback);
         ~IpcReactorTimer();
 
         //! get_id - returns the unique ID of the timer instance
@@ -58,41 +80,76 @@ namespace FrameReceiver
         //! Executes the registered callback method of the timer
         void do_callback(void);
 
-        //! Indicates if the timer has fired (e.g. is due for handling)
-        bool has_fired(void);
+        //! Indicates if the timer has fired (e.g. is due for handling) at the specified time
+        bool has_fired(TimeNs now);
 
         //! Indicates if the timer has expired, i.e. reached its maximum times fired
         bool has_expired(void);
 
         //! Indicates when (in absolute monotonic time) the timer is due to fire
-        TimeMs when(void);
+        TimeNs when(void);
 
         //! Returns the current monotonic clock time in milliseconds (static method)
         static TimeMs clock_mono_ms(void);
 
+        //! Returns the current monotonic clock time in nanoseconds (static method)
+        static TimeNs clock_mono_ns(void);
+
     private:
 
         // Private member variables
         int timer_id_;             //!< Unique ID for the timer
-        size_t delay_ms_;          //!< Timer delay in milliseconds
+        TimeNs delay_ns_;          //!< Timer delay in nanoseconds
         size_t times_;             //!< Number of times the timer has left to fire
         TimerCallback callback_;   //!< Callback method to be called when the timer fires
-        TimeMs when_;              //!< Time when the timer is next due to fire
+        TimeNs when_;              //!< Time when the timer is next due to fire
         bool expired_;             //!< Indicates timers has expired
 
         static int last_timer_id_; //!< Class variable of last timer ID assigned
     };
 
+    //! IpcReactorTimerEntry - entry in the reactor timer queue, ordered by due time
+    typedef struct IpcReactorTimerEntry
+    {
+        TimeNs when;   //!< Time when the timer is due to fire
+        int timer_id;  //!< ID of the timer
+
+        bool operator>(const struct IpcReactorTimerEntry& other) const
+        {
+            return (when > other.when) || ((when == other.when) && (timer_id > other.timer_id));
+        }
+    } IpcReactorTimerEntry;
+
+    //! Min-heap of timer entries, the earliest due at the top
+    typedef std::priority_queue<IpcReactorTimerEntry, std::vector<IpcReactorTimerEntry>,
+            std::greater<IpcReactorTimerEntry> > TimerQueue;
+
     //! Function signature for reactor callback methods
     typedef boost::function<void()> ReactorCallback;
 
     //! Pointer to underlying ZMQ socket of a channel
     typedef zmq::socket_t* SocketPtr;
 
-    //! Internal map to associate channel socket with a callback method
-    typedef std::map<SocketPtr, ReactorCallback> ChannelMap;
+    class IpcReactor;
+
+    //! IpcReactorHandler - registration of a channel or socket with the reactor
+    typedef struct IpcReactorHandler
+    {
+        ReactorCallback callback; //!< Callback method to be called when the channel or socket is readable
+        SocketPtr       socket;   //!< ZMQ socket of a channel, 0 for raw sockets
+        int             fd;       //!< File descriptor waited on, i.e. raw socket or ZMQ_FD of a channel
+        bool            active;   //!< Indicates the handler has not been removed from the reactor
+        bool            pending;  //!< Indicates the channel is on the list of channels to check for messages
+        IpcReactor*     reactor;  //!< Reactor the channel is registered with, 0 once the reactor is destroyed
+    } IpcReactorHandler;
+
+    typedef boost::shared_ptr<IpcReactorHandler> IpcReactorHandlerPtr;
+
+    //! Internal map to associate channel socket with a handler
+    typedef std::map<SocketPtr, IpcReactorHandlerPtr> ChannelMap;
 
-    typedef std::map<int, ReactorCallback> SocketMap;
+    //! Internal map to associate raw socket file descriptor with a handler
+    typedef std::map<int, IpcReactorHandlerPtr> SocketMap;
 
     //! Internal map to associate timer ID with a timer
     typedef std::map<int, boost::shared_ptr<IpcReactorTimer> > TimerMap;
@@ -110,13 +167,18 @@ namespace FrameReceiver
          //! Removes an IPC chanel from the reactor
          void remove_channel(IpcChannel& channel);
 
+         //! Adds a raw socket and associated callback to the reactor
          void register_socket(int socket_fd, ReactorCallback callback);
 
+         //! Removes a raw socket from the reactor
          void remove_socket(int socket_fd);
 
          //! Adds a timer to the reactor
          int register_timer(size_t delay_ms, size_t times, ReactorCallback callback);
 
+         //! Adds a timer with a delay in microseconds to the reactor
+         int register_timer_us(size_t delay_us, size_t times, ReactorCallback callback);
+
          //! Removes a timer from the reactor
          void remove_timer(int timer_id);
 
@@ -128,22 +190,64 @@ namespace FrameReceiver
 
     private:
 
+        friend class IpcChannel;
+
+        //! Queues a channel to have its event state checked for pending messages
+        void mark_pending(IpcReactorHandler* handler);
+
+        //! Adds a handler to the underlying poll mechanism
+        void add_handler(IpcReactorHandlerPtr handler);
+
+        //! Removes a handler from the underlying poll mechanism
+        void remove_handler(IpcReactorHandlerPtr handler);
+
+        //! Waits for and dispatches callbacks for readable channels and sockets
+        int poll_handlers(long timeout_ms);
+
         //! Rebuilds the internal list of polling items
         void rebuild_pollitems(void);
 
+        //! Adds a timer to the reactor timer map and queue
+        int add_timer(boost::shared_ptr<IpcReactorTimer> timer);
+
+        //! Calls the callbacks of timers that have fired
+        void fire_timers(TimeNs now);
+
+        //! Discards queue entries for timers that have been removed
+        void discard_removed_timers(void);
+
         //! Calculates the next poll timeout based on the tickless pattern
-        long calculate_timeout(void);
+        long calculate_timeout(TimeNs now);
+
+#ifdef __linux__
+        //! Arms the timer file descriptor to expire when the next timer is due
+        void arm_timer_fd(void);
+
+        //! Handles expiry of the timer file descriptor
+        void handle_timer_fd(void);
+#endif
 
         // Private member variables
 
         bool terminate_reactor_;         //!< Indicates that the reactor loop should terminate
         ChannelMap channels_;            //!< Map of channels associated with the reactor
-        SocketMap  sockets_;
+        SocketMap  sockets_;             //!< Map of raw sockets associated with the reactor
         TimerMap   timers_;              //!< Map of timers associated with the reactor
+        TimerQueue timer_queue_;         //!< Queue of timers ordered by due time
+        bool             needs_rebuild_; //!< Indicates that the poll item list needs rebuilding
+#ifdef __linux__
+        int epoll_fd_;                                     //!< Epoll instance file descriptor
+        std::vector<struct epoll_event> epoll_events_;     //!< Event array filled by epoll_wait
+        std::vector<IpcReactorHandler*> pending_handlers_;   //!< Channels to check for pending messages
+        std::vector<IpcReactorHandler*> checked_handlers_;   //!< Channels being checked, swapped with the pending list
+        std::vector<IpcReactorHandlerPtr> removed_handlers_; //!< Handlers removed, released after dispatch
+        IpcReactorHandlerPtr timer_fd_handler_;              //!< Handler for the timer file descriptor
+        TimeNs timer_fd_armed_;                              //!< Time the timer file descriptor is armed for, 0 if disarmed
+#else
         zmq::pollitem_t* pollitems_;     //!< Ptr to array of pollitems to use in poll call
         ReactorCallback* callbacks_;     //!< Ptr to matched array of callbacks
         std::size_t      pollsize_;      //!< Number if active items to poll
-        bool             needs_rebuild_; //!< Indicates that the poll item list needs rebuilding
+#endif
     };
 
 } // namespace FrameReceiver
@@ -0,0 +1,118 @@
+/*!
+ * NotificationRing.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef NOTIFICATIONRING_H_
+#define NOTIFICATIONRING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FrameReceiverException.h"
+
+namespace FrameReceiver
+{
+    class NotificationRingException : public FrameReceiverException
+    {
+    public:
+        NotificationRingException(const std::string what) : FrameReceiverException(what) { };
+    };
+
+    //! NotificationRing - lock-free frame notification ring in shared memory
+    //!
+    //! This class implements a single-producer, single-consumer ring of frame notifications in a
+    //! memory region shared between processes, e.g. the auxiliary region of a shared buffer
+    //! manager segment. It allows a processor on the same host to exchange frame ready and release
+    //! notifications with the frame receiver without the kernel network stack. The producer and
+    //! consumer indices are held on separate cache lines. A consumer can block in wait(), which
+    //! sleeps on a process-shared futex on Linux; the producer only issues a wakeup system call
+    //! when a consumer is waiting.
+    //!
+    //! A consumer registers with attach_consumer() and deregisters with detach_consumer(). A producer
+    //! delivering notifications by other means as well, e.g. over ZeroMQ, should only push to the
+    //! ring while has_consumer() is true, so that the ring does not fill when nothing reads it. As
+    //! entries may hold resources, e.g. frame buffers, a consumer must pop and handle the entries
+    //! still on the ring after detaching. An entry pushed by a producer that saw the consumer just
+    //! before it detached is left on the ring and handed to the next consumer to attach.
+    //!
+    //! The ring is laid out in memory as a 256-byte control block followed by the entries:
+    //!
+    //!   offset  size  field
+    //!        0     4  magic (0x474E4952)
+    //!        4     4  version
+    //!        8     4  capacity, a power of two
+    //!       12     4  entry size
+    //!       16     4  consumer attached flag
+    //!       64     4  head, the index of the next entry to write
+    //!      128     4  tail, the index of the next entry to read
+    //!      192     4  wakeup sequence number (futex word)
+    //!      196     4  number of waiting consumers
+    //!      256        entries
+
+    class NotificationRing
+    {
+    public:
+
+        //! Notification ring entry
+        typedef struct
+        {
+            uint32_t frame_number;        //!< Frame number
+            int32_t  buffer_id;           //!< Frame buffer ID
+            uint32_t frame_state;         //!< Frame receive state
+            uint32_t reserved;            //!< Reserved, set to zero
+            uint64_t frame_start_time_ns; //!< Frame start time in ns since the epoch, 0 if unknown
+            uint64_t timestamp_ns;        //!< Notification time in ns since the epoch
+        } Entry;
+
+        static const uint32_t magic   = 0x474E4952; //!< Magic number identifying an initialised ring
+        static const uint32_t version = 2;          //!< Version of the ring layout
+
+        static size_t get_region_size(size_t capacity);
+
+        NotificationRing(void* address, size_t capacity);
+        NotificationRing(void* address);
+
+        bool push(const Entry& entry);
+        bool pop(Entry& entry);
+        bool wait(unsigned int timeout_ms);
+        bool wait_for_push(uint32_t& head, unsigned int timeout_ms);
+        void wake_waiters(void);
+
+        void attach_consumer(void);
+        void detach_consumer(void);
+        bool has_consumer(void) const;
+
+        size_t capacity(void) const;
+        size_t size(void) const;
+        size_t get_region_size(void) const;
+
+    private:
+
+        //! Control block at the start of the ring region
+        typedef struct
+        {
+            uint32_t          magic;
+            uint32_t          version;
+            uint32_t          capacity;
+            uint32_t          entry_size;
+            volatile uint32_t consumer_attached;
+            uint8_t           pad0[44];
+            volatile uint32_t head;
+            uint8_t           pad1[60];
+            volatile uint32_t tail;
+            uint8_t           pad2[60];
+            volatile int32_t  wake_seq;
+            volatile int32_t  waiters;
+            uint8_t           pad3[56];
+        } Control;
+
+        Control* control_;  //!< Control block in the shared region
+        Entry*   entries_;  //!< Entries in the shared region
+        uint32_t mask_;     //!< Index mask, capacity - 1
+    };
+
+} // namespace FrameReceiver
+
+#endif /* NOTIFICATIONRING_H_ */
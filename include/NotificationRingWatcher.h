@@ -0,0 +1,49 @@
+/*!
+ * NotificationRingWatcher.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef NOTIFICATIONRINGWATCHER_H_
+#define NOTIFICATIONRINGWATCHER_H_
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include "NotificationRing.h"
+
+namespace FrameReceiver
+{
+    //! NotificationRingWatcher - wakes the consumer of a notification ring through a descriptor
+    //!
+    //! The futex a notification ring wakes its consumer on cannot be polled, so a consumer running
+    //! a reactor cannot wait on it alongside its other channels. This class runs a thread blocked
+    //! on the ring futex, which signals a descriptor that can be registered with the reactor of
+    //! the consumer whenever the producer pushes entries. The consumer clears the notification and
+    //! then drains the ring with pop(). The watcher never pops entries itself.
+
+    class NotificationRingWatcher
+    {
+    public:
+
+        NotificationRingWatcher(NotificationRing& ring, unsigned int wait_timeout_ms=100);
+        ~NotificationRingWatcher();
+
+        int get_notify_fd(void) const;
+        void clear_notification(void);
+
+    private:
+
+        void watch(void);
+
+        NotificationRing& ring_;                 //!< Ring being watched
+        unsigned int wait_timeout_ms_;           //!< Maximum time to block on the ring before re-checking for shutdown
+        volatile bool run_watcher_;              //!< Cleared to stop the watcher thread
+        int notify_fd_;                          //!< Descriptor the consumer polls for notifications
+        int notify_write_fd_;                    //!< Descriptor the watcher signals notifications on
+        boost::scoped_ptr<boost::thread> watcher_thread_;
+    };
+
+} // namespace FrameReceiver
+
+#endif /* NOTIFICATIONRINGWATCHER_H_ */
@@ -0,0 +1,159 @@
+/*!
+ * PacketBitmap.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef PACKETBITMAP_H_
+#define PACKETBITMAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+namespace FrameReceiver
+{
+    //! Range of packet indices [first, first + count)
+    typedef std::pair<size_t, size_t> PacketRange;
+
+    //! PacketBitmap - bit-packed map of the packets received into a frame
+    //!
+    //! This template holds one bit per packet of a frame in 64-bit words, so that a frame header
+    //! in a shared buffer metadata slot can record which packets have arrived in a few cache lines.
+    //! The bitmap is a plain structure without constructors, so that it can be placed directly in
+    //! shared memory; clear() must be called before use. Setting a bit is atomic, so that decoders
+    //! in several RX threads can share a frame. Counting and searching for missing packets work
+    //! a word at a time with popcount and count-trailing-zeros, so are cheap even for frames of
+    //! many packets.
+
+    template<size_t NumPackets>
+    struct PacketBitmap
+    {
+        static const size_t num_packets = NumPackets;
+        static const size_t bits_per_word = 64;
+        static const size_t num_words = (NumPackets + bits_per_word - 1) / bits_per_word;
+
+        uint64_t words[num_words];
+
+        //! Clears the bitmap, marking all packets as missing
+        void clear(void)
+        {
+            memset(words, 0, sizeof(words));
+        }
+
+        //! Marks a packet as received
+        //!
+        //! \param[in] packet - index of the packet in the frame
+        //! \return true if the packet had already been marked as received
+        bool set(size_t packet)
+        {
+            uint64_t mask = word_bit(packet);
+            return (__sync_fetch_and_or(&words[packet / bits_per_word], mask) & mask) != 0;
+        }
+
+        //! Returns true if a packet has been marked as received
+        bool test(size_t packet) const
+        {
+            return (words[packet / bits_per_word] & word_bit(packet)) != 0;
+        }
+
+        //! Returns the number of packets marked as received
+        size_t count(void) const
+        {
+            size_t received = 0;
+            for (size_t word = 0; word < num_words; word++)
+            {
+                received += __builtin_popcountll(words[word]);
+            }
+            return received;
+        }
+
+        //! Returns true if every packet of the frame has been marked as received
+        bool complete(void) const
+        {
+            for (size_t word = 0; word < num_words; word++)
+            {
+                if (~words[word] & word_mask(word))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //! Returns the index of the first missing packet at or after a packet, or num_packets if
+        //! there is none
+        size_t find_missing(size_t from) const
+        {
+            return find_next(from, true);
+        }
+
+        //! Returns the index of the first received packet at or after a packet, or num_packets if
+        //! there is none
+        size_t find_received(size_t from) const
+        {
+            return find_next(from, false);
+        }
+
+        //! Lists the ranges of missing packets in the frame
+        //!
+        //! \param[out] ranges - ranges of consecutive missing packets, in order
+        //! \return number of missing packets
+        size_t get_missing_ranges(std::vector<PacketRange>& ranges) const
+        {
+            ranges.clear();
+            size_t missing = 0;
+            size_t first = find_missing(0);
+            while (first < num_packets)
+            {
+                size_t end = find_received(first);
+                ranges.push_back(PacketRange(first, end - first));
+                missing += end - first;
+                first = find_missing(end);
+            }
+            return missing;
+        }
+
+    private:
+
+        static uint64_t word_bit(size_t packet)
+        {
+            return (uint64_t)1 << (packet % bits_per_word);
+        }
+
+        //! Returns the mask of bits in a word that correspond to packets of the frame
+        static uint64_t word_mask(size_t word)
+        {
+            size_t bits = NumPackets - (word * bits_per_word);
+            return (bits >= bits_per_word) ? ~(uint64_t)0 : (((uint64_t)1 << bits) - 1);
+        }
+
+        size_t find_next(size_t from, bool missing) const
+        {
+            size_t word = from / bits_per_word;
+            if (word >= num_words)
+            {
+                return num_packets;
+            }
+
+            // Search a word at a time, inverting words when looking for missing packets and
+            // masking off bits before the start position in the first word
+            uint64_t bits = (missing ? ~words[word] : words[word]) & word_mask(word);
+            bits &= ~(uint64_t)0 << (from % bits_per_word);
+            while (bits == 0)
+            {
+                if (++word >= num_words)
+                {
+                    return num_packets;
+                }
+                bits = (missing ? ~words[word] : words[word]) & word_mask(word);
+            }
+            return (word * bits_per_word) + __builtin_ctzll(bits);
+        }
+    };
+
+} // namespace FrameReceiver
+
+#endif /* PACKETBITMAP_H_ */
@@ -0,0 +1,111 @@
+/*!
+ * PacketCapture.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef PACKETCAPTURE_H_
+#define PACKETCAPTURE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <netinet/in.h>
+#include <string>
+#include <vector>
+
+#include "FrameReceiverException.h"
+
+namespace FrameReceiver
+{
+    class PacketCaptureException : public FrameReceiverException
+    {
+    public:
+        PacketCaptureException(const std::string what) : FrameReceiverException(what) { };
+    };
+
+    //! UDP datagram read from a packet capture file
+    typedef struct
+    {
+        struct timespec    timestamp;       //!< Time the datagram was captured
+        struct sockaddr_in from_addr;       //!< Source address and port of the datagram
+        int                port;            //!< Destination port of the datagram
+        const uint8_t*     data;            //!< Datagram content, valid until the next read
+        size_t             length;          //!< Bytes of the datagram held in the capture
+        size_t             original_length; //!< Size of the datagram on the wire
+    } CapturedDatagram;
+
+    //! PacketCaptureWriter - writes received datagrams to a pcap capture file
+    //!
+    //! This class records datagrams with their receive timestamps in the classic pcap file format
+    //! with nanosecond timestamps, so that captures can be inspected with standard tools such as
+    //! tcpdump and Wireshark as well as replayed into a frame decoder. Since the receive socket only
+    //! delivers the UDP payload, each record is given a synthesised IPv4 and UDP header carrying the
+    //! source address and destination port of the datagram. Writes are buffered, so the cost of
+    //! capture in the RX thread is essentially that of copying each datagram.
+
+    class PacketCaptureWriter
+    {
+    public:
+
+        PacketCaptureWriter(const std::string& file_name, const std::string& dest_address="0.0.0.0",
+                size_t buffer_size=(4 * 1024 * 1024));
+        ~PacketCaptureWriter();
+
+        void write(const struct timespec& timestamp, const struct sockaddr_in* from_addr, int port,
+                const void* header, size_t header_size, const void* payload, size_t payload_size);
+        void flush(void);
+
+        const std::string& get_file_name(void) const;
+        uint64_t get_num_packets(void) const;
+        uint64_t get_num_bytes(void) const;
+
+    private:
+
+        std::string       file_name_;    //!< Name of the capture file
+        FILE*             file_;         //!< Capture file stream
+        std::vector<char> file_buffer_;  //!< Stream buffer, batching writes to the file
+        uint32_t          dest_addr_;    //!< Destination address in the synthesised IP headers
+        uint16_t          ip_id_;        //!< Identification field of the next synthesised IP header
+        uint64_t          packets_;      //!< Number of datagrams written
+        uint64_t          bytes_;        //!< Number of datagram bytes written
+    };
+
+    //! PacketCaptureReader - reads UDP datagrams from a pcap capture file
+    //!
+    //! This class reads the UDP datagrams from captures written by PacketCaptureWriter, and from
+    //! captures of raw IP, Ethernet (optionally VLAN tagged) or Linux cooked link types taken with
+    //! tcpdump on production systems. Microsecond and nanosecond timestamp resolutions and either
+    //! byte order are supported. Records which are not unfragmented IPv4 UDP datagrams are skipped.
+
+    class PacketCaptureReader
+    {
+    public:
+
+        PacketCaptureReader(const std::string& file_name);
+        ~PacketCaptureReader();
+
+        bool read(CapturedDatagram& datagram);
+        void rewind(void);
+
+        uint32_t get_link_type(void) const;
+        uint64_t get_num_skipped(void) const;
+
+    private:
+
+        uint32_t file_to_host(uint32_t value) const;
+        bool decode_record(CapturedDatagram& datagram);
+
+        std::string          file_name_;   //!< Name of the capture file
+        FILE*                file_;        //!< Capture file stream
+        bool                 swapped_;     //!< File was written with the opposite byte order
+        bool                 nanosecond_;  //!< File timestamps have nanosecond resolution
+        uint32_t             link_type_;   //!< Link layer type of the records in the file
+        std::vector<uint8_t> record_;      //!< Content of the last record read
+        uint64_t             skipped_;     //!< Number of records skipped as not UDP datagrams
+    };
+
+} // namespace FrameReceiver
+
+#endif /* PACKETCAPTURE_H_ */
@@ -0,0 +1,86 @@
+/*!
+ * PacketReplayer.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef PACKETREPLAYER_H_
+#define PACKETREPLAYER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <log4cxx/logger.h>
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+#include "DebugLevelLogger.h"
+
+#include "FrameDecoder.h"
+#include "PacketCapture.h"
+
+namespace FrameReceiver
+{
+    //! PacketReplayer - injects the datagrams of a packet capture into a frame decoder
+    //!
+    //! This class replays a capture file written by the RX thread, or taken with tcpdump, into a
+    //! frame decoder without sockets, so that the loss and reordering patterns of real packet streams
+    //! can be reproduced offline. Datagrams are handed to the decoder in the same way as by the RX
+    //! thread: one at a time through the per-packet decoder methods, or in batches through
+    //! process_packets() when a batch size greater than one is given. Datagrams are replayed at
+    //! their original rate scaled by a speed factor, or as fast as possible with a speed of zero.
+    //! Datagrams to ports not in the port list, if given, are ignored.
+
+    class PacketReplayer
+    {
+    public:
+
+        PacketReplayer(LoggerPtr& logger, FrameDecoderPtr frame_decoder, unsigned int batch_size=1,
+                double speed=0.0);
+
+        void set_ports(const std::vector<uint16_t>& ports);
+        void replay(PacketCaptureReader& reader);
+        void replay(const std::string& file_name);
+
+        uint64_t get_num_packets(void) const;
+        uint64_t get_num_bytes(void) const;
+        uint64_t get_num_truncated(void) const;
+        double get_elapsed_secs(void) const;
+
+    private:
+
+        bool handles_port(int port) const;
+        void wait_until(const CapturedDatagram& datagram);
+        void inject_packet(const CapturedDatagram& datagram);
+        void stage_packet(const CapturedDatagram& datagram);
+        void flush_batch(void);
+
+        LoggerPtr       logger_;
+        FrameDecoderPtr frame_decoder_;
+        unsigned int    batch_size_;          //!< Maximum datagrams handed to the decoder per call
+        double          speed_;               //!< Replay rate relative to the original, 0 for maximum
+        std::vector<uint16_t> ports_;         //!< Ports to replay datagrams for, all if empty
+
+        size_t                          header_size_;     //!< Packet header size of the decoder
+        size_t                          payload_size_;    //!< Maximum payload size of the decoder
+        std::vector<ReceivedDatagram>   batch_datagrams_; //!< Datagram descriptors of the current batch
+        std::vector<struct sockaddr_in> batch_from_addrs_;
+        std::vector<uint8_t>            batch_headers_;
+        std::vector<uint8_t>            batch_payloads_;
+        size_t                          batch_depth_;     //!< Datagrams staged in the current batch
+
+        bool            timing_started_;      //!< Pacing reference has been set for the current replay
+        struct timespec capture_start_;       //!< Capture timestamp of the first datagram of the current replay
+        uint64_t        pacing_start_ns_;     //!< Monotonic time the first datagram of the current replay was replayed
+        uint64_t        replay_start_ns_;     //!< Monotonic time the first datagram was replayed
+        uint64_t        replay_end_ns_;       //!< Monotonic time the last datagram was replayed
+
+        uint64_t        packets_;             //!< Number of datagrams replayed
+        uint64_t        bytes_;               //!< Number of datagram bytes replayed
+        uint64_t        truncated_;           //!< Number of datagrams truncated in the capture
+    };
+
+} // namespace FrameReceiver
+
+#endif /* PACKETREPLAYER_H_ */
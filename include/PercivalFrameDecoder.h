@@ -0,0 +1,210 @@
+/*
+ * PercivalFrameDecoder.h
+ *
+ *  Created on: Feb 24, 2015
+ *      Author: tcn45
+ */
+
+#ifndef INCLUDE_PERCIVALFRAMEDECODER_H_
+#define INCLUDE_PERCIVALFRAMEDECODER_H_
+
+#include "FrameDecoder.h"
+#include "DetectorGeometry.h"
+#include "PacketBitmap.h"
+#include <deque>
+#include <iostream>
+#include <stdint.h>
+#include <time.h>
+
+namespace FrameReceiver
+{
+    //! PercivalFrameDecoder - frame decoder for Percival family detectors
+    //!
+    //! This decoder is templated on the geometry traits of the detector (see DetectorGeometry), so
+    //! that each detector variant has its own decoder with packet sizes, counts, offsets and header
+    //! field positions compiled into the per-packet code. Decoders for the geometries in use are
+    //! explicitly instantiated in PercivalFrameDecoder.cpp.
+
+    template<class GeometryTraits>
+    class PercivalFrameDecoder : public FrameDecoder
+    {
+    public:
+
+        typedef DetectorGeometry<GeometryTraits> Geometry;
+
+//        typedef struct
+//        {
+//            uint8_t  packet_type;
+//            uint8_t  subframe_number;
+//            uint32_t frame_number;
+//            uint16_t packet_number;
+//            uint8_t  info[14];
+//        } PacketHeader;
+
+        typedef struct
+        {
+            uint8_t raw[Geometry::packet_header_size];
+        } PacketHeader;
+
+        typedef enum
+        {
+            PacketTypeSample = 0,
+            PacketTypeReset  = 1,
+        } PacketType;
+
+        //! Reasons for dropping a received packet
+        typedef enum
+        {
+            PacketDropShort = 0,        //!< Packet shorter than the packet header
+            PacketDropBadType,          //!< Packet type out of range
+            PacketDropBadSubframe,      //!< Subframe number out of range
+            PacketDropBadPacketNumber,  //!< Packet number out of range
+            PacketDropDuplicate,        //!< Packet already received into the frame
+            PacketDropNoBuffer,         //!< Packet of a frame dropped for lack of a free buffer
+            PacketDropTruncated,        //!< Payload discarded by a truncated receive
+            NumPacketDropReasons
+        } PacketDropReason;
+
+        static const size_t primary_packet_size  = Geometry::primary_packet_size;
+        static const size_t num_primary_packets  = Geometry::num_primary_packets;
+        static const size_t tail_packet_size     = Geometry::tail_packet_size;
+        static const size_t num_tail_packets     = Geometry::num_tail_packets;
+        static const size_t num_subframes        = Geometry::num_subframes;
+        static const size_t num_data_types       = Geometry::num_data_types;
+        static const size_t subframe_size        = Geometry::subframe_size;
+        static const size_t data_type_size       = Geometry::data_type_size;
+        // Frame headers are held in the metadata slots of the shared buffer, apart from the frame data
+        static const size_t total_frame_size     = Geometry::total_frame_size;
+        static const size_t num_subframe_packets = Geometry::num_subframe_packets;
+        static const size_t num_frame_packets    = Geometry::num_frame_packets;
+
+        typedef struct
+        {
+            uint32_t frame_number;
+            uint32_t frame_state;
+            struct timespec frame_start_time;
+            uint32_t packets_received;
+            PacketBitmap<num_frame_packets> packet_state; //!< Packets received, indexed by get_packet_index()
+        } FrameHeader;
+
+        PercivalFrameDecoder(LoggerPtr& logger, bool ebable_packet_logging=false, unsigned int frame_timeout_ms=1000);
+        ~PercivalFrameDecoder();
+
+        const size_t get_frame_buffer_size(void) const;
+        const size_t get_frame_header_size(void) const;
+
+        inline const bool requires_header_peek(void) const { return false; };
+        const size_t get_packet_header_size(void) const;
+        void process_packet_header(size_t bytes_received, int port, struct sockaddr_in* from_addr);
+        void process_packets(const ReceivedDatagram* datagrams, size_t num_datagrams);
+
+        void* get_next_payload_buffer(void) const;
+        size_t get_next_payload_size(void) const;
+        const size_t get_max_payload_size(void) const;
+        FrameDecoder::FrameReceiveState process_packet(size_t bytes_received);
+
+        void monitor_buffers(void);
+        void check_frame_timeouts(void);
+        bool get_frame_status(int buffer_id, FrameReceiveState& frame_state, struct timespec& frame_start_time) const;
+        size_t get_missing_packets(int buffer_id, std::vector<PacketRange>& ranges) const;
+
+        //! Returns the index of a packet in the frame header packet bitmap
+        static inline size_t get_packet_index(uint8_t type, uint8_t subframe, uint16_t packet_number)
+        {
+            return Geometry::packet_index(type, subframe, packet_number);
+        }
+
+        void* get_packet_header_buffer(void);
+
+        uint8_t get_packet_type(void) const;
+        uint8_t get_subframe_number(void) const;
+        uint16_t get_packet_number(void) const;
+        uint32_t get_frame_number(void) const;
+
+        const unsigned int get_num_relocated_packets(void) const;
+        const unsigned int get_num_dropped_packets(PacketDropReason reason) const;
+        const unsigned int get_num_dropped_packets(void) const;
+        const unsigned int get_num_dropped_frames(void) const;
+
+    private:
+
+        //! Packet header fields decoded to host byte order
+        typedef struct
+        {
+            uint32_t frame_number;
+            uint16_t packet_number;
+            uint8_t  subframe;
+            uint8_t  type;
+        } DecodedPacketHeader;
+
+        uint8_t* raw_packet_header(void) const;
+        static void decode_packet_header(const uint8_t* header, DecodedPacketHeader& decoded);
+        void log_packet_header(const uint8_t* header, int port, struct sockaddr_in* from_addr);
+        bool accept_packet(size_t bytes_received, bool payload_discarded);
+        void lookup_frame_buffer(uint32_t frame, uint32_t release_count);
+        void end_frame_buffer_write(void);
+        FrameDecoder::FrameReceiveState complete_packet(void);
+        size_t payload_bytes(size_t bytes_received) const;
+        void initialise_buffer(int buffer_id, uint32_t frame_number, uint32_t acquisition);
+        void initialise_frame_header(FrameHeader* frame_header, uint32_t frame_number);
+        uint8_t* payload_location(uint8_t type, uint8_t subframe, uint16_t packet_number) const;
+        void predict_next_payload_location(void);
+        void reset_payload_prediction(void);
+        void drop_packet(PacketDropReason reason);
+        void log_dropped_frame(void);
+        static uint64_t clock_mono_ns(void);
+
+        //! Timeout deadline of a frame buffer acquired by this decoder
+        typedef struct
+        {
+            uint32_t frame_number;
+            int      buffer_id;
+            uint32_t acquisition; //!< Acquisition number of the buffer in the frame buffer table
+            uint64_t deadline_ns; //!< Monotonic time at which the frame times out
+        } FrameDeadline;
+
+        boost::shared_ptr<void> current_packet_header_;
+        boost::shared_ptr<FrameHeader> dropped_frame_header_;
+        boost::shared_ptr<void> staging_payload_buffer_;
+
+        uint8_t* next_payload_location_;
+        size_t next_payload_size_;
+        unsigned int packets_relocated_;
+
+        uint32_t current_frame_seen_;
+        uint32_t current_release_count_;
+        int current_frame_buffer_id_;
+        void* current_frame_buffer_;
+        FrameHeader* current_frame_header_;
+        bool writing_frame_buffer_; //!< Registered as writing the current packet to a shared frame buffer
+
+        bool dropping_frame_data_;
+        unsigned int frames_dropped_;
+
+        unsigned int frame_timeout_ms_;
+        unsigned int frames_timedout_;
+        std::deque<FrameDeadline> frame_deadlines_; //!< Deadlines of acquired frames in order of start time
+
+        DecodedPacketHeader current_packet_;                 //!< Header of the current packet
+        bool current_packet_valid_;                          //!< Current packet passed validation
+        unsigned int packets_dropped_[NumPacketDropReasons]; //!< Packets dropped, counted by reason
+
+        FrameBufferInitialiser frame_header_initialiser_;
+        std::vector<std::pair<uint32_t, int> > mapped_buffers_;
+    };
+
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::primary_packet_size;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::num_primary_packets;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::tail_packet_size;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::num_tail_packets;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::num_subframes;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::num_data_types;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::subframe_size;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::data_type_size;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::total_frame_size;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::num_subframe_packets;
+    template<class GeometryTraits> const size_t PercivalFrameDecoder<GeometryTraits>::num_frame_packets;
+
+} // namespace FrameReceiver
+
+#endif /* INCLUDE_PERCIVALFRAMEDECODER_H_ */
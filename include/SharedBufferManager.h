@@ -16,6 +16,7 @@
 #include <string>
 
 #include <stddef.h>
+#include <stdint.h>
 
 namespace FrameReceiver
 {
@@ -26,19 +27,57 @@ namespace FrameReceiver
         SharedBufferManagerException(const std::string what) : FrameReceiverException(what) { }
     };
 
+    //! SharedBufferManager - manages frame buffers in a named shared memory segment
+    //!
+    //! The segment is laid out as a versioned header, followed by an array of per-buffer metadata
+    //! slots, the frame buffer slots and an optional auxiliary region:
+    //!
+    //!   offset           contents
+    //!   0                Header
+    //!   metadata_offset  num_buffers metadata slots, each padded to a multiple of a cache line
+    //!   buffer_offset    num_buffers buffer slots, each page aligned and padded to whole pages
+    //!   aux_offset       auxiliary region, e.g. frame notification rings, to the end of the segment
+    //!
+    //! Keeping the metadata, e.g. frame headers written as packets are received, apart from the
+    //! buffers lets payloads start on page boundaries and avoids false sharing between metadata
+    //! updates and processes reading frame data. Offsets are recorded in the header so that other
+    //! processes mapping the segment need not recompute the layout.
     class SharedBufferManager
     {
     public:
 
         typedef struct
         {
-            size_t manager_id;
-            size_t num_buffers;
-            size_t buffer_size;
+            size_t   manager_id;
+            size_t   num_buffers;
+            size_t   buffer_size;
+            uint32_t magic;            //!< Magic number identifying the segment layout
+            uint32_t version;          //!< Version of the segment layout
+            size_t   metadata_offset;  //!< Offset of the metadata slots
+            size_t   metadata_stride;  //!< Size of each metadata slot, 0 if there is no metadata
+            size_t   buffer_offset;    //!< Offset of the buffer slots
+            size_t   buffer_stride;    //!< Size of each buffer slot
+            size_t   aux_offset;       //!< Offset of the auxiliary region
         } Header;
 
+        static const uint32_t layout_magic       = 0x46425253; //!< Magic number of the segment layout
+        static const uint32_t layout_version     = 2;          //!< Version of the segment layout
+        static const size_t   metadata_alignment = 64;         //!< Alignment of metadata slots
+        static const size_t   buffer_alignment   = 4096;       //!< Alignment of buffer slots
+
+        //! Memory statistics of the mapped shared memory, as reported by the kernel, in bytes
+        typedef struct
+        {
+            size_t mapped_size;      //!< Size of the mapping
+            size_t resident_size;    //!< Size resident in memory
+            size_t huge_page_size;   //!< Size mapped with huge pages
+            size_t locked_size;      //!< Size locked in memory
+            size_t kernel_page_size; //!< Base page size used by the kernel for the mapping
+        } MemoryStats;
+
         SharedBufferManager(const std::string& shared_mem_name, const size_t shared_mem_size,
-                const size_t buffer_size, bool remove_when_deleted=true);
+                const size_t buffer_size, bool remove_when_deleted=true, const size_t aux_size=0,
+                const size_t metadata_size=0);
         SharedBufferManager(const std::string& shared_mem_name);
 
         ~SharedBufferManager();
@@ -48,6 +87,17 @@ namespace FrameReceiver
         const size_t get_buffer_size(void) const;
 
         void* get_buffer_address(const unsigned int buffer) const;
+        void* get_metadata_address(const unsigned int buffer) const;
+        const size_t get_metadata_size(void) const;
+
+        void* get_aux_address(void) const;
+        const size_t get_aux_size(void) const;
+
+        void bind_numa_node(const int numa_node);
+        void advise_huge_pages(void);
+        void prefault(void);
+        void lock_memory(void);
+        MemoryStats get_memory_stats(void) const;
 
     private:
 
@@ -0,0 +1,35 @@
+/*!
+ * ThreadPlacement.h - helpers for controlling thread CPU affinity, scheduling and NUMA placement
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef INCLUDE_THREADPLACEMENT_H_
+#define INCLUDE_THREADPLACEMENT_H_
+
+#include <string>
+#include <stddef.h>
+
+namespace FrameReceiver
+{
+    // Each of these functions returns zero on success or an errno value on failure, allowing the
+    // caller to decide whether a failure to place a thread or memory is fatal. Platforms without
+    // the necessary support return ENOTSUP.
+
+    // Pin the calling thread to the specified CPU
+    int set_thread_affinity(int cpu);
+
+    // Run the calling thread with the SCHED_FIFO real-time policy at the specified priority
+    int set_thread_realtime_priority(int priority);
+
+    // Bind an address range to the memory of the specified NUMA node, moving any pages already
+    // allocated elsewhere
+    int bind_memory_to_numa_node(void* addr, size_t length, int numa_node);
+
+    // Determine the NUMA node of the network interface with the specified IP address, returning -1
+    // if it cannot be determined, e.g. for the wildcard address or a non-NUMA system
+    int get_interface_numa_node(const std::string& ip_address);
+
+} // namespace FrameReceiver
+
+#endif /* INCLUDE_THREADPLACEMENT_H_ */
@@ -0,0 +1,105 @@
+/*!
+ * EmptyBufferQueue.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "EmptyBufferQueue.h"
+
+#include <sstream>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+using namespace FrameReceiver;
+
+EmptyBufferQueue::EmptyBufferQueue(size_t capacity) :
+        queue_(capacity),
+        signalled_(0),
+        notify_fd_(-1),
+        notify_write_fd_(-1)
+{
+#ifdef __linux__
+    notify_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    notify_write_fd_ = notify_fd_;
+    if (notify_fd_ < 0)
+#else
+    // Platforms without eventfd use a non-blocking pipe instead
+    int pipe_fds[2];
+    if (pipe(pipe_fds) == 0)
+    {
+        notify_fd_ = pipe_fds[0];
+        notify_write_fd_ = pipe_fds[1];
+        fcntl(notify_fd_, F_SETFL, O_NONBLOCK);
+        fcntl(notify_write_fd_, F_SETFL, O_NONBLOCK);
+    }
+    else
+#endif
+    {
+        std::stringstream ss;
+        ss << "Failed to create empty buffer queue notification descriptor: " << strerror(errno);
+        throw EmptyBufferQueueException(ss.str());
+    }
+}
+
+EmptyBufferQueue::~EmptyBufferQueue()
+{
+    close(notify_fd_);
+    if (notify_write_fd_ != notify_fd_)
+    {
+        close(notify_write_fd_);
+    }
+}
+
+//! Push an empty buffer ID onto the queue.
+//!
+//! This method must only be called from the producer thread. The consumer is signalled through
+//! the notification descriptor unless it has already been signalled and not yet cleared it.
+//!
+//! \param buffer_id - empty buffer ID
+//! \return true if the ID was queued, false if the queue is full
+
+bool EmptyBufferQueue::push(int buffer_id)
+{
+    if (!queue_.push(buffer_id))
+    {
+        return false;
+    }
+
+    if (__sync_bool_compare_and_swap(&signalled_, 0, 1))
+    {
+        uint64_t signal = 1;
+        ssize_t rc = write(notify_write_fd_, &signal, sizeof(signal));
+        (void)rc;
+    }
+    return true;
+}
+
+//! Return the notification descriptor, which becomes readable when buffer IDs have been pushed
+
+int EmptyBufferQueue::get_notify_fd(void) const
+{
+    return notify_fd_;
+}
+
+//! Clear a notification.
+//!
+//! This method must only be called from the consumer thread, before draining the queue with
+//! pop(). Any ID pushed after the notification is cleared either is drained by the subsequent
+//! pop() calls or raises a new notification.
+
+void EmptyBufferQueue::clear_notification(void)
+{
+    uint64_t signal;
+    while (read(notify_fd_, &signal, sizeof(signal)) > 0)
+    {
+    }
+    __sync_lock_release(&signalled_);
+    __sync_synchronize();
+}
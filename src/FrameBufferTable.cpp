@@ -0,0 +1,266 @@
+/*!
+ * FrameBufferTable.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameBufferTable.h"
+
+#include <boost/thread/thread.hpp>
+
+using namespace FrameReceiver;
+
+FrameBufferTable::FrameBufferTable() :
+        num_buffers_(0),
+        empty_head_(0),
+        num_empty_(0),
+        last_acquisition_(0),
+        release_count_(0),
+        num_decoders_(0)
+{
+}
+
+FrameBufferTable::~FrameBufferTable()
+{
+}
+
+//! Register a frame decoder as a user of the table.
+//!
+//! Decoders are attached when the table is registered with them, before their RX threads start
+//! receiving, so the number of decoders is fixed while frames are being received.
+
+void FrameBufferTable::attach_decoder(void)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+    num_decoders_++;
+}
+
+//! Return true if the table is shared by the decoders of more than one RX thread, in which case
+//! a frame may be completed or timed out and its buffer handed on by any of them
+
+bool FrameBufferTable::is_shared(void) const
+{
+    return num_decoders_ > 1;
+}
+
+//! Size the table for the number of frame buffers in circulation.
+//!
+//! This method should be called once, when the buffer manager is registered and before frames
+//! are received, so that the empty buffer ring and frame slot table never need to grow. Calling
+//! it again with the same or a smaller number of buffers has no effect.
+//!
+//! \param num_buffers - number of frame buffers in circulation
+
+void FrameBufferTable::reserve_buffers(size_t num_buffers)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+    if (num_buffers > num_buffers_)
+    {
+        num_buffers_ = num_buffers;
+    }
+    resize(num_buffers);
+}
+
+//! Add an empty buffer to the table, making it available for allocation to a frame.
+//!
+//! This method does not allocate memory once the table has been sized with reserve_buffers(),
+//! after which buffer IDs outside the number of buffers in circulation, e.g. from a corrupt release
+//! notification, are rejected rather than put into circulation. Tables not sized for the buffers
+//! in circulation grow as buffers are pushed.
+//!
+//! \param buffer_id - ID of the empty buffer
+//! \return true if the buffer was added, false if its ID is out of range
+
+bool FrameBufferTable::push_empty_buffer(int buffer_id)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+
+    if ((buffer_id < 0) || (num_buffers_ && (static_cast<size_t>(buffer_id) >= num_buffers_)))
+    {
+        return false;
+    }
+
+    if (num_empty_ + frame_slot_table_.size() >= empty_buffers_.size())
+    {
+        resize(empty_buffers_.size() ? (empty_buffers_.size() * 2) : 8);
+    }
+
+    if (static_cast<size_t>(buffer_id) >= acquisitions_.size())
+    {
+        acquisitions_.resize(buffer_id + 1, 0);
+        writers_.resize(buffer_id + 1, 0);
+    }
+
+    empty_buffers_[(empty_head_ + num_empty_) % empty_buffers_.size()] = buffer_id;
+    num_empty_++;
+
+    return true;
+}
+
+//! Resize the empty buffer ring and frame slot table, which must be called with the table locked.
+//!
+//! \param num_buffers - number of frame buffers the table must hold
+
+void FrameBufferTable::resize(size_t num_buffers)
+{
+    if (num_buffers > empty_buffers_.size())
+    {
+        // Unwrap the ring into the new storage, preserving the order of the empty buffers
+        std::vector<int> empty_buffers(num_buffers, -1);
+        for (size_t idx = 0; idx < num_empty_; idx++)
+        {
+            empty_buffers[idx] = empty_buffers_[(empty_head_ + idx) % empty_buffers_.size()];
+        }
+        empty_buffers_.swap(empty_buffers);
+        empty_head_ = 0;
+    }
+    if (num_buffers > acquisitions_.size())
+    {
+        acquisitions_.resize(num_buffers, 0);
+        writers_.resize(num_buffers, 0);
+    }
+    frame_slot_table_.reserve(num_buffers);
+}
+
+//! Return the number of empty buffers available for allocation
+
+const size_t FrameBufferTable::get_num_empty_buffers(void)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+    return num_empty_;
+}
+
+//! Return the number of buffers currently mapped to frames being received
+
+const size_t FrameBufferTable::get_num_mapped_buffers(void)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+    return frame_slot_table_.size();
+}
+
+//! Acquire the buffer a frame is being received into.
+//!
+//! This method returns the ID of the buffer mapped to the specified frame number. If the
+//! frame is not yet mapped, an empty buffer is allocated to it and the initialiser is called with
+//! the acquisition number of the allocation, while the table is locked, so that no other thread
+//! can use the buffer before it is ready.
+//!
+//! \param frame_number - frame number to acquire the buffer for
+//! \param initialiser - callback to initialise a newly allocated buffer
+//! \return buffer ID, or -1 if no empty buffers are available
+
+int FrameBufferTable::acquire_buffer(uint32_t frame_number, const FrameBufferInitialiser& initialiser)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+
+    int buffer_id = frame_slot_table_.find(frame_number);
+    if (buffer_id >= 0)
+    {
+        return buffer_id;
+    }
+
+    if (num_empty_ == 0)
+    {
+        return -1;
+    }
+
+    buffer_id = empty_buffers_[empty_head_];
+    empty_head_ = (empty_head_ + 1) % empty_buffers_.size();
+    num_empty_--;
+    frame_slot_table_.insert(frame_number, buffer_id);
+    acquisitions_[buffer_id] = ++last_acquisition_;
+
+    initialiser(buffer_id, frame_number, last_acquisition_);
+
+    return buffer_id;
+}
+
+//! Release a frame buffer from the table.
+//!
+//! This method removes the mapping of a frame number to a buffer, e.g. when the frame is complete
+//! or has timed out. Only one caller can successfully release a given mapping, allowing
+//! several threads to race to release a frame while ensuring it is handed on exactly once. A
+//! successful release returns once no other decoder is writing to the buffer, so the caller must
+//! not itself be registered as writing to it.
+//!
+//! \param frame_number - frame number to release
+//! \param buffer_id - ID of the buffer the frame was being received into
+//! \return true if the mapping was released by this call
+
+bool FrameBufferTable::release_buffer(uint32_t frame_number, int buffer_id)
+{
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+
+        if (frame_slot_table_.find(frame_number) != buffer_id)
+        {
+            return false;
+        }
+
+        frame_slot_table_.erase(frame_number);
+        __atomic_add_fetch(&release_count_, 1, __ATOMIC_RELEASE);
+    }
+
+    wait_for_writers(buffer_id);
+
+    return true;
+}
+
+//! Release a frame buffer from the table, if it is still mapped by the specified allocation.
+//!
+//! This method releases the mapping as above, provided the buffer has not been released and
+//! allocated to the same frame number again since the specified acquisition, e.g. by repeated
+//! sends of a single frame.
+//!
+//! \param frame_number - frame number to release
+//! \param buffer_id - ID of the buffer the frame was being received into
+//! \param acquisition - acquisition number passed to the initialiser when the buffer was allocated
+//! \return true if the mapping was released by this call
+
+bool FrameBufferTable::release_buffer(uint32_t frame_number, int buffer_id, uint32_t acquisition)
+{
+    {
+        boost::mutex::scoped_lock lock(mutex_);
+
+        if ((frame_slot_table_.find(frame_number) != buffer_id) || (acquisitions_[buffer_id] != acquisition))
+        {
+            return false;
+        }
+
+        frame_slot_table_.erase(frame_number);
+        __atomic_add_fetch(&release_count_, 1, __ATOMIC_RELEASE);
+    }
+
+    wait_for_writers(buffer_id);
+
+    return true;
+}
+
+//! Wait for any decoders still writing to a released buffer to finish.
+//!
+//! Decoders only write to a buffer for the duration of a packet copy, so this spins rather than
+//! blocking. The full barrier orders the release before the writer count is read, so that a
+//! decoder either registered as a writer before the release, and is waited for here, or sees the
+//! release in begin_write() and backs off.
+//!
+//! \param buffer_id - ID of the released buffer
+
+void FrameBufferTable::wait_for_writers(int buffer_id)
+{
+    __sync_synchronize();
+    while (__atomic_load_n(&writers_[buffer_id], __ATOMIC_ACQUIRE) != 0)
+    {
+        boost::this_thread::yield();
+    }
+}
+
+//! Take a snapshot of the frame buffers currently mapped.
+//!
+//! \param mapped_buffers - vector to fill with frame number and buffer ID pairs
+
+void FrameBufferTable::get_mapped_buffers(std::vector<std::pair<uint32_t, int> >& mapped_buffers)
+{
+    boost::mutex::scoped_lock lock(mutex_);
+
+    frame_slot_table_.get_entries(mapped_buffers);
+}
@@ -0,0 +1,114 @@
+/*!
+ * FrameDecoderRegistry.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameDecoderRegistry.h"
+#include "PercivalEmulatorFrameDecoder.h"
+
+#include <dlfcn.h>
+
+using namespace FrameReceiver;
+
+const char* FrameDecoderRegistry::plugin_entry_symbol = "register_frame_decoders";
+
+//! Constructor for the FrameDecoderRegistry class.
+//!
+//! This constructor registers the decoders built into the frame receiver.
+
+FrameDecoderRegistry::FrameDecoderRegistry()
+{
+    register_decoder("percivalemulator", &create_frame_decoder<PercivalEmulatorFrameDecoder>);
+}
+
+//! Registers a frame decoder factory for a sensor type.
+//!
+//! \param[in] sensor_name - sensor type name selecting the decoder
+//! \param[in] factory - function creating decoder instances
+
+void FrameDecoderRegistry::register_decoder(const std::string& sensor_name, FrameDecoderFactory factory)
+{
+    if (factories_.count(sensor_name))
+    {
+        throw FrameDecoderRegistryException("A frame decoder is already registered for sensor type " + sensor_name);
+    }
+    factories_[sensor_name] = factory;
+}
+
+//! Loads a frame decoder plugin library.
+//!
+//! This method loads a shared library and calls its entry point to register the decoders it
+//! provides. The library remains loaded for the lifetime of the process.
+//!
+//! \param[in] plugin_path - path to the plugin shared library
+
+void FrameDecoderRegistry::load_plugin(const std::string& plugin_path)
+{
+    void* handle = dlopen(plugin_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!handle)
+    {
+        throw FrameDecoderRegistryException("Unable to load frame decoder plugin " + plugin_path + ": " + dlerror());
+    }
+
+    // Converting the symbol address to a function pointer via a union avoids the object to
+    // function pointer cast that C++03 does not allow
+    union
+    {
+        void* symbol;
+        FrameDecoderPluginEntry entry;
+    } plugin_entry;
+    plugin_entry.symbol = dlsym(handle, plugin_entry_symbol);
+    if (!plugin_entry.symbol)
+    {
+        std::string error(dlerror());
+        dlclose(handle);
+        throw FrameDecoderRegistryException("Frame decoder plugin " + plugin_path + " has no entry point: " + error);
+    }
+
+    plugin_entry.entry(*this);
+}
+
+//! Returns true if a decoder is registered for a sensor type.
+
+bool FrameDecoderRegistry::has_decoder(const std::string& sensor_name) const
+{
+    return factories_.count(sensor_name) != 0;
+}
+
+//! Returns the sensor type names of all registered decoders, in order.
+
+std::vector<std::string> FrameDecoderRegistry::get_sensor_names(void) const
+{
+    std::vector<std::string> sensor_names;
+    for (std::map<std::string, FrameDecoderFactory>::const_iterator itr = factories_.begin();
+            itr != factories_.end(); ++itr)
+    {
+        sensor_names.push_back(itr->first);
+    }
+    return sensor_names;
+}
+
+//! Creates and configures a frame decoder for a sensor type.
+//!
+//! \param[in] sensor_name - sensor type name selecting the decoder
+//! \param[in] logger - logger for the decoder
+//! \param[in] enable_packet_logging - enable logging of packet headers
+//! \param[in] frame_timeout_ms - incomplete frame timeout in ms
+//! \param[in] params - decoder-specific configuration parameters
+//! \return shared pointer to the new decoder
+
+FrameDecoderPtr FrameDecoderRegistry::create_decoder(const std::string& sensor_name, LoggerPtr& logger,
+        bool enable_packet_logging, unsigned int frame_timeout_ms, const FrameDecoderParams& params) const
+{
+    std::map<std::string, FrameDecoderFactory>::const_iterator itr = factories_.find(sensor_name);
+    if (itr == factories_.end())
+    {
+        throw FrameDecoderRegistryException("No frame decoder registered for sensor type " + sensor_name);
+    }
+
+    FrameDecoderPtr frame_decoder(itr->second(logger, enable_packet_logging, frame_timeout_ms));
+    frame_decoder->configure(params);
+
+    return frame_decoder;
+}
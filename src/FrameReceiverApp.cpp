@@ -8,6 +8,9 @@
 #include "FrameReceiverApp.h"
 #include "FrameReceiverConfig.h"
 #include "SharedBufferManager.h"
+#include "ThreadPlacement.h"
+#include "IpcFrameNotification.h"
+#include "NotificationRing.h"
 
 #include <iostream>
 #include <iomanip>
@@ -16,6 +19,7 @@
 #include <string>
 #include <iterator>
 #include <cstdlib>
+#include <cstring>
 using namespace std;
 
 #include <boost/foreach.hpp>
@@ -33,7 +37,7 @@ IMPLEMENT_DEBUG_LEVEL;
 //! This constructor initialises the FrameRecevierApp instance
 
 FrameReceiverApp::FrameReceiverApp(void) :
-    rx_channel_(ZMQ_PAIR),
+    next_rx_thread_(0),
     ctrl_channel_(ZMQ_REP),
     frame_ready_channel_(ZMQ_PUB),
     frame_release_channel_(ZMQ_SUB),
@@ -50,9 +54,8 @@ FrameReceiverApp::FrameReceiverApp(void) :
 FrameReceiverApp::~FrameReceiverApp()
 {
 
-    // Delete the RX thread object by resetting the scoped pointer, allowing the IPC channel
-    // to be closed cleanly
-    rx_thread_.reset();
+    // Delete the RX thread objects, allowing the IPC channels to be closed cleanly
+    rx_threads_.clear();
 
 }
 
@@ -101,18 +104,50 @@ int FrameReceiverApp::parse_arguments(int argc, char** argv)
 					"Set the maximum amount of shared memory to allocate for frame buffers")
 				("sensortype,s", po::value<std::string>()->default_value("unknown"),
 					"Set the sensor type to receive frame data from")
+				("decoderplugin", po::value<std::vector<std::string> >()->composing(),
+				    "Load frame decoder plugin library, may be given more than once")
+				("decoderparam", po::value<std::vector<std::string> >()->composing(),
+				    "Set a frame decoder specific parameter as name=value, may be given more than once")
 				("port,p",       po::value<std::string>()->default_value(FrameReceiver::Defaults::default_rx_port_list),
                     "Set the port to receive frame data on")
                 ("ipaddress,i",  po::value<std::string>()->default_value(FrameReceiver::Defaults::default_rx_address),
                     "Set the IP address of the interface to receive frame data on")
+                ("rxthreads",    po::value<unsigned int>()->default_value(FrameReceiver::Defaults::default_rx_threads),
+                    "Set the number of RX threads receiving frame data")
+                ("rxreuseport",  po::value<bool>()->default_value(FrameReceiver::Defaults::default_rx_reuse_port),
+                    "Share all ports between RX threads using SO_REUSEPORT rather than distributing ports between threads")
+                ("rxcpu",        po::value<std::string>()->default_value(FrameReceiver::Defaults::default_rx_cpu_list),
+                    "Set the CPU(s) to pin RX threads to, assigned to threads in turn")
+                ("maincpu",      po::value<int>()->default_value(FrameReceiver::Defaults::default_main_cpu),
+                    "Set the CPU to pin the main thread to (-1 disables pinning)")
+                ("rxpriority",   po::value<int>()->default_value(FrameReceiver::Defaults::default_rx_priority),
+                    "Set the SCHED_FIFO real-time priority of RX threads (0 selects normal scheduling)")
+                ("numanode",     po::value<std::string>()->default_value(FrameReceiver::Defaults::default_numa_node),
+                    "Set the NUMA node to bind frame buffer memory to (none, auto to use the receive interface node, or a node number)")
+                ("notifyformat", po::value<std::string>()->default_value(FrameReceiver::Defaults::default_notify_format),
+                    "Set the initial format of frame ready notifications (json or binary), which processors can change with a configure command")
+                ("notifyring",   po::value<bool>()->default_value(FrameReceiver::Defaults::default_notify_ring),
+                    "Also exchange frame ready and release notifications with local processors through rings in the shared buffer, instead of the channels while a processor is attached")
+                ("rxbatch",      po::value<unsigned int>()->default_value(FrameReceiver::Defaults::default_rx_batch_size),
+                    "Set the maximum number of datagrams received per socket wakeup (1 disables batched receive)")
                 ("sharedbuf",    po::value<std::string>()->default_value(FrameReceiver::Defaults::default_shared_buffer_name),
                     "Set the name of the shared memory frame buffer")
+                ("hugepages",    po::value<bool>()->default_value(FrameReceiver::Defaults::default_buffer_huge_pages),
+                    "Back the shared memory frame buffer with transparent huge pages")
+                ("prefault",     po::value<bool>()->default_value(FrameReceiver::Defaults::default_buffer_prefault),
+                    "Fault in the whole shared memory frame buffer at startup")
+                ("lockmem",      po::value<bool>()->default_value(FrameReceiver::Defaults::default_buffer_lock),
+                    "Lock the shared memory frame buffer into RAM")
                 ("frametimeout", po::value<unsigned int>()->default_value(FrameReceiver::Defaults::default_frame_timeout_ms),
                     "Set the incomplete frame timeout in ms")
+                ("timeoutcheck", po::value<unsigned int>()->default_value(FrameReceiver::Defaults::default_frame_timeout_check_ms),
+                    "Set the interval in ms between checks for timed out incomplete frames")
                 ("frames,f",     po::value<unsigned int>()->default_value(FrameReceiver::Defaults::default_frame_count),
                     "Set the number of frames to receive before terminating")
                 ("packetlog",    po::value<bool>()->default_value(FrameReceiver::Defaults::default_enable_packet_logging),
                     "Enable logging of packet diagnostics to file")
+                ("capture",      po::value<std::string>(),
+                    "Capture received datagrams to the specified pcap file, suffixed with the thread index for multiple RX threads")
 				;
 
 		// Group the variables for parsing at the command line and/or from the configuration file
@@ -182,9 +217,32 @@ int FrameReceiverApp::parse_arguments(int argc, char** argv)
 		{
 		    std::string sensor_name = vm["sensortype"].as<std::string>();
 		    config_.sensor_type_ = config_.map_sensor_name_to_type(sensor_name);
+		    config_.sensor_name_ = sensor_name;
 		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting sensor type to " << sensor_name << " (" << config_.sensor_type_ << ")");
 		}
 
+		if (vm.count("decoderplugin"))
+		{
+		    config_.decoder_plugins_ = vm["decoderplugin"].as<std::vector<std::string> >();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting frame decoder plugins to load to " << config_.decoder_plugins_.size() << " libraries");
+		}
+
+		if (vm.count("decoderparam"))
+		{
+		    std::vector<std::string> decoder_params = vm["decoderparam"].as<std::vector<std::string> >();
+		    for (std::vector<std::string>::iterator itr = decoder_params.begin(); itr != decoder_params.end(); ++itr)
+		    {
+		        if (!config_.add_decoder_param(*itr))
+		        {
+		            LOG4CXX_ERROR(logger_, "Ignoring malformed frame decoder parameter: " << *itr);
+		        }
+		        else
+		        {
+		            LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting frame decoder parameter " << *itr);
+		        }
+		    }
+		}
+
 		if (vm.count("port"))
 		{
 		    config_.rx_ports_.clear();
@@ -204,18 +262,120 @@ int FrameReceiverApp::parse_arguments(int argc, char** argv)
 		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting RX interface address to " << config_.rx_address_);
 		}
 
+		if (vm.count("rxreuseport"))
+		{
+		    config_.rx_reuse_port_ = vm["rxreuseport"].as<bool>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "RX port reuse is " << (config_.rx_reuse_port_ ? "enabled" : "disabled"));
+		}
+
+		if (vm.count("rxthreads"))
+		{
+		    config_.rx_threads_ = vm["rxthreads"].as<unsigned int>();
+		    if (config_.rx_threads_ == 0)
+		    {
+		        config_.rx_threads_ = 1;
+		    }
+		    if (!config_.rx_reuse_port_ && (config_.rx_threads_ > config_.rx_ports_.size()) && !config_.rx_ports_.empty())
+		    {
+		        LOG4CXX_WARN(logger_, "More RX threads requested than ports to receive on, limiting to " << config_.rx_ports_.size() << " threads");
+		        config_.rx_threads_ = config_.rx_ports_.size();
+		    }
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting number of RX threads to " << config_.rx_threads_);
+		}
+
+		if (vm.count("rxcpu"))
+		{
+		    config_.rx_cpus_.clear();
+		    config_.tokenize_cpu_list(config_.rx_cpus_, vm["rxcpu"].as<std::string>());
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting RX thread CPU(s) to " << vm["rxcpu"].as<std::string>());
+		}
+
+		if (vm.count("maincpu"))
+		{
+		    config_.main_cpu_ = vm["maincpu"].as<int>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting main thread CPU to " << config_.main_cpu_);
+		}
+
+		if (vm.count("rxpriority"))
+		{
+		    config_.rx_priority_ = vm["rxpriority"].as<int>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting RX thread real-time priority to " << config_.rx_priority_);
+		}
+
+		if (vm.count("numanode"))
+		{
+		    config_.numa_node_ = config_.map_numa_node_option(vm["numanode"].as<std::string>());
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting frame buffer NUMA node to " << vm["numanode"].as<std::string>());
+		}
+
+		if (vm.count("notifyformat"))
+		{
+		    std::string notify_format = vm["notifyformat"].as<std::string>();
+		    config_.notify_format_ = config_.map_notify_format_name(notify_format);
+		    if (config_.notify_format_ == Defaults::NotificationFormatIllegal)
+		    {
+		        LOG4CXX_ERROR(logger_, "Illegal notification format specified: " << notify_format);
+		        config_.notify_format_ = Defaults::NotificationFormatJson;
+		    }
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting frame ready notification format to " << notify_format);
+		}
+
+		if (vm.count("notifyring"))
+		{
+		    config_.notify_ring_ = vm["notifyring"].as<bool>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Shared memory frame notification rings are " <<
+		            (config_.notify_ring_ ? "enabled" : "disabled"));
+		}
+
+		if (vm.count("rxbatch"))
+		{
+		    config_.rx_batch_size_ = vm["rxbatch"].as<unsigned int>();
+		    if (config_.rx_batch_size_ == 0)
+		    {
+		        config_.rx_batch_size_ = 1;
+		    }
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting RX receive batch size to " << config_.rx_batch_size_);
+		}
+
 		if (vm.count("sharedbuf"))
 		{
 		    config_.shared_buffer_name_ = vm["sharedbuf"].as<std::string>();
 		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting shared frame buffer name to " << config_.shared_buffer_name_);
 		}
 
+		if (vm.count("hugepages"))
+		{
+		    config_.buffer_huge_pages_ = vm["hugepages"].as<bool>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Huge pages for shared frame buffer are " <<
+		            (config_.buffer_huge_pages_ ? "enabled" : "disabled"));
+		}
+
+		if (vm.count("prefault"))
+		{
+		    config_.buffer_prefault_ = vm["prefault"].as<bool>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Prefaulting of shared frame buffer is " <<
+		            (config_.buffer_prefault_ ? "enabled" : "disabled"));
+		}
+
+		if (vm.count("lockmem"))
+		{
+		    config_.buffer_lock_ = vm["lockmem"].as<bool>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Locking of shared frame buffer memory is " <<
+		            (config_.buffer_lock_ ? "enabled" : "disabled"));
+		}
+
 		if (vm.count("frametimeout"))
 		{
 		    config_.frame_timeout_ms_ = vm["frametimeout"].as<unsigned int>();
 		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting incomplete frame timeout to " << config_.frame_timeout_ms_);
 		}
 
+		if (vm.count("timeoutcheck"))
+		{
+		    config_.frame_timeout_check_ms_ = vm["timeoutcheck"].as<unsigned int>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Setting incomplete frame timeout check interval to " << config_.frame_timeout_check_ms_);
+		}
+
 		if (vm.count("frames"))
 		{
 		    config_.frame_count_ = vm["frames"].as<unsigned int>();
@@ -229,6 +389,12 @@ int FrameReceiverApp::parse_arguments(int argc, char** argv)
 		            (config_.enable_packet_logging_ ? "enabled" : "disabled"));
 		}
 
+		if (vm.count("capture"))
+		{
+		    config_.rx_capture_file_ = vm["capture"].as<std::string>();
+		    LOG4CXX_DEBUG_LEVEL(1, logger_, "Capturing received datagrams to " << config_.rx_capture_file_);
+		}
+
 	}
 	catch (Exception &e)
 	{
@@ -271,19 +437,58 @@ void FrameReceiverApp::run(void)
         // Initialise the frame buffer buffer manager
         initialise_buffer_manager();
 
-        // Create the RX thread object
-        rx_thread_.reset(new FrameReceiverRxThread( config_, logger_, buffer_manager_, frame_decoder_));
+        // Create the RX thread objects
+        for (unsigned int rx_thread = 0; rx_thread < config_.rx_threads_; rx_thread++)
+        {
+            rx_threads_.push_back(boost::shared_ptr<FrameReceiverRxThread>(new FrameReceiverRxThread(
+                    config_, logger_, buffer_manager_, frame_decoders_[rx_thread], 100, rx_thread)));
+        }
+
+        // Initialise the shared memory notification rings if enabled. The ready ring is written as
+        // frame ready notifications are handled while a processor is attached to it, and the release
+        // ring is drained whenever its watcher signals the reactor.
+        if (config_.notify_ring_)
+        {
+            initialise_notification_rings();
+            reactor_.register_socket(release_ring_watcher_->get_notify_fd(),
+                    boost::bind(&FrameReceiverApp::handle_release_ring, this));
+        }
+
+        // Switch the RX threads to binary frame ready notifications, which are forwarded as-is or
+        // converted to JSON depending on the format of the frame ready channel
+        configure_rx_notifications();
 
         // Pre-charge all frame buffers onto the RX thread queue ready for use
         precharge_buffers();
 
+        // Pin the main thread if requested. This is done after the RX threads are created so that
+        // they do not inherit its affinity
+        if (config_.main_cpu_ >= 0)
+        {
+            int rc = set_thread_affinity(config_.main_cpu_);
+            if (rc != 0)
+            {
+                LOG4CXX_WARN(logger_, "Failed to pin main thread to CPU " << config_.main_cpu_ << ": " << strerror(rc));
+            }
+            else
+            {
+                LOG4CXX_DEBUG_LEVEL(1, logger_, "Main thread pinned to CPU " << config_.main_cpu_);
+            }
+        }
+
         LOG4CXX_DEBUG_LEVEL(1, logger_, "Main thread entering reactor loop");
 
         // Run the reactor event loop
         reactor_.run();
 
-        // Destroy the RX thread
-        rx_thread_.reset();
+        // Destroy the RX threads
+        rx_threads_.clear();
+
+        if (release_ring_watcher_)
+        {
+            reactor_.remove_socket(release_ring_watcher_->get_notify_fd());
+            release_ring_watcher_.reset();
+        }
 
         // Clean up IPC channels
         cleanup_ipc_channels();
@@ -313,8 +518,14 @@ void FrameReceiverApp::initialise_ipc_channels(void)
     // Bind the control channel
     ctrl_channel_.bind(config_.ctrl_channel_endpoint_);
 
-    // Bind the RX thread channel
-    rx_channel_.bind(config_.rx_channel_endpoint_);
+    // Bind a channel for each RX thread
+    for (unsigned int rx_thread = 0; rx_thread < config_.rx_threads_; rx_thread++)
+    {
+        boost::shared_ptr<IpcChannel> rx_channel(new IpcChannel(ZMQ_PAIR));
+        std::string rx_channel_endpoint = config_.get_rx_channel_endpoint(rx_thread);
+        rx_channel->bind(rx_channel_endpoint);
+        rx_channels_.push_back(rx_channel);
+    }
 
     // Bind the frame ready and release channels
     frame_ready_channel_.bind(config_.frame_ready_endpoint_);
@@ -325,7 +536,10 @@ void FrameReceiverApp::initialise_ipc_channels(void)
 
     // Add IPC channels to the reactor
     reactor_.register_channel(ctrl_channel_, boost::bind(&FrameReceiverApp::handle_ctrl_channel, this));
-    reactor_.register_channel(rx_channel_, boost::bind(&FrameReceiverApp::handle_rx_channel, this));
+    for (unsigned int rx_thread = 0; rx_thread < rx_channels_.size(); rx_thread++)
+    {
+        reactor_.register_channel(*rx_channels_[rx_thread], boost::bind(&FrameReceiverApp::handle_rx_channel, this, rx_thread));
+    }
 	reactor_.register_channel(frame_release_channel_, boost::bind(&FrameReceiverApp::handle_frame_release_channel, this));
 
 }
@@ -334,12 +548,19 @@ void FrameReceiverApp::cleanup_ipc_channels(void)
 {
     // Remove IPC channels from the reactor
     reactor_.remove_channel(ctrl_channel_);
-    reactor_.remove_channel(rx_channel_);
+    for (unsigned int rx_thread = 0; rx_thread < rx_channels_.size(); rx_thread++)
+    {
+        reactor_.remove_channel(*rx_channels_[rx_thread]);
+    }
     reactor_.remove_channel(frame_release_channel_);
 
     // Close all channels
     ctrl_channel_.close();
-    rx_channel_.close();
+    for (unsigned int rx_thread = 0; rx_thread < rx_channels_.size(); rx_thread++)
+    {
+        rx_channels_[rx_thread]->close();
+    }
+    rx_channels_.clear();
     frame_ready_channel_.close();
     frame_release_channel_.close();
 
@@ -347,55 +568,137 @@ void FrameReceiverApp::cleanup_ipc_channels(void)
 
 void FrameReceiverApp::initialise_frame_decoder(void)
 {
-    switch (config_.sensor_type_)
+    // Each RX thread has its own decoder, but all decoders share a single frame buffer table so that
+    // a frame is assembled into one buffer whichever thread receives its packets
+    FrameBufferTablePtr frame_buffer_table(new FrameBufferTable());
+
+    // Load any decoder plugins, which register the decoders they provide alongside those built in
+    for (std::vector<std::string>::iterator itr = config_.decoder_plugins_.begin();
+            itr != config_.decoder_plugins_.end(); ++itr)
     {
-    case Defaults::SensorTypePercivalEmulator:
-        frame_decoder_.reset(new PercivalEmulatorFrameDecoder(logger_, config_.enable_packet_logging_, config_.frame_timeout_ms_));
-        LOG4CXX_INFO(logger_, "Created PERCIVAL emulator frame decoder instance");
-        break;
+        decoder_registry_.load_plugin(*itr);
+        LOG4CXX_DEBUG_LEVEL(1, logger_, "Loaded frame decoder plugin " << *itr);
+    }
 
-    case Defaults::SensorTypePercival2M:
-    case Defaults::SensorTypePercival13M:
-    case Defaults::SensorTypeExcalibur3M:
-        throw FrameReceiverException("Cannot initialize frame decoder - sensor type not yet implemented");
-        break;
+    if (!decoder_registry_.has_decoder(config_.sensor_name_))
+    {
+        if (config_.sensor_type_ != Defaults::SensorTypeIllegal)
+        {
+            throw FrameReceiverException("Cannot initialize frame decoder - no decoder plugin loaded for sensor type " + config_.sensor_name_);
+        }
+        throw FrameReceiverException("Cannot initialize frame decoder - sensor type " + config_.sensor_name_ + " not recognised");
+    }
 
-    case Defaults::SensorTypeIllegal:
-        throw FrameReceiverException("Cannot initialize frame decoder - illegal sensor type specified");
-        break;
+    for (unsigned int rx_thread = 0; rx_thread < config_.rx_threads_; rx_thread++)
+    {
+        FrameDecoderPtr frame_decoder = decoder_registry_.create_decoder(config_.sensor_name_, logger_,
+                config_.enable_packet_logging_, config_.frame_timeout_ms_, config_.decoder_params_);
+        LOG4CXX_INFO(logger_, "Created " << config_.sensor_name_ << " frame decoder instance");
 
-    default:
-        throw FrameReceiverException("Cannot initialize frame decoder - sensor type not recognised");
-        break;
+        frame_decoder->register_frame_buffer_table(frame_buffer_table);
+        frame_decoders_.push_back(frame_decoder);
     }
 }
 
 
 void FrameReceiverApp::initialise_buffer_manager(void)
 {
-    // Create a shared buffer manager
+    // Create a shared buffer manager, with metadata slots for the frame headers and an auxiliary
+    // region for the frame ready and release notification rings if enabled
+    size_t aux_size = 0;
+    if (config_.notify_ring_)
+    {
+        aux_size = 2 * NotificationRing::get_region_size(config_.max_buffer_mem_ / frame_decoders_[0]->get_frame_buffer_size());
+    }
     buffer_manager_.reset(new SharedBufferManager(config_.shared_buffer_name_, config_.max_buffer_mem_,
-            frame_decoder_->get_frame_buffer_size(), false));
+            frame_decoders_[0]->get_frame_buffer_size(), false, aux_size, frame_decoders_[0]->get_frame_header_size()));
     LOG4CXX_DEBUG_LEVEL(1, logger_, "Initialised frame buffer manager of total size " << config_.max_buffer_mem_
             << " with " << buffer_manager_->get_num_buffers() << " buffers");
 
-    // Register buffer manager with the frame decoder
-    frame_decoder_->register_buffer_manager(buffer_manager_);
+    // Bind the frame buffer memory to the requested NUMA node, or to the node of the receive
+    // interface if automatic placement is selected
+    int numa_node = config_.numa_node_;
+    if (numa_node == Defaults::numa_node_auto)
+    {
+        numa_node = get_interface_numa_node(config_.rx_address_);
+        if (numa_node < 0)
+        {
+            LOG4CXX_WARN(logger_, "Unable to determine NUMA node of receive interface " << config_.rx_address_
+                    << ", frame buffer memory will not be bound");
+        }
+    }
+    if (numa_node >= 0)
+    {
+        try {
+            buffer_manager_->bind_numa_node(numa_node);
+            LOG4CXX_DEBUG_LEVEL(1, logger_, "Bound frame buffer memory to NUMA node " << numa_node);
+        }
+        catch (SharedBufferManagerException& e)
+        {
+            LOG4CXX_WARN(logger_, e.what());
+        }
+    }
+
+    // Back the frame buffer memory with huge pages, fault it in and lock it as requested. This is
+    // done after NUMA binding so that pages are allocated on the bound node, and ensures the first
+    // frames after startup do not incur page faults while being received.
+    try {
+        if (config_.buffer_huge_pages_)
+        {
+            buffer_manager_->advise_huge_pages();
+        }
+        if (config_.buffer_prefault_)
+        {
+            buffer_manager_->prefault();
+        }
+        if (config_.buffer_lock_)
+        {
+            buffer_manager_->lock_memory();
+        }
+    }
+    catch (SharedBufferManagerException& e)
+    {
+        LOG4CXX_WARN(logger_, e.what());
+    }
+
+    SharedBufferManager::MemoryStats mem_stats = buffer_manager_->get_memory_stats();
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "Frame buffer memory " << (mem_stats.mapped_size >> 20) << " MiB mapped, "
+            << (mem_stats.resident_size >> 20) << " MiB resident, "
+            << (mem_stats.huge_page_size >> 20) << " MiB in huge pages, "
+            << (mem_stats.locked_size >> 20) << " MiB locked, kernel page size "
+            << (mem_stats.kernel_page_size >> 10) << " KiB");
+    if (config_.buffer_huge_pages_ && mem_stats.resident_size && !mem_stats.huge_page_size)
+    {
+        LOG4CXX_WARN(logger_, "Frame buffer memory is not mapped with huge pages, "
+                "check /sys/kernel/mm/transparent_hugepage/shmem_enabled");
+    }
+
+    // Register buffer manager with the frame decoders
+    for (std::vector<FrameDecoderPtr>::iterator decoder_itr = frame_decoders_.begin(); decoder_itr != frame_decoders_.end(); decoder_itr++)
+    {
+        (*decoder_itr)->register_buffer_manager(buffer_manager_);
+    }
 
 }
 
 void FrameReceiverApp::precharge_buffers(void)
 {
-    // Push the IDs of all of the empty buffers onto the RX thread channel
-    // TODO if the number of buffers is so big that the RX thread channel would reach HWM (in either direction)
-    // before the reactor has time to start, we could consider putting this pre-charge into a timer handler
-    // that runs as soon as the reactor starts, but need to think about how this might block. Need non-blocking
-    // send on channels??
+    // Push the IDs of all of the empty buffers onto the RX thread empty buffer queues. The queues
+    // are sized to hold every buffer, so this cannot block or overflow
     for (int buf = 0; buf < buffer_manager_->get_num_buffers(); buf++)
     {
-        IpcMessage buf_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyFrameRelease);
-        buf_msg.set_param("buffer_id", buf);
-        rx_channel_.send(buf_msg.encode());
+        release_empty_buffer(buf);
+    }
+}
+
+void FrameReceiverApp::configure_rx_notifications(void)
+{
+    IpcMessage configure_msg(IpcMessage::MsgTypeCmd, IpcMessage::MsgValCmdConfigure);
+    configure_msg.set_param("notification_format", std::string("binary"));
+
+    for (unsigned int rx_thread = 0; rx_thread < rx_channels_.size(); rx_thread++)
+    {
+        rx_channels_[rx_thread]->send(configure_msg.encode());
     }
 }
 
@@ -419,6 +722,37 @@ void FrameReceiverApp::handle_ctrl_channel(void)
         	LOG4CXX_DEBUG_LEVEL(3, logger_, "Got control channel command request");
             ctrl_reply.set_msg_type(IpcMessage::MsgTypeAck);
             ctrl_reply.set_msg_val(ctrl_req.get_msg_val());
+
+            // Processors can set the format of frame ready notifications with a configure command. The
+            // frame ready channel publishes a single stream, so the format applies to all subscribers
+            if (ctrl_req.get_msg_val() == IpcMessage::MsgValCmdConfigure)
+            {
+                std::string format_name = ctrl_req.get_param<std::string>("notification_format", "");
+                if (!format_name.empty())
+                {
+                    Defaults::NotificationFormat format = config_.map_notify_format_name(format_name);
+                    if (format != Defaults::NotificationFormatIllegal)
+                    {
+                        if (format != config_.notify_format_)
+                        {
+                            LOG4CXX_WARN(logger_, "Frame ready notification format changed to " << format_name
+                                    << " for all subscribers of the frame ready channel");
+                        }
+                        config_.notify_format_ = format;
+                    }
+                    else
+                    {
+                        LOG4CXX_ERROR(logger_, "Got illegal notification format on control channel: " << format_name);
+                        ctrl_reply.set_msg_type(IpcMessage::MsgTypeNack);
+                    }
+                }
+                ctrl_reply.set_param("notification_format",
+                        std::string(config_.notify_format_ == Defaults::NotificationFormatBinary ? "binary" : "json"));
+            }
+            else if (ctrl_req.get_msg_val() == IpcMessage::MsgValCmdStatus)
+            {
+                add_status_params(ctrl_reply);
+            }
             break;
 
         default:
@@ -436,10 +770,43 @@ void FrameReceiverApp::handle_ctrl_channel(void)
 
 }
 
-void FrameReceiverApp::handle_rx_channel(void)
+void FrameReceiverApp::handle_rx_channel(unsigned int rx_thread)
 {
-    std::string rx_reply_encoded = rx_channel_.recv();
+    std::string rx_reply_encoded = rx_channels_[rx_thread]->recv();
     try {
+
+        // Binary frame ready notifications are pushed onto the ready ring if a processor is attached
+        // to it, otherwise forwarded as-is or converted to JSON, depending on the format currently set
+        // for the frame ready channel
+        if (IpcFrameNotification::is_binary(rx_reply_encoded))
+        {
+            IpcFrameNotification ready_notification(rx_reply_encoded);
+            if (ready_notification.get_msg_val() == IpcMessage::MsgValNotifyFrameReady)
+            {
+                LOG4CXX_DEBUG_LEVEL(2, logger_, "Got frame ready notification from RX thread for frame "
+                        << ready_notification.get_frame_number() << " in buffer " << ready_notification.get_buffer_id());
+                if (!push_ready_ring(ready_notification))
+                {
+                    if (config_.notify_format_ == Defaults::NotificationFormatBinary)
+                    {
+                        frame_ready_channel_.send(rx_reply_encoded);
+                    }
+                    else
+                    {
+                        std::string ready_json = ready_notification.encode_json();
+                        frame_ready_channel_.send(ready_json);
+                    }
+                }
+                frames_received_++;
+            }
+            else
+            {
+                LOG4CXX_ERROR(logger_, "Got unexpected binary notification from RX thread with value "
+                        << ready_notification.get_msg_val());
+            }
+            return;
+        }
+
         IpcMessage rx_reply(rx_reply_encoded.c_str());
         //LOG4CXX_DEBUG_LEVEL(1, logger_, "Got reply from RX thread : " << rx_reply_encoded);
 
@@ -448,10 +815,27 @@ void FrameReceiverApp::handle_rx_channel(void)
         {
         	LOG4CXX_DEBUG_LEVEL(2, logger_, "Got frame ready notification from RX thread for frame " << rx_reply.get_param<int>("frame", -1)
                     << " in buffer " << rx_reply.get_param<int>("buffer_id", -1));
-            frame_ready_channel_.send(rx_reply_encoded);
+            IpcFrameNotification ready_notification(IpcMessage::MsgValNotifyFrameReady,
+                    rx_reply.get_param<int>("frame", -1), rx_reply.get_param<int>("buffer_id", -1));
+            if (!push_ready_ring(ready_notification))
+            {
+                if (config_.notify_format_ == Defaults::NotificationFormatBinary)
+                {
+                    std::string ready_binary = ready_notification.encode();
+                    frame_ready_channel_.send(ready_binary);
+                }
+                else
+                {
+                    frame_ready_channel_.send(rx_reply_encoded);
+                }
+            }
 
             frames_received_++;
         }
+        else if (rx_reply.get_msg_type() == IpcMessage::MsgTypeAck)
+        {
+            LOG4CXX_DEBUG_LEVEL(3, logger_, "Got acknowledgement from RX thread : " << rx_reply_encoded);
+        }
         else
         {
             LOG4CXX_ERROR(logger_, "Got unexpected message from RX thread: " << rx_reply_encoded);
@@ -467,24 +851,31 @@ void FrameReceiverApp::handle_frame_release_channel(void)
 {
     std::string frame_release_encoded = frame_release_channel_.recv();
     try {
+
+        // Processors may release frames with binary notifications regardless of the frame ready
+        // channel format
+        if (IpcFrameNotification::is_binary(frame_release_encoded))
+        {
+            IpcFrameNotification release_notification(frame_release_encoded);
+            if (release_notification.get_msg_val() == IpcMessage::MsgValNotifyFrameRelease)
+            {
+                handle_frame_release(release_notification.get_frame_number(), release_notification.get_buffer_id());
+            }
+            else
+            {
+                LOG4CXX_ERROR(logger_, "Got unexpected binary notification on frame release channel with value "
+                        << release_notification.get_msg_val());
+            }
+            return;
+        }
+
         IpcMessage frame_release(frame_release_encoded.c_str());
         //LOG4CXX_DEBUG(logger_, "Got message on frame release channel : " << frame_release_encoded);
 
         if ((frame_release.get_msg_type() == IpcMessage::MsgTypeNotify) &&
             (frame_release.get_msg_val() == IpcMessage::MsgValNotifyFrameRelease))
         {
-        	LOG4CXX_DEBUG_LEVEL(2, logger_, "Got frame release notification from processor from frame " << frame_release.get_param<int>("frame", -1)
-                    << " in buffer " << frame_release.get_param<int>("buffer_id", -1));
-            rx_channel_.send(frame_release_encoded);
-
-            frames_released_++;
-
-            if (config_.frame_count_ && (frames_released_ >= config_.frame_count_))
-            {
-                LOG4CXX_INFO(logger_, "Specified number of frames (" << config_.frame_count_ << ") received and released, terminating");
-                stop();
-                reactor_.stop();
-            }
+            handle_frame_release(frame_release.get_param<int>("frame", -1), frame_release.get_param<int>("buffer_id", -1));
         }
         else
         {
@@ -497,12 +888,148 @@ void FrameReceiverApp::handle_frame_release_channel(void)
     }
 }
 
+void FrameReceiverApp::handle_frame_release(int frame_number, int buffer_id)
+{
+    LOG4CXX_DEBUG_LEVEL(2, logger_, "Got frame release notification from processor from frame " << frame_number
+            << " in buffer " << buffer_id);
+    if ((buffer_id >= 0) && (static_cast<size_t>(buffer_id) < buffer_manager_->get_num_buffers()))
+    {
+        release_empty_buffer(buffer_id);
+    }
+    else if (buffer_id >= 0)
+    {
+        LOG4CXX_ERROR(logger_, "Got frame release notification from processor for frame " << frame_number
+                << " with invalid buffer ID " << buffer_id);
+    }
+    else
+    {
+        LOG4CXX_ERROR(logger_, "Got frame release notification from processor without a buffer ID");
+    }
+
+    frames_released_++;
+
+    if (config_.frame_count_ && (frames_released_ >= config_.frame_count_))
+    {
+        LOG4CXX_INFO(logger_, "Specified number of frames (" << config_.frame_count_ << ") received and released, terminating");
+        stop();
+        reactor_.stop();
+    }
+}
+
+void FrameReceiverApp::initialise_notification_rings(void)
+{
+    // The rings are laid out one after the other in the auxiliary region of the shared buffer
+    // segment, ready ring first. Each holds every buffer, so can never overflow.
+    size_t ring_size = NotificationRing::get_region_size(buffer_manager_->get_num_buffers());
+    uint8_t* ring_address = reinterpret_cast<uint8_t*>(buffer_manager_->get_aux_address());
+    if (!ring_address || (buffer_manager_->get_aux_size() < 2 * ring_size))
+    {
+        throw FrameReceiverException("Cannot initialise notification rings - shared buffer auxiliary region too small");
+    }
+
+    ready_ring_.reset(new NotificationRing(ring_address, buffer_manager_->get_num_buffers()));
+    release_ring_.reset(new NotificationRing(ring_address + ring_size, buffer_manager_->get_num_buffers()));
+
+    // The frame receiver is always the consumer of the release ring
+    release_ring_->attach_consumer();
+    release_ring_watcher_.reset(new NotificationRingWatcher(*release_ring_));
+
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "Initialised frame notification rings in shared buffer with "
+            << ready_ring_->capacity() << " entries");
+}
+
+//! Push a frame ready notification onto the ready ring.
+//!
+//! Notifications are only pushed while a processor is attached to the ready ring, in which case
+//! they are not also published on the frame ready channel. This keeps the ring from filling
+//! when only processors using the channel are running, and ensures each frame is released once.
+//!
+//! \param ready_notification - frame ready notification
+//! \return true if the notification was delivered through the ring
+
+bool FrameReceiverApp::push_ready_ring(const IpcFrameNotification& ready_notification)
+{
+    if (!ready_ring_ || !ready_ring_->has_consumer())
+    {
+        return false;
+    }
+
+    NotificationRing::Entry entry;
+    entry.frame_number        = static_cast<uint32_t>(ready_notification.get_frame_number());
+    entry.buffer_id           = ready_notification.get_buffer_id();
+    entry.frame_state         = static_cast<uint32_t>(ready_notification.get_frame_state());
+    entry.reserved            = 0;
+    entry.frame_start_time_ns = ready_notification.get_frame_start_time_ns();
+    entry.timestamp_ns        = ready_notification.get_msg_timestamp_ns();
+
+    if (!ready_ring_->push(entry))
+    {
+        LOG4CXX_ERROR(logger_, "Frame ready notification ring full, publishing notification for frame "
+                << entry.frame_number << " in buffer " << entry.buffer_id << " on frame ready channel");
+        return false;
+    }
+    return true;
+}
+
+void FrameReceiverApp::handle_release_ring(void)
+{
+    release_ring_watcher_->clear_notification();
+
+    NotificationRing::Entry entry;
+    while (release_ring_->pop(entry))
+    {
+        handle_frame_release(static_cast<int>(entry.frame_number), entry.buffer_id);
+    }
+}
+
 void FrameReceiverApp::rx_ping_timer_handler(void)
 {
 
     IpcMessage rxPing(IpcMessage::MsgTypeCmd, IpcMessage::MsgValCmdStatus);
-    rx_channel_.send(rxPing.encode());
+    for (unsigned int rx_thread = 0; rx_thread < rx_channels_.size(); rx_thread++)
+    {
+        rx_channels_[rx_thread]->send(rxPing.encode());
+    }
+
+}
+
+//! Release an empty buffer to the RX threads.
+//!
+//! Empty buffers are pushed onto the lock-free empty buffer queues of the RX threads in turn.
+//! Buffers released to any thread are available to all threads, as the frame decoders share a
+//! frame buffer table.
+//!
+//! \param buffer_id - ID of the empty buffer
 
+void FrameReceiverApp::release_empty_buffer(int buffer_id)
+{
+    if (!rx_threads_[next_rx_thread_]->push_empty_buffer(buffer_id))
+    {
+        LOG4CXX_ERROR(logger_, "Failed to release buffer " << buffer_id << " to RX thread " << next_rx_thread_
+                << ", empty buffer queue is full");
+    }
+    next_rx_thread_ = (next_rx_thread_ + 1) % rx_threads_.size();
+}
+
+//! Add the receiver status to the params block of a status reply.
+//!
+//! The statistics block of each RX thread is read directly, without pausing the thread, its
+//! counters being added with the prefix rx_thread_<index>/.
+//!
+//! \param status_reply - reply message to add the status to
+
+void FrameReceiverApp::add_status_params(IpcMessage& status_reply)
+{
+    status_reply.set_param("frames_received", frames_received_);
+    status_reply.set_param("frames_released", frames_released_);
+    status_reply.set_param("rx_threads", static_cast<unsigned int>(rx_threads_.size()));
+
+    for (unsigned int rx_thread = 0; rx_thread < rx_threads_.size(); rx_thread++)
+    {
+        std::stringstream prefix;
+        prefix << "rx_thread_" << rx_thread << "/";
+        rx_threads_[rx_thread]->get_stats().add_params(status_reply, prefix.str());
+    }
 }
 
 void FrameReceiverApp::timer_handler2(void)
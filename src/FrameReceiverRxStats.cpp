@@ -0,0 +1,112 @@
+/*!
+ * FrameReceiverRxStats.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameReceiverRxStats.h"
+
+#include <sstream>
+
+using namespace FrameReceiver;
+
+FrameReceiverRxStats::FrameReceiverRxStats() :
+        packets_received_(0),
+        bytes_received_(0),
+        receive_calls_(0),
+        frames_complete_(0),
+        frames_timedout_(0),
+        frames_released_(0),
+        frames_dropped_(0),
+        buffers_released_(0),
+        empty_buffers_(0),
+        mapped_buffers_(0)
+{
+}
+
+//! Add a receive port to the statistics.
+//!
+//! This method must be called before the RX thread starts counting, as the port counters are
+//! not reallocated once the counters are being read.
+//!
+//! \param port - port number
+//! \return slot of the port counters, to be passed to count_packets()
+
+unsigned int FrameReceiverRxStats::add_port(uint16_t port)
+{
+    PortCounters counters;
+    counters.port = port;
+    counters.packets_received = 0;
+    counters.bytes_received = 0;
+    ports_.push_back(counters);
+    return ports_.size() - 1;
+}
+
+//! Return the number of ports counted
+
+size_t FrameReceiverRxStats::get_num_ports(void) const
+{
+    return ports_.size();
+}
+
+//! Copy the current values of the counters.
+//!
+//! \param snapshot - snapshot to fill with the counter values
+
+void FrameReceiverRxStats::snapshot(Snapshot& snapshot) const
+{
+    snapshot.packets_received = load(packets_received_);
+    snapshot.bytes_received   = load(bytes_received_);
+    snapshot.receive_calls    = load(receive_calls_);
+    snapshot.frames_complete  = load(frames_complete_);
+    snapshot.frames_timedout  = load(frames_timedout_);
+    snapshot.frames_released  = load(frames_released_);
+    snapshot.frames_dropped   = load(frames_dropped_);
+    snapshot.buffers_released = load(buffers_released_);
+    snapshot.empty_buffers    = load(empty_buffers_);
+    snapshot.mapped_buffers   = load(mapped_buffers_);
+
+    snapshot.ports.resize(ports_.size());
+    for (size_t slot = 0; slot < ports_.size(); slot++)
+    {
+        snapshot.ports[slot].port             = ports_[slot].port;
+        snapshot.ports[slot].packets_received = load(ports_[slot].packets_received);
+        snapshot.ports[slot].bytes_received   = load(ports_[slot].bytes_received);
+    }
+}
+
+//! Add the current values of the counters to the params block of a message.
+//!
+//! Each counter is added as a parameter named by the prefix followed by the counter name, port
+//! counters being named port_<number>/<counter>. The receive system calls made per packet
+//! received are added as syscalls_per_packet.
+//!
+//! \param msg - message to add parameters to
+//! \param prefix - prefix of the parameter names, e.g. "rx_thread_0/"
+
+void FrameReceiverRxStats::add_params(IpcMessage& msg, const std::string& prefix) const
+{
+    Snapshot stats;
+    snapshot(stats);
+
+    msg.set_param(prefix + "packets_received", stats.packets_received);
+    msg.set_param(prefix + "bytes_received",   stats.bytes_received);
+    msg.set_param(prefix + "receive_calls",    stats.receive_calls);
+    msg.set_param(prefix + "syscalls_per_packet",
+            stats.packets_received ? ((double)stats.receive_calls / stats.packets_received) : 0.0);
+    msg.set_param(prefix + "frames_complete",  stats.frames_complete);
+    msg.set_param(prefix + "frames_timedout",  stats.frames_timedout);
+    msg.set_param(prefix + "frames_released",  stats.frames_released);
+    msg.set_param(prefix + "frames_dropped",   stats.frames_dropped);
+    msg.set_param(prefix + "buffers_released", stats.buffers_released);
+    msg.set_param(prefix + "empty_buffers",    stats.empty_buffers);
+    msg.set_param(prefix + "mapped_buffers",   stats.mapped_buffers);
+
+    for (std::vector<PortCounters>::const_iterator port_itr = stats.ports.begin(); port_itr != stats.ports.end(); ++port_itr)
+    {
+        std::stringstream port_prefix;
+        port_prefix << prefix << "port_" << port_itr->port << "/";
+        msg.set_param(port_prefix.str() + "packets_received", port_itr->packets_received);
+        msg.set_param(port_prefix.str() + "bytes_received",   port_itr->bytes_received);
+    }
+}
@@ -6,19 +6,30 @@
  */
 
 #include "FrameReceiverRxThread.h"
+#include "ThreadPlacement.h"
+#include "IpcFrameNotification.h"
+#include "gettime.h"
 #include <unistd.h>
 
 using namespace FrameReceiver;
 
 FrameReceiverRxThread::FrameReceiverRxThread(FrameReceiverConfig& config, LoggerPtr& logger,
-        SharedBufferManagerPtr buffer_manager, FrameDecoderPtr frame_decoder, unsigned int tick_period_ms) :
+        SharedBufferManagerPtr buffer_manager, FrameDecoderPtr frame_decoder, unsigned int tick_period_ms,
+        unsigned int thread_index) :
    config_(config),
    logger_(logger),
    buffer_manager_(buffer_manager),
    frame_decoder_(frame_decoder),
    tick_period_ms_(tick_period_ms),
+   thread_index_(thread_index),
+   rx_channel_endpoint_(config.get_rx_channel_endpoint(thread_index)),
    rx_channel_(ZMQ_PAIR),
+   binary_notifications_(false),
    recv_socket_(0),
+   empty_buffer_queue_(buffer_manager->get_num_buffers()),
+   rx_batch_size_(config.rx_batch_size_),
+   batch_receive_calls_(0),
+   batch_packets_received_(0),
    run_thread_(true),
    thread_running_(false),
    thread_init_error_(false),
@@ -49,15 +60,45 @@ FrameReceiverRxThread::~FrameReceiverRxThread()
 
 void FrameReceiverRxThread::run_service(void)
 {
-    LOG4CXX_DEBUG_LEVEL(1, logger_, "Running RX thread service");
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "Running RX thread " << thread_index_ << " service");
+
+    // Pin the thread to a CPU and set real-time scheduling if requested. Failures are not fatal,
+    // as the thread can still receive data, albeit with a greater risk of packet loss
+    if (!config_.rx_cpus_.empty())
+    {
+        int rx_cpu = config_.rx_cpus_[thread_index_ % config_.rx_cpus_.size()];
+        int rc = set_thread_affinity(rx_cpu);
+        if (rc != 0)
+        {
+            LOG4CXX_WARN(logger_, "RX thread " << thread_index_ << " failed to pin to CPU " << rx_cpu << ": " << strerror(rc));
+        }
+        else
+        {
+            LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread " << thread_index_ << " pinned to CPU " << rx_cpu);
+        }
+    }
+
+    if (config_.rx_priority_ > 0)
+    {
+        int rc = set_thread_realtime_priority(config_.rx_priority_);
+        if (rc != 0)
+        {
+            LOG4CXX_WARN(logger_, "RX thread " << thread_index_ << " failed to set real-time priority "
+                    << config_.rx_priority_ << ": " << strerror(rc));
+        }
+        else
+        {
+            LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread " << thread_index_ << " running with real-time priority " << config_.rx_priority_);
+        }
+    }
 
     // Connect the message channel to the main thread
     try {
-        rx_channel_.connect(config_.rx_channel_endpoint_);
+        rx_channel_.connect(rx_channel_endpoint_);
     }
     catch (zmq::error_t& e) {
         std::stringstream ss;
-        ss << "RX channel connect to endpoint " << config_.rx_channel_endpoint_ << " failed: " << e.what();
+        ss << "RX channel connect to endpoint " << rx_channel_endpoint_ << " failed: " << e.what();
         thread_init_msg_ = ss.str();
         thread_init_error_ = true;
         return;
@@ -66,10 +107,37 @@ void FrameReceiverRxThread::run_service(void)
     // Add the RX channel to the reactor
     reactor_.register_channel(rx_channel_, boost::bind(&FrameReceiverRxThread::handle_rx_channel, this));
 
-    for (std::vector<uint16_t>::iterator rx_port_itr = config_.rx_ports_.begin(); rx_port_itr != config_.rx_ports_.end(); rx_port_itr++)
+    // Add the empty buffer queue notification descriptor to the reactor
+    reactor_.register_socket(empty_buffer_queue_.get_notify_fd(), boost::bind(&FrameReceiverRxThread::handle_empty_buffer_queue, this));
+
+    // Set up the staging areas for batched receive if enabled
+    initialise_batch_receive();
+
+    // Open the packet capture file if enabled
+    std::string capture_file = config_.get_rx_capture_file(thread_index_);
+    if (!capture_file.empty())
     {
+        try {
+            capture_writer_.reset(new PacketCaptureWriter(capture_file, config_.rx_address_));
+            LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread " << thread_index_ << " capturing received datagrams to " << capture_file);
+        }
+        catch (PacketCaptureException& e) {
+            thread_init_msg_ = e.what();
+            thread_init_error_ = true;
+            return;
+        }
+    }
 
-        uint16_t rx_port = *rx_port_itr;
+    for (unsigned int port_index = 0; port_index < config_.rx_ports_.size(); port_index++)
+    {
+
+        // Skip ports handled by other RX threads
+        if (!handles_port(port_index))
+        {
+            continue;
+        }
+
+        uint16_t rx_port = config_.rx_ports_[port_index];
 
         // Create the receive socket
         int recv_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
@@ -98,6 +166,21 @@ void FrameReceiverRxThread::run_service(void)
         getsockopt(recv_socket, SOL_SOCKET, SO_RCVBUF, &buffer_size, &len);
         LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread receive buffer size for port " << rx_port << " is " << buffer_size);
 
+        // If enabled, allow the port to be shared with the sockets of other RX threads, in which case
+        // the kernel distributes incoming datagrams between them by source address and port
+        if (config_.rx_reuse_port_)
+        {
+            int reuse_port = 1;
+            if (setsockopt(recv_socket, SOL_SOCKET, SO_REUSEPORT, &reuse_port, sizeof(reuse_port)) < 0)
+            {
+                std::stringstream ss;
+                ss << "RX channel failed to enable port reuse on receive socket for port " << rx_port << " : " << strerror(errno);
+                thread_init_msg_ = ss.str();
+                thread_init_error_ = true;
+                return;
+            }
+        }
+
         // Bind the socket to the specified port
         struct sockaddr_in recv_addr;
         memset(&recv_addr, 0, sizeof(recv_addr));
@@ -126,8 +209,18 @@ void FrameReceiverRxThread::run_service(void)
 
         if (thread_init_error_) break;
 
-        // Add the receive socket to the reactor
-        reactor_.register_socket(recv_socket, boost::bind(&FrameReceiverRxThread::handle_receive_socket, this, recv_socket, (int)rx_port));
+        // Add the receive socket to the reactor, using the batched receive handler if enabled
+        unsigned int port_slot = stats_.add_port(rx_port);
+        if (rx_batch_size_ > 1)
+        {
+            reactor_.register_socket(recv_socket, boost::bind(&FrameReceiverRxThread::handle_receive_socket_batch, this,
+                    recv_socket, (int)rx_port, port_slot));
+        }
+        else
+        {
+            reactor_.register_socket(recv_socket, boost::bind(&FrameReceiverRxThread::handle_receive_socket, this,
+                    recv_socket, (int)rx_port, port_slot));
+        }
 
         recv_sockets_.push_back(recv_socket);
     }
@@ -138,6 +231,15 @@ void FrameReceiverRxThread::run_service(void)
     // Add the buffer monitor timer to the reactor
     int buffer_monitor_timer_id = reactor_.register_timer(3000, 0, boost::bind(&FrameReceiverRxThread::buffer_monitor_timer, this));
 
+    // Add the frame timeout timer to the reactor, checking for timed out frames at a short interval.
+    // Frames are otherwise only timed out by the buffer monitor timer.
+    int frame_timeout_timer_id = -1;
+    if (config_.frame_timeout_check_ms_ > 0)
+    {
+        frame_timeout_timer_id = reactor_.register_timer(config_.frame_timeout_check_ms_, 0,
+                boost::bind(&FrameReceiverRxThread::frame_timeout_timer, this));
+    }
+
     // Register the frame release callback with the decoder
     frame_decoder_->register_frame_ready_callback(boost::bind(&FrameReceiverRxThread::frame_ready, this, _1, _2));
 
@@ -149,8 +251,13 @@ void FrameReceiverRxThread::run_service(void)
 
     // Cleanup - remove channels, sockets and timers from the reactor and close the receive socket
     reactor_.remove_channel(rx_channel_);
+    reactor_.remove_socket(empty_buffer_queue_.get_notify_fd());
     reactor_.remove_timer(tick_timer_id);
     reactor_.remove_timer(buffer_monitor_timer_id);
+    if (frame_timeout_timer_id >= 0)
+    {
+        reactor_.remove_timer(frame_timeout_timer_id);
+    }
 
     for (std::vector<int>::iterator recv_sock_it = recv_sockets_.begin(); recv_sock_it != recv_sockets_.end(); recv_sock_it++)
     {
@@ -159,6 +266,8 @@ void FrameReceiverRxThread::run_service(void)
     }
     recv_sockets_.clear();
 
+    stop_capture();
+
     LOG4CXX_DEBUG_LEVEL(1, logger_, "Terminating RX thread service");
 
 }
@@ -171,6 +280,27 @@ void FrameReceiverRxThread::handle_rx_channel(void)
     // Parse and handle the message
     try {
 
+        // Binary frame release notifications carry only a buffer ID and bypass JSON parsing
+        if (IpcFrameNotification::is_binary(rx_msg_encoded))
+        {
+            IpcFrameNotification release_notification(rx_msg_encoded);
+            if ((release_notification.get_msg_val() == IpcMessage::MsgValNotifyFrameRelease) &&
+                (release_notification.get_buffer_id() >= 0))
+            {
+                if (!frame_decoder_->push_empty_buffer(release_notification.get_buffer_id()))
+                {
+                    LOG4CXX_ERROR(logger_, "RX thread got frame release notification with invalid buffer ID "
+                            << release_notification.get_buffer_id());
+                }
+            }
+            else
+            {
+                LOG4CXX_ERROR(logger_, "RX thread got unexpected binary notification with value "
+                        << release_notification.get_msg_val());
+            }
+            return;
+        }
+
         IpcMessage rx_msg(rx_msg_encoded.c_str());
 
 		if ((rx_msg.get_msg_type() == IpcMessage::MsgTypeNotify) &&
@@ -181,9 +311,15 @@ void FrameReceiverRxThread::handle_rx_channel(void)
 
 			if (buffer_id != -1)
 			{
-				frame_decoder_->push_empty_buffer(buffer_id);
-				LOG4CXX_DEBUG_LEVEL(3, logger_, "Added empty buffer ID " << buffer_id << " to queue, length is now "
-						<< frame_decoder_->get_num_empty_buffers());
+				if (frame_decoder_->push_empty_buffer(buffer_id))
+				{
+					LOG4CXX_DEBUG_LEVEL(3, logger_, "Added empty buffer ID " << buffer_id << " to queue, length is now "
+							<< frame_decoder_->get_num_empty_buffers());
+				}
+				else
+				{
+					LOG4CXX_ERROR(logger_, "RX thread received empty frame notification with invalid buffer ID " << buffer_id);
+				}
 			}
 			else
 			{
@@ -199,9 +335,35 @@ void FrameReceiverRxThread::handle_rx_channel(void)
 			rx_reply.set_msg_type(IpcMessage::MsgTypeAck);
 			rx_reply.set_msg_val(IpcMessage::MsgValCmdStatus);
 			rx_reply.set_param("count", rx_msg.get_param<int>("count", -1));
+			stats_.add_params(rx_reply, "");
 
 		    rx_channel_.send(rx_reply.encode());
 		}
+		else if ((rx_msg.get_msg_type() == IpcMessage::MsgTypeCmd) &&
+				(rx_msg.get_msg_val()  == IpcMessage::MsgValCmdConfigure))
+		{
+			// Select the format of frame ready notifications sent to the main thread
+			std::string format_name = rx_msg.get_param<std::string>("notification_format", "json");
+			Defaults::NotificationFormat format = config_.map_notify_format_name(format_name);
+
+			IpcMessage rx_reply;
+			rx_reply.set_msg_val(IpcMessage::MsgValCmdConfigure);
+
+			if (format != Defaults::NotificationFormatIllegal)
+			{
+				binary_notifications_ = (format == Defaults::NotificationFormatBinary);
+				LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread " << thread_index_ << " sending " << format_name << " frame notifications");
+				rx_reply.set_msg_type(IpcMessage::MsgTypeAck);
+				rx_reply.set_param("notification_format", format_name);
+			}
+			else
+			{
+				LOG4CXX_ERROR(logger_, "RX thread got illegal notification format: " << format_name);
+				rx_reply.set_msg_type(IpcMessage::MsgTypeNack);
+			}
+
+			rx_channel_.send(rx_reply.encode());
+		}
 		else
 		{
 			LOG4CXX_ERROR(logger_, "RX thread got unexpected message: " << rx_msg_encoded);
@@ -222,16 +384,44 @@ void FrameReceiverRxThread::handle_rx_channel(void)
 
 }
 
-void FrameReceiverRxThread::handle_receive_socket(int recv_socket, int recv_port)
+void FrameReceiverRxThread::handle_empty_buffer_queue(void)
 {
+    // Clear the notification before draining the queue so that no buffer pushed meanwhile is missed
+    empty_buffer_queue_.clear_notification();
+
+    int buffer_id;
+    int buffers_pushed = 0;
+    while (empty_buffer_queue_.pop(buffer_id))
+    {
+        if (!frame_decoder_->push_empty_buffer(buffer_id))
+        {
+            LOG4CXX_ERROR(logger_, "Ignoring invalid buffer ID " << buffer_id << " on release queue");
+            continue;
+        }
+        buffers_pushed++;
+    }
+    stats_.count_buffers_released(buffers_pushed);
+    LOG4CXX_DEBUG_LEVEL(3, logger_, "Added " << buffers_pushed << " empty buffers to queue from release queue");
+}
 
-	if (frame_decoder_->requires_header_peek())
+void FrameReceiverRxThread::handle_receive_socket(int recv_socket, int recv_port, unsigned int port_slot)
+{
+
+	bool header_peek = frame_decoder_->requires_header_peek();
+	struct sockaddr_in from_addr;
+
+	if (header_peek)
 	{
 		size_t header_size = frame_decoder_->get_packet_header_size();
 		void*  header_buffer = frame_decoder_->get_packet_header_buffer();
-		struct sockaddr_in from_addr;
 		socklen_t from_len = sizeof(from_addr);
 		size_t bytes_received = recvfrom(recv_socket, header_buffer, header_size, MSG_PEEK, (struct sockaddr*)&from_addr, &from_len);
+		stats_.count_receive_calls(1);
+		if (bytes_received == (size_t)-1)
+		{
+			log_receive_error(recv_port);
+			return;
+		}
 		LOG4CXX_DEBUG_LEVEL(3, logger_, "RX thread received " << bytes_received << " header bytes on recv socket");
 		frame_decoder_->process_packet_header(bytes_received, recv_port, &from_addr);
 	}
@@ -244,17 +434,192 @@ void FrameReceiverRxThread::handle_receive_socket(int recv_socket, int recv_port
 
 	struct msghdr msg_hdr;
 	memset((void*)&msg_hdr,  0, sizeof(struct msghdr));
-	msg_hdr.msg_name = 0;
-	msg_hdr.msg_namelen = 0;
+	if (header_peek)
+	{
+		msg_hdr.msg_name = 0;
+		msg_hdr.msg_namelen = 0;
+	}
+	else
+	{
+		msg_hdr.msg_name = &from_addr;
+		msg_hdr.msg_namelen = sizeof(from_addr);
+	}
 	msg_hdr.msg_iov = io_vec;
 	msg_hdr.msg_iovlen = 2;
 
 	size_t bytes_received = recvmsg(recv_socket, &msg_hdr, 0);
+	stats_.count_receive_calls(1);
+
+	// A failed receive leaves the previous datagram in the header buffer, which must not be decoded
+	// again
+	if (bytes_received == (size_t)-1)
+	{
+		log_receive_error(recv_port);
+		return;
+	}
 	LOG4CXX_DEBUG_LEVEL(3, logger_, "RX thread received " << bytes_received << " header/payload bytes on recv socket");
+	stats_.count_packets(port_slot, 1, bytes_received);
+
+	// Capture the datagram before decoding, as the decoder may move the payload
+	if (capture_writer_)
+	{
+		capture_datagram(&from_addr, recv_port, io_vec[0].iov_base, io_vec[1].iov_base, bytes_received);
+	}
+
+	// In decode-after-receive mode the header is decoded once the whole datagram has been received
+	if (!header_peek)
+	{
+		frame_decoder_->process_packet_header(bytes_received, recv_port, &from_addr);
+	}
 
 	FrameDecoder::FrameReceiveState frame_receive_state = frame_decoder_->process_packet(bytes_received);
 }
 
+void FrameReceiverRxThread::log_receive_error(int recv_port)
+{
+    // A receive that would block, e.g. after a spurious wakeup, or is interrupted is not an error
+    if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+    {
+        LOG4CXX_ERROR(logger_, "RX thread receive failed on port " << recv_port << " : " << strerror(errno));
+    }
+}
+
+void FrameReceiverRxThread::initialise_batch_receive(void)
+{
+#ifdef __MACH__
+    // recvmmsg is not available on OS X, so fall back to single datagram receive
+    if (rx_batch_size_ > 1)
+    {
+        LOG4CXX_WARN(logger_, "Batched receive is not supported on this platform, receiving one datagram per wakeup");
+        rx_batch_size_ = 1;
+    }
+#endif
+
+    if (rx_batch_size_ <= 1)
+    {
+        return;
+    }
+
+    size_t header_size  = frame_decoder_->get_packet_header_size();
+    size_t payload_size = frame_decoder_->get_max_payload_size();
+
+    // Allocate a header and payload staging slot for each datagram in the batch. Payloads are
+    // received into staging since the frame buffer destination of each datagram is not known
+    // until its header has been decoded.
+    batch_msgs_.resize(rx_batch_size_);
+    batch_iovecs_.resize(rx_batch_size_ * 2);
+    batch_from_addrs_.resize(rx_batch_size_);
+    batch_datagrams_.resize(rx_batch_size_);
+    batch_headers_.resize(rx_batch_size_ * header_size);
+    batch_payloads_.resize(rx_batch_size_ * payload_size);
+
+    memset(&batch_msgs_[0], 0, sizeof(struct mmsghdr) * rx_batch_size_);
+
+    for (unsigned int msg = 0; msg < rx_batch_size_; msg++)
+    {
+        batch_iovecs_[msg*2].iov_base   = &batch_headers_[msg * header_size];
+        batch_iovecs_[msg*2].iov_len    = header_size;
+        batch_iovecs_[msg*2+1].iov_base = &batch_payloads_[msg * payload_size];
+        batch_iovecs_[msg*2+1].iov_len  = payload_size;
+
+        batch_msgs_[msg].msg_hdr.msg_iov     = &batch_iovecs_[msg*2];
+        batch_msgs_[msg].msg_hdr.msg_iovlen  = 2;
+        batch_msgs_[msg].msg_hdr.msg_name    = &batch_from_addrs_[msg];
+
+        batch_datagrams_[msg].header    = batch_iovecs_[msg*2].iov_base;
+        batch_datagrams_[msg].payload   = batch_iovecs_[msg*2+1].iov_base;
+        batch_datagrams_[msg].from_addr = &batch_from_addrs_[msg];
+    }
+
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread batched receive enabled with up to " << rx_batch_size_
+            << " datagrams per wakeup");
+}
+
+void FrameReceiverRxThread::handle_receive_socket_batch(int recv_socket, int recv_port, unsigned int port_slot)
+{
+#ifndef __MACH__
+    // Reset the source address lengths, which are overwritten on each receive
+    for (unsigned int msg = 0; msg < rx_batch_size_; msg++)
+    {
+        batch_msgs_[msg].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+
+    // Drain up to a full batch of datagrams from the socket without blocking
+    int num_msgs = recvmmsg(recv_socket, &batch_msgs_[0], rx_batch_size_, MSG_DONTWAIT, NULL);
+    stats_.count_receive_calls(1);
+    if (num_msgs <= 0)
+    {
+        if ((num_msgs < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            LOG4CXX_ERROR(logger_, "RX thread batched receive failed on port " << recv_port << " : " << strerror(errno));
+        }
+        return;
+    }
+
+    batch_receive_calls_++;
+    batch_packets_received_ += num_msgs;
+    LOG4CXX_DEBUG_LEVEL(3, logger_, "RX thread received batch of " << num_msgs << " datagrams on recv socket");
+
+    // Hand the whole batch to the decoder in one call, the datagram descriptors pointing at the
+    // staging slots of each datagram
+    uint64_t batch_bytes = 0;
+    for (int msg = 0; msg < num_msgs; msg++)
+    {
+        batch_datagrams_[msg].bytes_received = batch_msgs_[msg].msg_len;
+        batch_datagrams_[msg].port = recv_port;
+        batch_bytes += batch_msgs_[msg].msg_len;
+        if (capture_writer_)
+        {
+            capture_datagram(batch_datagrams_[msg].from_addr, recv_port, batch_datagrams_[msg].header,
+                    batch_datagrams_[msg].payload, batch_datagrams_[msg].bytes_received);
+        }
+    }
+    stats_.count_packets(port_slot, num_msgs, batch_bytes);
+    frame_decoder_->process_packets(&batch_datagrams_[0], num_msgs);
+#endif
+}
+
+void FrameReceiverRxThread::capture_datagram(struct sockaddr_in* from_addr, int recv_port, const void* header,
+        const void* payload, size_t bytes_received)
+{
+    // The datagram is split between the header and payload buffers it was received into. Payloads
+    // discarded by the decoder with a truncated receive are captured truncated.
+    size_t header_size = frame_decoder_->get_packet_header_size();
+    size_t header_bytes = (bytes_received < header_size) ? bytes_received : header_size;
+
+    struct timespec timestamp;
+    gettime(&timestamp);
+
+    try {
+        capture_writer_->write(timestamp, from_addr, recv_port, header, header_bytes, payload, bytes_received - header_bytes);
+    }
+    catch (PacketCaptureException& e) {
+        LOG4CXX_ERROR(logger_, "RX thread " << thread_index_ << " stopping packet capture: " << e.what());
+        stop_capture();
+    }
+}
+
+void FrameReceiverRxThread::stop_capture(void)
+{
+    if (capture_writer_)
+    {
+        LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread " << thread_index_ << " captured " << capture_writer_->get_num_packets()
+                << " datagrams to " << capture_writer_->get_file_name());
+        capture_writer_.reset();
+    }
+}
+
+bool FrameReceiverRxThread::handles_port(unsigned int port_index) const
+{
+    // With port reuse enabled every RX thread receives on all ports, otherwise the ports are
+    // distributed between the RX threads in turn
+    if (config_.rx_reuse_port_ || (config_.rx_threads_ <= 1))
+    {
+        return true;
+    }
+    return ((port_index % config_.rx_threads_) == thread_index_);
+}
+
 void FrameReceiverRxThread::tick_timer(void)
 {
 	//LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread tick timer fired");
@@ -263,17 +628,82 @@ void FrameReceiverRxThread::tick_timer(void)
 		LOG4CXX_DEBUG_LEVEL(1, logger_, "RX thread terminate detected in timer");
 		reactor_.stop();
 	}
+	update_decoder_stats();
+}
+
+void FrameReceiverRxThread::frame_timeout_timer(void)
+{
+    frame_decoder_->check_frame_timeouts();
 }
 
 void FrameReceiverRxThread::buffer_monitor_timer(void)
 {
     frame_decoder_->monitor_buffers();
+
+    if (batch_receive_calls_)
+    {
+        LOG4CXX_DEBUG_LEVEL(2, logger_, "RX thread received " << batch_packets_received_ << " datagrams in "
+                << batch_receive_calls_ << " batched receive calls, average batch depth "
+                << ((double)batch_packets_received_ / batch_receive_calls_));
+    }
+
+    // Flush the packet capture regularly, so that little is lost should the receiver be killed
+    if (capture_writer_)
+    {
+        capture_writer_->flush();
+    }
+}
+
+//! Publish the frame decoder state to the statistics block.
+//!
+//! The dropped frame count and buffer queue depths are held by the decoder, so are copied into
+//! the statistics block at the tick period rather than on each packet, which would take the
+//! frame buffer table lock on the receive path.
+
+void FrameReceiverRxThread::update_decoder_stats(void)
+{
+    stats_.update_decoder_state(frame_decoder_->get_num_dropped_frames(),
+            frame_decoder_->get_num_empty_buffers(), frame_decoder_->get_num_mapped_buffers());
+}
+
+//! Return the statistics block of the thread, which may be read from any thread
+
+const FrameReceiverRxStats& FrameReceiverRxThread::get_stats(void) const
+{
+    return stats_;
+}
+
+bool FrameReceiverRxThread::push_empty_buffer(int buffer_id)
+{
+    // Called from the main thread, which is the only producer for the queue
+    return empty_buffer_queue_.push(buffer_id);
 }
 
 void FrameReceiverRxThread::frame_ready(int buffer_id, int frame_number)
 {
     LOG4CXX_DEBUG_LEVEL(2, logger_, "Releasing frame " << frame_number << " in buffer " << buffer_id);
 
+    FrameDecoder::FrameReceiveState frame_state = FrameDecoder::FrameReceiveStateEmpty;
+    struct timespec frame_start_time;
+    bool frame_status_valid = frame_decoder_->get_frame_status(buffer_id, frame_state, frame_start_time);
+    stats_.count_frame_released(frame_state == FrameDecoder::FrameReceiveStateComplete,
+            frame_state == FrameDecoder::FrameReceiveStateTimedout);
+
+    if (binary_notifications_)
+    {
+        uint64_t frame_start_time_ns = 0;
+        if (frame_status_valid)
+        {
+            frame_start_time_ns = IpcFrameNotification::timespec_to_ns(frame_start_time);
+        }
+
+        IpcFrameNotification ready_notification(IpcMessage::MsgValNotifyFrameReady, frame_number, buffer_id,
+                frame_state, frame_start_time_ns);
+        std::string ready_encoded = ready_notification.encode();
+        rx_channel_.send(ready_encoded);
+        return;
+    }
+
     IpcMessage ready_msg(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyFrameReady);
     ready_msg.set_param("frame", frame_number);
     ready_msg.set_param("buffer_id", buffer_id);
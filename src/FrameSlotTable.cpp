@@ -0,0 +1,157 @@
+/*!
+ * FrameSlotTable.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameSlotTable.h"
+
+using namespace FrameReceiver;
+
+FrameSlotTable::FrameSlotTable(size_t min_entries) :
+        slot_mask_(0),
+        num_entries_(0),
+        num_collisions_(0)
+{
+    reserve(min_entries);
+}
+
+//! Reserve capacity in the table.
+//!
+//! This method ensures the table has capacity for the specified number of entries while keeping
+//! the load factor at or below one half, so that probe sequences remain short. Existing entries
+//! are rehashed into the new slots if the capacity changes.
+//!
+//! \param num_entries - number of entries to reserve capacity for
+
+void FrameSlotTable::reserve(size_t num_entries)
+{
+    size_t capacity = 2;
+    while (capacity < (num_entries * 2))
+    {
+        capacity <<= 1;
+    }
+
+    if (capacity <= slots_.size())
+    {
+        return;
+    }
+
+    std::vector<std::pair<uint32_t, int> > entries;
+    get_entries(entries);
+
+    Slot empty_slot = {0, -1};
+    slots_.assign(capacity, empty_slot);
+    slot_mask_ = capacity - 1;
+    num_entries_ = 0;
+
+    for (std::vector<std::pair<uint32_t, int> >::iterator entry = entries.begin(); entry != entries.end(); entry++)
+    {
+        insert(entry->first, entry->second);
+    }
+}
+
+//! Insert a frame number to buffer ID mapping into the table.
+//!
+//! \param frame_number - frame number
+//! \param buffer_id - buffer ID, must not be negative
+//! \return true if inserted, false if the frame is already mapped or the table is full
+
+bool FrameSlotTable::insert(uint32_t frame_number, int buffer_id)
+{
+    if ((buffer_id < 0) || (num_entries_ >= slots_.size() - 1))
+    {
+        return false;
+    }
+
+    size_t slot = frame_number & slot_mask_;
+    if (slots_[slot].buffer_id >= 0)
+    {
+        num_collisions_++;
+    }
+
+    while (slots_[slot].buffer_id >= 0)
+    {
+        if (slots_[slot].frame_number == frame_number)
+        {
+            return false;
+        }
+        slot = (slot + 1) & slot_mask_;
+    }
+
+    slots_[slot].frame_number = frame_number;
+    slots_[slot].buffer_id = buffer_id;
+    num_entries_++;
+
+    return true;
+}
+
+//! Erase a frame number from the table.
+//!
+//! Entries following the erased slot in the same probe run are shifted back so that every entry
+//! remains reachable from its home slot without the need for deleted-slot markers.
+//!
+//! \param frame_number - frame number
+//! \return true if the frame was mapped and has been erased
+
+bool FrameSlotTable::erase(uint32_t frame_number)
+{
+    size_t slot = frame_number & slot_mask_;
+    while (slots_[slot].frame_number != frame_number)
+    {
+        if (slots_[slot].buffer_id < 0)
+        {
+            return false;
+        }
+        slot = (slot + 1) & slot_mask_;
+    }
+    if (slots_[slot].buffer_id < 0)
+    {
+        return false;
+    }
+
+    size_t hole = slot;
+    size_t next = (hole + 1) & slot_mask_;
+    while (slots_[next].buffer_id >= 0)
+    {
+        // An entry can fill the hole if its home slot does not lie cyclically in (hole, next]
+        size_t home = slots_[next].frame_number & slot_mask_;
+        if (((next - home) & slot_mask_) >= ((next - hole) & slot_mask_))
+        {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+        next = (next + 1) & slot_mask_;
+    }
+    slots_[hole].buffer_id = -1;
+    num_entries_--;
+
+    return true;
+}
+
+//! Remove all entries from the table
+
+void FrameSlotTable::clear(void)
+{
+    for (size_t slot = 0; slot < slots_.size(); slot++)
+    {
+        slots_[slot].buffer_id = -1;
+    }
+    num_entries_ = 0;
+}
+
+//! Retrieve all entries in the table, in slot order.
+//!
+//! \param entries - vector to fill with frame number and buffer ID pairs
+
+void FrameSlotTable::get_entries(std::vector<std::pair<uint32_t, int> >& entries) const
+{
+    entries.clear();
+    for (size_t slot = 0; slot < slots_.size(); slot++)
+    {
+        if (slots_[slot].buffer_id >= 0)
+        {
+            entries.push_back(std::make_pair(slots_[slot].frame_number, static_cast<int>(slots_[slot].buffer_id)));
+        }
+    }
+}
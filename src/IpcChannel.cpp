@@ -6,6 +6,7 @@ q * IpcChannel.cpp
  */
 
 #include "IpcChannel.h"
+#include "IpcReactor.h"
 
 using namespace FrameReceiver;
 
@@ -69,6 +70,7 @@ void IpcChannel::send(std::string& message_str)
     zmq::message_t msg(msg_size);
     memcpy(msg.data(), message_str.data(), msg_size);
     socket_.send(msg);
+    notify_reactor();
 }
 
 void IpcChannel::send(const char* message)
@@ -77,7 +79,7 @@ void IpcChannel::send(const char* message)
     zmq::message_t msg(msg_size);
     memcpy(msg.data(), message, msg_size);
     socket_.send(msg);
-
+    notify_reactor();
 }
 
 const std::string IpcChannel::recv(void)
@@ -87,6 +89,7 @@ const std::string IpcChannel::recv(void)
 
     socket_.recv(&msg);
     msg_size = msg.size();
+    notify_reactor();
 
     return std::string(reinterpret_cast<char*>(msg.data()), msg_size-1);
 }
@@ -96,6 +99,7 @@ bool IpcChannel::poll(long timeout_ms)
     zmq::pollitem_t pollitems[] = {{socket_, 0, ZMQ_POLLIN, 0}};
 
     zmq::poll(pollitems, 1, timeout_ms);
+    notify_reactor();
 
     return (pollitems[0].revents & ZMQ_POLLIN);
 
@@ -106,3 +110,15 @@ void IpcChannel::close(void)
     socket_.close();
 }
 
+// Sending, receiving or polling on a ZMQ socket can consume the state change signalled on its
+// notification descriptor, so a reactor the channel is registered with must check its event
+// state for pending messages
+
+void IpcChannel::notify_reactor(void)
+{
+    if (reactor_handler_ && reactor_handler_->reactor)
+    {
+        reactor_handler_->reactor->mark_pending(reactor_handler_.get());
+    }
+}
+
@@ -0,0 +1,152 @@
+/*!
+ * IpcFrameNotification.cpp - Frame Receiver binary frame notification message format class
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "IpcFrameNotification.h"
+#include "gettime.h"
+
+#include <cstring>
+#include <sstream>
+
+#include <boost/static_assert.hpp>
+
+// The encoded layout is copied directly to and from the message, so is only valid on
+// little-endian hosts
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "IpcFrameNotification requires a little-endian host"
+#endif
+
+using namespace FrameReceiver;
+
+//! Constructor - creates a binary notification message from its fields.
+//!
+//! The message timestamp is set to the current time.
+//!
+//! \param msg_val - message value, i.e. frame ready or frame release
+//! \param frame_number - frame number
+//! \param buffer_id - ID of the frame buffer
+//! \param frame_state - frame receive state
+//! \param frame_start_time_ns - time the first packet of the frame was received, in ns since the epoch
+
+IpcFrameNotification::IpcFrameNotification(IpcMessage::MsgVal msg_val, int frame_number, int buffer_id,
+        int frame_state, uint64_t frame_start_time_ns) :
+        msg_type_(IpcMessage::MsgTypeNotify),
+        msg_val_(msg_val),
+        frame_number_(frame_number),
+        buffer_id_(buffer_id),
+        frame_state_(frame_state),
+        frame_start_time_ns_(frame_start_time_ns),
+        msg_timestamp_ns_(0)
+{
+    struct timespec now;
+    gettime(&now);
+    msg_timestamp_ns_ = timespec_to_ns(now);
+}
+
+//! Constructor - decodes a binary notification message.
+//!
+//! An IpcMessageException is thrown if the message is not a valid binary notification.
+//!
+//! \param encoded - encoded binary message
+
+IpcFrameNotification::IpcFrameNotification(const std::string& encoded)
+{
+    BOOST_STATIC_ASSERT(sizeof(Layout) == encoded_size);
+
+    if (!is_binary(encoded))
+    {
+        throw IpcMessageException("Not a binary frame notification message");
+    }
+    if (encoded.size() < encoded_size)
+    {
+        std::stringstream ss;
+        ss << "Binary frame notification message too short: " << encoded.size() << " bytes";
+        throw IpcMessageException(ss.str());
+    }
+
+    Layout layout;
+    memcpy(&layout, encoded.data(), sizeof(layout));
+
+    if (layout.version != version)
+    {
+        std::stringstream ss;
+        ss << "Unsupported binary frame notification version: " << layout.version;
+        throw IpcMessageException(ss.str());
+    }
+
+    msg_type_            = static_cast<IpcMessage::MsgType>(layout.msg_type);
+    msg_val_             = static_cast<IpcMessage::MsgVal>(layout.msg_val);
+    frame_number_        = static_cast<int>(layout.frame_number);
+    buffer_id_           = layout.buffer_id;
+    frame_state_         = static_cast<int>(layout.frame_state);
+    frame_start_time_ns_ = layout.frame_start_time_ns;
+    msg_timestamp_ns_    = layout.msg_timestamp_ns;
+}
+
+//! Determines if a message is a binary notification.
+//!
+//! This allows a receiver to distinguish binary notifications from JSON messages arriving on
+//! the same channel without attempting to parse them.
+//!
+//! \param encoded - encoded message
+//! \return true if the message starts with the binary notification magic number
+
+bool IpcFrameNotification::is_binary(const std::string& encoded)
+{
+    if (encoded.size() < sizeof(uint32_t))
+    {
+        return false;
+    }
+    uint32_t msg_magic;
+    memcpy(&msg_magic, encoded.data(), sizeof(msg_magic));
+    return (msg_magic == magic);
+}
+
+//! Converts a timespec into ns since the epoch
+//!
+//! \param ts - timespec to convert
+//! \return time in ns
+
+uint64_t IpcFrameNotification::timespec_to_ns(const struct timespec& ts)
+{
+    return (static_cast<uint64_t>(ts.tv_sec) * 1000000000) + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+//! Encodes the notification in the binary format.
+//!
+//! \return string containing the encoded message
+
+std::string IpcFrameNotification::encode(void) const
+{
+    Layout layout;
+    layout.magic               = magic;
+    layout.version             = version;
+    layout.msg_type            = static_cast<uint8_t>(msg_type_);
+    layout.msg_val             = static_cast<uint8_t>(msg_val_);
+    layout.frame_number        = static_cast<uint32_t>(frame_number_);
+    layout.buffer_id           = buffer_id_;
+    layout.frame_state         = static_cast<uint32_t>(frame_state_);
+    layout.reserved            = 0;
+    layout.frame_start_time_ns = frame_start_time_ns_;
+    layout.msg_timestamp_ns    = msg_timestamp_ns_;
+
+    return std::string(reinterpret_cast<const char*>(&layout), sizeof(layout));
+}
+
+//! Encodes the notification as the equivalent JSON IpcMessage.
+//!
+//! This is used to forward notifications on channels which are not set to the binary format.
+//!
+//! \return string containing the JSON encoded message
+
+std::string IpcFrameNotification::encode_json(void) const
+{
+    IpcMessage msg(msg_type_, msg_val_);
+    msg.set_param("frame", frame_number_);
+    msg.set_param("buffer_id", buffer_id_);
+    msg.set_param("frame_state", frame_state_);
+
+    return std::string(msg.encode());
+}
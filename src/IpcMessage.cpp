@@ -367,6 +367,7 @@ namespace FrameReceiver {
         msg_val_map_.insert(MsgValMapEntry("status",        MsgValCmdStatus));
         msg_val_map_.insert(MsgValMapEntry("frame_ready",   MsgValNotifyFrameReady));
         msg_val_map_.insert(MsgValMapEntry("frame_release", MsgValNotifyFrameRelease));
+        msg_val_map_.insert(MsgValMapEntry("configure",     MsgValCmdConfigure));
     }
 
     //! Maps a message value string to a valid enumerated MsgVal.
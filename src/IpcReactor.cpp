@@ -8,6 +8,15 @@
 #include "IpcReactor.h"
 #include "gettime.h"
 
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/timerfd.h>
+#endif
+
 using namespace FrameReceiver;
 
 //! Constructor - instantiates an IpcReactorTimer object
@@ -17,16 +26,16 @@ using namespace FrameReceiver;
 //! being performed by the IpcReactor event loop. The timer runs periodiocally, either
 //! forever or for a fixed number of times.
 //!
-//! \param delay_ms Timer delay in milliseconds for
+//! \param delay_ns Timer delay in nanoseconds
 //! \param times    Number of times the timer should fire, a value of 0 indicates forever
 //! \param callback Callback function signature to be called when the timer fires
 
-IpcReactorTimer::IpcReactorTimer(size_t delay_ms, size_t times, TimerCallback callback) :
+IpcReactorTimer::IpcReactorTimer(TimeNs delay_ns, size_t times, TimerCallback callback) :
         timer_id_(last_timer_id_++),
-        delay_ms_(delay_ms),
+        delay_ns_(delay_ns),
         times_(times),
         callback_(callback),
-        when_(clock_mono_ms() + delay_ms),
+        when_(clock_mono_ns() + delay_ns),
         expired_(false)
 {
 }
@@ -68,20 +77,22 @@ void IpcReactorTimer::do_callback(void)
     }
     else
     {
-        when_ += delay_ms_;
+        when_ += delay_ns_;
     }
 }
 
-//! Indicates if the timer has fired (e.g. is due for handling)
+//! Indicates if the timer has fired (e.g. is due for handling) at the specified time
 //!
 //! This method indicates if the timer has fired, i.e. is due for handling by the
-//! controlling object.
+//! controlling object. The current time is passed in so that the controlling object
+//! can read the clock once for all its timers.
 //!
+//! \param now current monotonic time in nanoseconds
 //! \return boolean value, true if timer has fired
 
-bool IpcReactorTimer::has_fired(void)
+bool IpcReactorTimer::has_fired(TimeNs now)
 {
-    return (clock_mono_ms() >= when_);
+    return (now >= when_);
 }
 
 //! Indicates if the timer has expired, i.e. reached its maximum times fired
@@ -99,11 +110,11 @@ bool IpcReactorTimer::has_expired(void)
 //! Indicates when (in absolute monotonic time) the timer is due to fire
 //!
 //! this method indicates when a timer is next due to fire, in absolute
-//! monotonic time in milliseconds
+//! monotonic time in nanoseconds
 //!
-//! \return TimeMs value indicating when the timer is next due to fire
+//! \return TimeNs value indicating when the timer is next due to fire
 
-TimeMs IpcReactorTimer::when(void)
+TimeNs IpcReactorTimer::when(void)
 {
     return when_;
 }
@@ -124,6 +135,20 @@ TimeMs IpcReactorTimer::clock_mono_ms(void)
     return (TimeMs)((TimeMs) ts.tv_sec * 1000 + (TimeMs) ts.tv_nsec / 1000000);
 }
 
+//! Returns the current monotonic clock time in nanoseconds (static method)
+//!
+//! This static method returns the current monotonic system clock time to
+//! nanosecond precision, as used for scheduling timers.
+//!
+//! \return TimeNs value of the current monotonic time in nanoseconds
+TimeNs IpcReactorTimer::clock_mono_ns(void)
+{
+    struct timespec ts;
+    gettime(&ts, true);
+
+    return (TimeNs)((TimeNs) ts.tv_sec * 1000000000 + (TimeNs) ts.tv_nsec);
+}
+
 // Initialise static class variable holding last unique timer ID assigned
 int IpcReactorTimer::last_timer_id_ = 0;
 
@@ -133,11 +158,45 @@ int IpcReactorTimer::last_timer_id_ = 0;
 
 IpcReactor::IpcReactor() :
     terminate_reactor_(false),
+    needs_rebuild_(true),
+#ifdef __linux__
+    epoll_fd_(epoll_create1(EPOLL_CLOEXEC)),
+    timer_fd_armed_(0)
+#else
     pollitems_(0),
     callbacks_(0),
-    pollsize_(0),
-    needs_rebuild_(true)
+    pollsize_(0)
+#endif
 {
+#ifdef __linux__
+    if (epoll_fd_ < 0)
+    {
+        std::stringstream ss;
+        ss << "IpcReactor failed to create epoll instance: " << strerror(errno);
+        throw IpcReactorException(ss.str());
+    }
+
+    // Create the timer file descriptor used to wake the reactor when timers are due and add
+    // it to the epoll instance. It is not added to the socket map, so does not keep the
+    // reactor loop running when no timers are registered.
+    int timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd < 0)
+    {
+        std::stringstream ss;
+        ss << "IpcReactor failed to create timer file descriptor: " << strerror(errno);
+        close(epoll_fd_);
+        throw IpcReactorException(ss.str());
+    }
+
+    timer_fd_handler_.reset(new IpcReactorHandler);
+    timer_fd_handler_->callback = boost::bind(&IpcReactor::handle_timer_fd, this);
+    timer_fd_handler_->socket = 0;
+    timer_fd_handler_->fd = timer_fd;
+    timer_fd_handler_->active = true;
+    timer_fd_handler_->pending = false;
+    timer_fd_handler_->reactor = 0;
+    add_handler(timer_fd_handler_);
+#endif
 }
 
 //! Destructor
@@ -146,8 +205,19 @@ IpcReactor::IpcReactor() :
 
 IpcReactor::~IpcReactor()
 {
+    // Channels outliving the reactor must no longer notify it
+    for (ChannelMap::iterator it = channels_.begin(); it != channels_.end(); ++it)
+    {
+        it->second->reactor = 0;
+    }
+
+#ifdef __linux__
+    close(timer_fd_handler_->fd);
+    close(epoll_fd_);
+#else
     delete[] pollitems_;
     delete[] callbacks_;
+#endif
 }
 
 //! Adds an IPC channel and associated callback to the reactor
@@ -160,11 +230,31 @@ IpcReactor::~IpcReactor()
 
 void IpcReactor::register_channel(IpcChannel& channel, ReactorCallback callback)
 {
+    // Replace any existing registration of the channel
+    remove_channel(channel);
+
+    IpcReactorHandlerPtr handler(new IpcReactorHandler);
+    handler->callback = callback;
+    handler->socket = &(channel.socket_);
+    handler->fd = -1;
+    handler->active = true;
+    handler->pending = false;
+    handler->reactor = this;
+
+#ifdef __linux__
+    // ZMQ channels are waited on through the notification descriptor of the socket
+    size_t fd_len = sizeof(handler->fd);
+    channel.socket_.getsockopt(ZMQ_FD, &(handler->fd), &fd_len);
+#endif
+
     // Add channel to channel map
-    channels_[&(channel.socket_)] = callback;
+    channels_[handler->socket] = handler;
+    add_handler(handler);
 
-    // Signal a rebuild is required
-    needs_rebuild_ = true;
+    // The channel notifies the reactor when it is used elsewhere. Messages may already be pending
+    // without the notification descriptor signalling, so the channel is checked on the first poll.
+    channel.reactor_handler_ = handler;
+    mark_pending(handler.get());
 }
 
 //! Removes an IPC chanel from the reactor
@@ -177,24 +267,55 @@ void IpcReactor::register_channel(IpcChannel& channel, ReactorCallback callback)
 void IpcReactor::remove_channel(IpcChannel& channel)
 {
     // Erase the channel from the map
-    channels_.erase(&(channel.socket_));
-
-    // Signal a rebuild is required
-    needs_rebuild_ = true;
+    ChannelMap::iterator it = channels_.find(&(channel.socket_));
+    if (it != channels_.end())
+    {
+        channel.reactor_handler_.reset();
+        remove_handler(it->second);
+        channels_.erase(it);
+    }
 }
 
+//! Adds a raw socket and associated callback to the reactor
+//!
+//! This method adds a raw socket, or any other pollable file descriptor, and associated
+//! callback method to the reactor. The callback is called while the socket is readable, so
+//! need not drain it.
+//!
+//! \param socket_fd socket file descriptor to add to the reactor
+//! \param callback function reference to callback method
+
 void IpcReactor::register_socket(int socket_fd, ReactorCallback callback)
 {
-	sockets_[socket_fd] = callback;
-
-	needs_rebuild_ = true;
+    // Replace any existing registration of the socket
+    remove_socket(socket_fd);
+
+    IpcReactorHandlerPtr handler(new IpcReactorHandler);
+    handler->callback = callback;
+    handler->socket = 0;
+    handler->fd = socket_fd;
+    handler->active = true;
+    handler->pending = false;
+    handler->reactor = 0;
+
+    sockets_[socket_fd] = handler;
+    add_handler(handler);
 }
 
+//! Removes a raw socket from the reactor
+//!
+//! This method removes a raw socket and its associated callback method from the reactor.
+//!
+//! \param socket_fd socket file descriptor to remove from the reactor
+
 void IpcReactor::remove_socket(int socket_fd)
 {
-	sockets_.erase(socket_fd);
-
-	needs_rebuild_ = true;
+    SocketMap::iterator it = sockets_.find(socket_fd);
+    if (it != sockets_.end())
+    {
+        remove_handler(it->second);
+        sockets_.erase(it);
+    }
 }
 
 //! Adds a timer to the reactor
@@ -210,15 +331,25 @@ void IpcReactor::remove_socket(int socket_fd)
 
 int IpcReactor::register_timer(size_t delay_ms, size_t times, TimerCallback callback)
 {
+    // Create a smart pointer to a new timer object and add it to the reactor
+    boost::shared_ptr<IpcReactorTimer> timer(new IpcReactorTimer((TimeNs)delay_ms * 1000000, times, callback));
+    return add_timer(timer);
+}
 
-    // Create a smart pointer to a new timer object
-    boost::shared_ptr<IpcReactorTimer> timer(new IpcReactorTimer(delay_ms, times, callback));
-
-    // Add the timer to the timer map
-    timers_[timer->get_id()] = timer;
+//! Adds a timer with a delay in microseconds to the reactor
+//!
+//! This method adds a timer to the reactor as register_timer(), with the periodic delay
+//! specified in microseconds, allowing timers with sub-millisecond resolution.
+//!
+//! \param delay_us periodic timer delay in microseconds
+//! \param times number of times the timer should fire (0=indefinite)
+//! \param callback function reference to callback method
+//! \return integer unique timer ID, which can be used by the caller to delete it subsequently
 
-    // Return the unique ID
-    return timer->get_id();
+int IpcReactor::register_timer_us(size_t delay_us, size_t times, TimerCallback callback)
+{
+    boost::shared_ptr<IpcReactorTimer> timer(new IpcReactorTimer((TimeNs)delay_us * 1000, times, callback));
+    return add_timer(timer);
 }
 
 //! Removes a timer from the reactor
@@ -228,6 +359,7 @@ int IpcReactor::register_timer(size_t delay_ms, size_t times, TimerCallback call
 //! \param timer_id integer unique timer ID that was returned by the add_timer() method
 void IpcReactor::remove_timer(int timer_id)
 {
+    // The queue entry for the timer is discarded when it reaches the top of the queue
     timers_.erase(timer_id);
 }
 
@@ -255,7 +387,7 @@ int IpcReactor::run(void)
 
         // If there are no channels to poll and no timers currently active, break out of the
         // reactor loop cleanly
-        if ((pollsize_ == 0) && (timers_.size() == 0))
+        if (channels_.empty() && sockets_.empty() && timers_.empty())
         {
             rc = 0;
             break;
@@ -263,52 +395,25 @@ int IpcReactor::run(void)
 
         try
         {
-
-            // Poll the registered channels, using the tickless timeout based
-            // on the next pending timer
-            int pollrc = zmq::poll(pollitems_, pollsize_, calculate_timeout());
-
-            if (pollrc > 0)
-            {
-                // If there were any channels ready to read, execute their callbacks
-                for (size_t item = 0; item < pollsize_; ++item)
-                {
-                    // TODO handle error flag on pollitems
-                    if (pollitems_[item].revents & ZMQ_POLLIN)
-                    {
-                        callbacks_[item]();
-                    }
-                }
-            }
-            else if (pollrc == 0)
-            {
-                // Poll timed out, do nothing as we handle timers firing unconditionally below
-            }
-            else
+            // Poll the registered channels and sockets. On Linux the timer file descriptor wakes
+            // the reactor when the next timer is due, otherwise the tickless timeout is based on
+            // the next pending timer.
+#ifdef __linux__
+            arm_timer_fd();
+            int pollrc = poll_handlers(-1);
+#else
+            int pollrc = poll_handlers(calculate_timeout(IpcReactorTimer::clock_mono_ns()));
+#endif
+
+            if (pollrc < 0)
             {
                 // An error occurred, terminate the reactor loop
                 rc = -1;
                 terminate_reactor_ = true;
             }
 
-            // Handle any timers that have now fired, calling their callbacks. Erase any timers
-            // that have now expired
-            TimerMap::iterator it = timers_.begin();
-            while (it != timers_.end())
-            {
-                if ((it->second)->has_fired())
-                {
-                    (it->second)->do_callback();
-                }
-                if ((it->second)->has_expired())
-                {
-                   timers_.erase(it++);
-                }
-                else
-                {
-                	++it;
-                }
-            }
+            // Handle any timers that have now fired, reading the clock once for all of them
+            fire_timers(IpcReactorTimer::clock_mono_ns());
         }
         catch ( zmq::error_t& e)
         {
@@ -339,6 +444,341 @@ void IpcReactor::stop(void)
     terminate_reactor_ = true;
 }
 
+//! Adds a timer to the reactor timer map and queue
+//!
+//! \param timer timer to add
+//! \return integer unique timer ID
+
+int IpcReactor::add_timer(boost::shared_ptr<IpcReactorTimer> timer)
+{
+    // Add the timer to the timer map and queue it to fire
+    timers_[timer->get_id()] = timer;
+
+    IpcReactorTimerEntry entry = {timer->when(), timer->get_id()};
+    timer_queue_.push(entry);
+
+    // Return the unique ID
+    return timer->get_id();
+}
+
+//! Calls the callbacks of timers that have fired
+//!
+//! This private method pops all timers due at the specified time from the top of the timer
+//! queue and calls their callbacks, re-queueing those that have not expired and erasing those
+//! that have. Each timer fires at most once per call, as in a lagging periodic timer catching up
+//! one reactor loop iteration at a time. Timers removed by a callback are not re-queued.
+//!
+//! \param now current monotonic time in nanoseconds
+
+void IpcReactor::fire_timers(TimeNs now)
+{
+    std::vector<boost::shared_ptr<IpcReactorTimer> > fired_timers;
+
+    discard_removed_timers();
+    while (!timer_queue_.empty() && (timer_queue_.top().when <= now))
+    {
+        fired_timers.push_back(timers_[timer_queue_.top().timer_id]);
+        timer_queue_.pop();
+        discard_removed_timers();
+    }
+
+    for (size_t idx = 0; idx < fired_timers.size(); ++idx)
+    {
+        boost::shared_ptr<IpcReactorTimer> timer = fired_timers[idx];
+        if (timers_.find(timer->get_id()) == timers_.end())
+        {
+            continue;
+        }
+
+        timer->do_callback();
+
+        // The callback may have removed the timer, in which case it is not re-queued
+        if (timers_.find(timer->get_id()) == timers_.end())
+        {
+            continue;
+        }
+        if (timer->has_expired())
+        {
+            timers_.erase(timer->get_id());
+        }
+        else
+        {
+            IpcReactorTimerEntry entry = {timer->when(), timer->get_id()};
+            timer_queue_.push(entry);
+        }
+    }
+}
+
+//! Discards queue entries for timers that have been removed
+//!
+//! This private method pops entries from the top of the timer queue until the top entry
+//! belongs to a timer that is still registered.
+
+void IpcReactor::discard_removed_timers(void)
+{
+    while (!timer_queue_.empty() && (timers_.find(timer_queue_.top().timer_id) == timers_.end()))
+    {
+        timer_queue_.pop();
+    }
+}
+
+#ifdef __linux__
+
+//! Arms the timer file descriptor to expire when the next timer is due
+//!
+//! This private method arms the timer file descriptor with the absolute due time of the
+//! timer at the top of the queue, or disarms it if there are no timers. The descriptor is
+//! only reprogrammed when the due time has changed.
+
+void IpcReactor::arm_timer_fd(void)
+{
+    discard_removed_timers();
+    TimeNs when = timer_queue_.empty() ? 0 : std::max(timer_queue_.top().when, (TimeNs)1);
+
+    if (when != timer_fd_armed_)
+    {
+        struct itimerspec timer_spec;
+        memset(&timer_spec, 0, sizeof(timer_spec));
+        timer_spec.it_value.tv_sec  = when / 1000000000;
+        timer_spec.it_value.tv_nsec = when % 1000000000;
+
+        if (timerfd_settime(timer_fd_handler_->fd, TFD_TIMER_ABSTIME, &timer_spec, NULL) < 0)
+        {
+            std::stringstream ss;
+            ss << "IpcReactor failed to arm timer file descriptor: " << strerror(errno);
+            throw IpcReactorException(ss.str());
+        }
+        timer_fd_armed_ = when;
+    }
+}
+
+//! Handles expiry of the timer file descriptor
+//!
+//! This private method reads the expiry count from the timer file descriptor to clear its
+//! readiness. The timers themselves are fired at the end of the reactor loop iteration.
+
+void IpcReactor::handle_timer_fd(void)
+{
+    uint64_t expirations;
+    if (read(timer_fd_handler_->fd, &expirations, sizeof(expirations)) == sizeof(expirations))
+    {
+        timer_fd_armed_ = 0;
+    }
+}
+
+#endif
+
+//! Adds a handler to the underlying poll mechanism
+//!
+//! This private method adds a newly registered channel or socket handler to the epoll
+//! instance, storing a pointer to the handler in the event data. On other platforms the
+//! poll item list is rebuilt before the next poll.
+//!
+//! \param handler channel or socket handler to add
+
+void IpcReactor::add_handler(IpcReactorHandlerPtr handler)
+{
+#ifdef __linux__
+    // Raw sockets are level-triggered, as callbacks are not required to drain them, whereas
+    // the ZMQ_FD notification descriptor of a channel only signals edges
+    struct epoll_event event;
+    event.events = handler->socket ? (EPOLLIN | EPOLLET) : EPOLLIN;
+    event.data.ptr = handler.get();
+
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, handler->fd, &event) < 0)
+    {
+        std::stringstream ss;
+        ss << "IpcReactor failed to add file descriptor " << handler->fd << " to epoll instance: " << strerror(errno);
+        throw IpcReactorException(ss.str());
+    }
+#endif
+
+    // Signal a rebuild is required
+    needs_rebuild_ = true;
+}
+
+//! Removes a handler from the underlying poll mechanism
+//!
+//! This private method removes a channel or socket handler from the epoll instance. The
+//! handler is marked inactive and kept alive until the current dispatch completes, since
+//! events already returned by epoll may still point to it.
+//!
+//! \param handler channel or socket handler to remove
+
+void IpcReactor::remove_handler(IpcReactorHandlerPtr handler)
+{
+    handler->active = false;
+
+#ifdef __linux__
+    // The descriptor may already have been closed, which removes it from the epoll instance,
+    // so failure here is ignored
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, handler->fd, NULL);
+    removed_handlers_.push_back(handler);
+#endif
+
+    // Signal a rebuild is required
+    needs_rebuild_ = true;
+}
+
+//! Queues a channel to have its event state checked for pending messages
+//!
+//! This private method adds a channel to the pending list checked on the next poll, unless it
+//! is already queued. It is called when the notification descriptor of the channel wakes the
+//! reactor, after the channel callback runs and whenever the channel is sent or received on.
+//! On other platforms every channel is polled, so this has no effect.
+//!
+//! \param handler channel handler to queue
+
+void IpcReactor::mark_pending(IpcReactorHandler* handler)
+{
+#ifdef __linux__
+    if (handler->active && !handler->pending)
+    {
+        handler->pending = true;
+        pending_handlers_.push_back(handler);
+    }
+#endif
+}
+
+#ifdef __linux__
+
+//! Waits for and dispatches callbacks for readable channels and sockets
+//!
+//! This private method waits on the epoll instance for up to the specified timeout and calls
+//! the callbacks of the ready sockets, retrieving each handler directly from the event data.
+//! The notification descriptor of a ZMQ channel signals changes of state rather than pending
+//! messages, and sending or receiving on the socket can consume the change, so only the channels
+//! on the pending list have their event state checked: those woken by their descriptor, those
+//! whose callback has run, which may have left further messages, and those used elsewhere. The
+//! reactor does not block while any channel is pending.
+//!
+//! \param timeout_ms maximum time to wait in milliseconds, -1 to wait indefinitely
+//! \return integer number of events returned by epoll, or -1 on error
+
+int IpcReactor::poll_handlers(long timeout_ms)
+{
+    // Don't block if any channel may have messages pending
+    if (!pending_handlers_.empty())
+    {
+        timeout_ms = 0;
+    }
+
+    int num_events = epoll_wait(epoll_fd_, &(epoll_events_[0]), epoll_events_.size(), timeout_ms);
+    if (num_events < 0)
+    {
+        // An interrupted wait is caused by a custom signal handler, so terminate the reactor
+        // gracefully, as for zmq::poll
+        if (errno != EINTR)
+        {
+            std::stringstream ss;
+            ss << "IpcReactor error while polling: " << strerror(errno);
+            throw IpcReactorException(ss.str());
+        }
+        return -1;
+    }
+
+    // Call the callbacks of ready raw sockets, and queue woken channels to be checked below
+    for (int event = 0; event < num_events; ++event)
+    {
+        IpcReactorHandler* handler = reinterpret_cast<IpcReactorHandler*>(epoll_events_[event].data.ptr);
+        if (!handler->active)
+        {
+            continue;
+        }
+        if (handler->socket)
+        {
+            mark_pending(handler);
+        }
+        else
+        {
+            handler->callback();
+        }
+    }
+
+    // Call the callbacks of pending channels with messages to receive. Each channel dispatched
+    // stays pending, so is checked again on the next poll. Channels queued by the callbacks are
+    // added to the emptied pending list rather than the list being checked.
+    int events = 0;
+    size_t events_len = sizeof(events);
+
+    checked_handlers_.swap(pending_handlers_);
+    for (size_t idx = 0; idx < checked_handlers_.size(); ++idx)
+    {
+        IpcReactorHandler* handler = checked_handlers_[idx];
+        handler->pending = false;
+        if (handler->active)
+        {
+            handler->socket->getsockopt(ZMQ_EVENTS, &events, &events_len);
+            if (events & ZMQ_POLLIN)
+            {
+                mark_pending(handler);
+                handler->callback();
+            }
+        }
+    }
+    checked_handlers_.clear();
+
+    return num_events;
+}
+
+//! Rebuilds the internal list of polling item
+//!
+//! This private method rebuilds the internal lists of handlers used by the reactor loop
+//! after adding or removing channels and sockets. Removed handlers are dropped from the
+//! pending list and released, and the epoll event array and pending lists are sized to the
+//! number of registered handlers, so that the reactor loop does not allocate.
+
+void IpcReactor::rebuild_pollitems(void)
+{
+    size_t num_pending = 0;
+    for (size_t idx = 0; idx < pending_handlers_.size(); ++idx)
+    {
+        if (pending_handlers_[idx]->active)
+        {
+            pending_handlers_[num_pending++] = pending_handlers_[idx];
+        }
+    }
+    pending_handlers_.resize(num_pending);
+    pending_handlers_.reserve(channels_.size());
+    checked_handlers_.reserve(channels_.size());
+    removed_handlers_.clear();
+
+    // Allow for an event from the timer file descriptor
+    epoll_events_.resize(channels_.size() + sockets_.size() + 1);
+
+    needs_rebuild_ = false;
+}
+
+#else
+
+//! Waits for and dispatches callbacks for readable channels and sockets
+//!
+//! This private method polls the registered channels and sockets with zmq::poll for up to the
+//! specified timeout and calls the callbacks of those ready to read.
+//!
+//! \param timeout_ms maximum time to wait in milliseconds
+//! \return integer number of ready items, or -1 on error
+
+int IpcReactor::poll_handlers(long timeout_ms)
+{
+    int pollrc = zmq::poll(pollitems_, pollsize_, timeout_ms);
+
+    if (pollrc > 0)
+    {
+        // If there were any channels ready to read, execute their callbacks
+        for (size_t item = 0; item < pollsize_; ++item)
+        {
+            // TODO handle error flag on pollitems
+            if (pollitems_[item].revents & ZMQ_POLLIN)
+            {
+                callbacks_[item]();
+            }
+        }
+    }
+
+    return pollrc;
+}
+
 //! Rebuilds the internal list of polling item
 //!
 //! This private method rebuilds the internal list of items to poll in the reactor
@@ -379,50 +819,47 @@ void IpcReactor::rebuild_pollitems(void)
         {
             zmq::pollitem_t pollitem = {*(it->first), 0, ZMQ_POLLIN, 0};
             pollitems_[item] = pollitem;
-            callbacks_[item] = it->second;
+            callbacks_[item] = it->second->callback;
         }
 
         for (SocketMap::iterator it = sockets_.begin(); it != sockets_.end(); ++item, ++it)
         {
         	zmq::pollitem_t pollitem = {0, it->first, ZMQ_POLLIN, 0};
             pollitems_[item] = pollitem;
-            callbacks_[item] = it->second;
+            callbacks_[item] = it->second->callback;
         }
     }
+
+    needs_rebuild_ = false;
 }
 
+#endif
+
 //! Calculates the next poll timeout based on the tickless pattern
 //!
 //! This private method calculates the next reactor poll timeout based on the
 //! 'tickless' idiom in the CZMQ zloop implementation. The timeout is set
-//! to match the next timer due to fire.
+//! to match the next timer due to fire, rounded up to the next millisecond.
 //!
+//! \param now current monotonic time in nanoseconds
 //! \return long timeout value in milliseconds
 
-long IpcReactor::calculate_timeout(void)
+long IpcReactor::calculate_timeout(TimeNs now)
 {
-
-    // Calculate shortest timeout up to one hour (!!), looping through
-    // current timers to see which fires first
-    TimeMs tickless = IpcReactorTimer::clock_mono_ms() + (1000 * 3600);
-    for (TimerMap::iterator it = timers_.begin(); it != timers_.end(); ++it)
+    // Wait up to one hour (!!) if there are no timers pending
+    discard_removed_timers();
+    if (timer_queue_.empty())
     {
-        if (tickless > (it->second)->when())
-        {
-            tickless = (it->second)->when();
-        }
+        return 1000 * 3600;
     }
 
-    // Calculate current timeout based on that, set to zero (don't wait) if
-    // there is no timers pending
-    long timeout = (long)(tickless - IpcReactorTimer::clock_mono_ms());
-    if (timeout < 0)
+    // Calculate the timeout from the timer at the top of the queue, set to zero (don't wait)
+    // if it is already due
+    TimeNs timeout_ns = timer_queue_.top().when - now;
+    if (timeout_ns < 0)
     {
-        timeout = 0;
+        timeout_ns = 0;
     }
 
-    return timeout;
+    return (long)((timeout_ns + 999999) / 1000000);
 }
-
-
-
@@ -0,0 +1,278 @@
+/*!
+ * NotificationRing.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "NotificationRing.h"
+
+#include <sstream>
+#include <climits>
+#include <cstring>
+#include <errno.h>
+#include <unistd.h>
+
+#include <boost/static_assert.hpp>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace FrameReceiver;
+
+namespace
+{
+    // Returns the smallest power of two not less than the value
+    uint32_t round_up_power_of_two(size_t value)
+    {
+        uint32_t rounded = 1;
+        while (rounded < value)
+        {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+}
+
+//! Returns the size of the memory region needed for a ring of at least the specified capacity
+//!
+//! \param capacity - minimum number of entries the ring can hold
+//! \return size of the region in bytes
+
+size_t NotificationRing::get_region_size(size_t capacity)
+{
+    return sizeof(Control) + (round_up_power_of_two(capacity) * sizeof(Entry));
+}
+
+//! Constructor - initialises a new ring in the specified memory region.
+//!
+//! The capacity is rounded up to a power of two. The region must be at least
+//! get_region_size(capacity) bytes long and is not owned by the ring.
+//!
+//! \param address - address of the ring region
+//! \param capacity - minimum number of entries the ring can hold
+
+NotificationRing::NotificationRing(void* address, size_t capacity) :
+        control_(reinterpret_cast<Control*>(address)),
+        entries_(reinterpret_cast<Entry*>(reinterpret_cast<uint8_t*>(address) + sizeof(Control))),
+        mask_(round_up_power_of_two(capacity) - 1)
+{
+    BOOST_STATIC_ASSERT(sizeof(Control) == 256);
+    BOOST_STATIC_ASSERT(sizeof(Entry) == 32);
+
+    memset(control_, 0, sizeof(Control));
+    control_->capacity   = mask_ + 1;
+    control_->entry_size = sizeof(Entry);
+    control_->version    = version;
+
+    // Publish the magic number last so that an attaching process never sees a partially
+    // initialised ring
+    __sync_synchronize();
+    control_->magic = magic;
+}
+
+//! Constructor - attaches to an existing ring in the specified memory region.
+//!
+//! A NotificationRingException is thrown if the region does not contain a valid ring.
+//!
+//! \param address - address of the ring region
+
+NotificationRing::NotificationRing(void* address) :
+        control_(reinterpret_cast<Control*>(address)),
+        entries_(reinterpret_cast<Entry*>(reinterpret_cast<uint8_t*>(address) + sizeof(Control))),
+        mask_(0)
+{
+    if (control_->magic != magic)
+    {
+        throw NotificationRingException("No notification ring found at specified address");
+    }
+    if ((control_->version != version) || (control_->entry_size != sizeof(Entry)))
+    {
+        std::stringstream ss;
+        ss << "Incompatible notification ring version " << control_->version << " entry size " << control_->entry_size;
+        throw NotificationRingException(ss.str());
+    }
+    mask_ = control_->capacity - 1;
+}
+
+//! Push an entry onto the ring.
+//!
+//! This method must only be called by the single producer. A consumer blocked in wait() is
+//! woken if necessary.
+//!
+//! \param entry - entry to push
+//! \return true if the entry was pushed, false if the ring is full
+
+bool NotificationRing::push(const Entry& entry)
+{
+    uint32_t head = control_->head;
+    if ((head - control_->tail) > mask_)
+    {
+        return false;
+    }
+
+    entries_[head & mask_] = entry;
+
+    // Make the entry visible before the updated head, and the head visible before checking for
+    // waiting consumers, pairing with the barrier in wait()
+    __sync_synchronize();
+    control_->head = head + 1;
+    __sync_synchronize();
+
+    if (control_->waiters)
+    {
+        wake_waiters();
+    }
+    return true;
+}
+
+//! Pop an entry from the ring.
+//!
+//! This method must only be called by the single consumer.
+//!
+//! \param entry - entry to fill
+//! \return true if an entry was popped, false if the ring is empty
+
+bool NotificationRing::pop(Entry& entry)
+{
+    uint32_t tail = control_->tail;
+    if (tail == control_->head)
+    {
+        return false;
+    }
+
+    // Read the entry only after observing the head that published it, and release the slot
+    // only once it has been read
+    __sync_synchronize();
+    entry = entries_[tail & mask_];
+    __sync_synchronize();
+    control_->tail = tail + 1;
+
+    return true;
+}
+
+//! Wait for entries to become available on the ring.
+//!
+//! This method must only be called by the single consumer. It returns immediately if the ring
+//! is not empty, otherwise blocks until the producer pushes an entry or the timeout expires.
+//!
+//! \param timeout_ms - maximum time to wait in milliseconds
+//! \return true if entries are available
+
+bool NotificationRing::wait(unsigned int timeout_ms)
+{
+    // The ring is empty while the head has not moved beyond the tail
+    uint32_t head = control_->tail;
+    return wait_for_push(head, timeout_ms);
+}
+
+//! Wait for the producer to push entries beyond the specified head index.
+//!
+//! This allows a thread other than the consumer to wait for entries without popping them, e.g.
+//! to wake the consumer through a descriptor it polls. The method returns immediately if the
+//! head has already moved, otherwise blocks until the producer pushes an entry or the timeout
+//! expires. Only one thread should wait on a ring at a time.
+//!
+//! \param head - head index last seen by the caller, updated to the current head index
+//! \param timeout_ms - maximum time to wait in milliseconds
+//! \return true if entries have been pushed beyond the specified head index
+
+bool NotificationRing::wait_for_push(uint32_t& head, unsigned int timeout_ms)
+{
+    uint32_t last_head = head;
+    head = control_->head;
+    if (head != last_head)
+    {
+        return true;
+    }
+
+#ifdef __linux__
+    // Register as a waiter before re-checking the head, so that a producer pushing in between
+    // either sees the waiter and wakes it, or the entry is seen here
+    __sync_fetch_and_add(&(control_->waiters), 1);
+    int32_t wake_seq = control_->wake_seq;
+
+    if (control_->head == last_head)
+    {
+        struct timespec timeout;
+        timeout.tv_sec  = timeout_ms / 1000;
+        timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
+        syscall(SYS_futex, &(control_->wake_seq), FUTEX_WAIT, wake_seq, &timeout, NULL, 0);
+    }
+
+    __sync_fetch_and_sub(&(control_->waiters), 1);
+#else
+    // Without futexes, poll the ring at short intervals until the timeout expires
+    for (unsigned int elapsed_us = 0; (control_->head == last_head) && (elapsed_us < timeout_ms * 1000); elapsed_us += 100)
+    {
+        usleep(100);
+    }
+#endif
+
+    head = control_->head;
+    return (head != last_head);
+}
+
+//! Register the consumer of the ring.
+//!
+//! This method must only be called by the single consumer. Any entries left on the ring, e.g.
+//! pushed while a previous consumer was detaching, are kept for the new consumer to pop.
+
+void NotificationRing::attach_consumer(void)
+{
+    control_->consumer_attached = 1;
+    __sync_synchronize();
+}
+
+//! Deregister the consumer of the ring.
+//!
+//! The producer stops pushing once it observes the consumer detached, after which the consumer
+//! should pop the entries remaining on the ring and handle them, e.g. release their buffers.
+
+void NotificationRing::detach_consumer(void)
+{
+    control_->consumer_attached = 0;
+    __sync_synchronize();
+}
+
+//! Returns true if a consumer is registered with the ring
+
+bool NotificationRing::has_consumer(void) const
+{
+    // Order the flag read before any subsequent push
+    bool attached = (control_->consumer_attached != 0);
+    __sync_synchronize();
+    return attached;
+}
+
+//! Returns the number of entries the ring can hold
+
+size_t NotificationRing::capacity(void) const
+{
+    return mask_ + 1;
+}
+
+//! Returns the number of entries currently on the ring
+
+size_t NotificationRing::size(void) const
+{
+    return control_->head - control_->tail;
+}
+
+//! Returns the size of the memory region occupied by the ring
+
+size_t NotificationRing::get_region_size(void) const
+{
+    return sizeof(Control) + (capacity() * sizeof(Entry));
+}
+
+//! Wake any thread blocked waiting on the ring, e.g. so that it can be stopped.
+
+void NotificationRing::wake_waiters(void)
+{
+    __sync_fetch_and_add(&(control_->wake_seq), 1);
+#ifdef __linux__
+    syscall(SYS_futex, &(control_->wake_seq), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
@@ -0,0 +1,108 @@
+/*!
+ * NotificationRingWatcher.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "NotificationRingWatcher.h"
+
+#include <sstream>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include <boost/bind.hpp>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+using namespace FrameReceiver;
+
+//! Constructor - starts watching the specified ring.
+//!
+//! \param ring - ring to watch, which must outlive the watcher
+//! \param wait_timeout_ms - maximum time to block on the ring, which bounds the time taken to stop the watcher
+
+NotificationRingWatcher::NotificationRingWatcher(NotificationRing& ring, unsigned int wait_timeout_ms) :
+        ring_(ring),
+        wait_timeout_ms_(wait_timeout_ms),
+        run_watcher_(true),
+        notify_fd_(-1),
+        notify_write_fd_(-1)
+{
+#ifdef __linux__
+    notify_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    notify_write_fd_ = notify_fd_;
+    if (notify_fd_ < 0)
+#else
+    // Platforms without eventfd use a non-blocking pipe instead
+    int pipe_fds[2];
+    if (pipe(pipe_fds) == 0)
+    {
+        notify_fd_ = pipe_fds[0];
+        notify_write_fd_ = pipe_fds[1];
+        fcntl(notify_fd_, F_SETFL, O_NONBLOCK);
+        fcntl(notify_write_fd_, F_SETFL, O_NONBLOCK);
+    }
+    else
+#endif
+    {
+        std::stringstream ss;
+        ss << "Failed to create notification ring watcher descriptor: " << strerror(errno);
+        throw NotificationRingException(ss.str());
+    }
+
+    watcher_thread_.reset(new boost::thread(boost::bind(&NotificationRingWatcher::watch, this)));
+}
+
+NotificationRingWatcher::~NotificationRingWatcher()
+{
+    run_watcher_ = false;
+    ring_.wake_waiters();
+    watcher_thread_->join();
+
+    close(notify_fd_);
+    if (notify_write_fd_ != notify_fd_)
+    {
+        close(notify_write_fd_);
+    }
+}
+
+//! Return the notification descriptor, which becomes readable when entries have been pushed
+
+int NotificationRingWatcher::get_notify_fd(void) const
+{
+    return notify_fd_;
+}
+
+//! Clear a notification.
+//!
+//! This method must be called by the consumer before draining the ring with pop(). Any entry
+//! pushed after the notification is cleared either is drained by the subsequent pop() calls or
+//! raises a new notification.
+
+void NotificationRingWatcher::clear_notification(void)
+{
+    uint64_t signal;
+    while (read(notify_fd_, &signal, sizeof(signal)) > 0)
+    {
+    }
+}
+
+void NotificationRingWatcher::watch(void)
+{
+    // Start from an empty ring, so that entries already pushed raise a notification immediately
+    uint32_t head = 0;
+    while (run_watcher_)
+    {
+        if (ring_.wait_for_push(head, wait_timeout_ms_))
+        {
+            uint64_t signal = 1;
+            ssize_t rc = write(notify_write_fd_, &signal, sizeof(signal));
+            (void)rc;
+        }
+    }
+}
@@ -0,0 +1,442 @@
+/*!
+ * PacketCapture.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "PacketCapture.h"
+
+#include <sstream>
+#include <cstring>
+#include <errno.h>
+#include <arpa/inet.h>
+
+using namespace FrameReceiver;
+
+namespace
+{
+    const uint32_t pcap_magic_usec      = 0xa1b2c3d4;
+    const uint32_t pcap_magic_nsec      = 0xa1b23c4d;
+    const uint16_t pcap_version_major   = 2;
+    const uint16_t pcap_version_minor   = 4;
+    const uint32_t pcap_snap_length     = 65535;
+
+    const uint32_t link_type_ethernet   = 1;
+    const uint32_t link_type_raw        = 101;
+    const uint32_t link_type_linux_sll  = 113;
+    const uint32_t link_type_ipv4       = 228;
+
+    const uint16_t ether_type_ipv4      = 0x0800;
+    const uint16_t ether_type_vlan      = 0x8100;
+    const uint8_t  ip_protocol_udp      = 17;
+    const size_t   ipv4_header_size     = 20;
+    const size_t   udp_header_size      = 8;
+
+    typedef struct
+    {
+        uint32_t magic_number;
+        uint16_t version_major;
+        uint16_t version_minor;
+        int32_t  thiszone;
+        uint32_t sigfigs;
+        uint32_t snaplen;
+        uint32_t network;
+    } PcapFileHeader;
+
+    typedef struct
+    {
+        uint32_t ts_sec;
+        uint32_t ts_frac;
+        uint32_t incl_len;
+        uint32_t orig_len;
+    } PcapRecordHeader;
+
+    // Record header and synthesised IPv4 and UDP headers written ahead of each captured datagram
+    typedef struct __attribute__((packed))
+    {
+        PcapRecordHeader record;
+        uint8_t  ip_version_ihl;
+        uint8_t  ip_tos;
+        uint16_t ip_total_length;
+        uint16_t ip_id;
+        uint16_t ip_flags_fragment;
+        uint8_t  ip_ttl;
+        uint8_t  ip_protocol;
+        uint16_t ip_checksum;
+        uint32_t ip_src_addr;
+        uint32_t ip_dst_addr;
+        uint16_t udp_src_port;
+        uint16_t udp_dst_port;
+        uint16_t udp_length;
+        uint16_t udp_checksum;
+    } CaptureRecordHeader;
+
+    // Computes the internet checksum of an IPv4 header, given in network byte order
+    uint16_t ipv4_header_checksum(const uint8_t* header, size_t length)
+    {
+        uint32_t sum = 0;
+        for (size_t idx = 0; idx < length; idx += 2)
+        {
+            sum += (header[idx] << 8) | header[idx + 1];
+        }
+        while (sum >> 16)
+        {
+            sum = (sum & 0xffff) + (sum >> 16);
+        }
+        return htons(static_cast<uint16_t>(~sum));
+    }
+
+    uint16_t read_be16(const uint8_t* ptr)
+    {
+        return static_cast<uint16_t>((ptr[0] << 8) | ptr[1]);
+    }
+}
+
+//! Constructor - creates a capture file and writes the pcap file header.
+//!
+//! \param file_name - name of the capture file, which is overwritten if it exists
+//! \param dest_address - destination IP address given in the synthesised IP headers
+//! \param buffer_size - size of the stream buffer batching writes to the file
+
+PacketCaptureWriter::PacketCaptureWriter(const std::string& file_name, const std::string& dest_address,
+        size_t buffer_size) :
+        file_name_(file_name),
+        file_(0),
+        file_buffer_(buffer_size),
+        dest_addr_(inet_addr(dest_address.c_str())),
+        ip_id_(0),
+        packets_(0),
+        bytes_(0)
+{
+    if (dest_addr_ == INADDR_NONE)
+    {
+        dest_addr_ = htonl(INADDR_ANY);
+    }
+
+    file_ = fopen(file_name_.c_str(), "wb");
+    if (file_ == 0)
+    {
+        std::stringstream ss;
+        ss << "Failed to open packet capture file " << file_name_ << ": " << strerror(errno);
+        throw PacketCaptureException(ss.str());
+    }
+    if (buffer_size > 0)
+    {
+        setvbuf(file_, &file_buffer_[0], _IOFBF, file_buffer_.size());
+    }
+
+    PcapFileHeader file_header;
+    file_header.magic_number  = pcap_magic_nsec;
+    file_header.version_major = pcap_version_major;
+    file_header.version_minor = pcap_version_minor;
+    file_header.thiszone      = 0;
+    file_header.sigfigs       = 0;
+    file_header.snaplen       = pcap_snap_length;
+    file_header.network       = link_type_raw;
+
+    if (fwrite(&file_header, sizeof(file_header), 1, file_) != 1)
+    {
+        fclose(file_);
+        std::stringstream ss;
+        ss << "Failed to write header of packet capture file " << file_name_ << ": " << strerror(errno);
+        throw PacketCaptureException(ss.str());
+    }
+}
+
+//! Destructor - flushes and closes the capture file
+
+PacketCaptureWriter::~PacketCaptureWriter()
+{
+    fclose(file_);
+}
+
+//! Writes a datagram to the capture file.
+//!
+//! The datagram is given in two parts, as received by the RX thread into the packet header buffer
+//! and payload location of the decoder, either of which may be empty.
+//!
+//! \param timestamp - time the datagram was received
+//! \param from_addr - source address of the datagram
+//! \param port - port the datagram was received on
+//! \param header - first part of the datagram
+//! \param header_size - size of the first part
+//! \param payload - second part of the datagram
+//! \param payload_size - size of the second part
+
+void PacketCaptureWriter::write(const struct timespec& timestamp, const struct sockaddr_in* from_addr, int port,
+        const void* header, size_t header_size, const void* payload, size_t payload_size)
+{
+    size_t datagram_size = header_size + payload_size;
+    size_t record_size = ipv4_header_size + udp_header_size + datagram_size;
+
+    CaptureRecordHeader record_header;
+    record_header.record.ts_sec   = static_cast<uint32_t>(timestamp.tv_sec);
+    record_header.record.ts_frac  = static_cast<uint32_t>(timestamp.tv_nsec);
+    record_header.record.incl_len = static_cast<uint32_t>(record_size);
+    record_header.record.orig_len = static_cast<uint32_t>(record_size);
+
+    record_header.ip_version_ihl    = 0x45;
+    record_header.ip_tos            = 0;
+    record_header.ip_total_length   = htons(static_cast<uint16_t>(record_size));
+    record_header.ip_id             = htons(ip_id_++);
+    record_header.ip_flags_fragment = htons(0x4000);
+    record_header.ip_ttl            = 64;
+    record_header.ip_protocol       = ip_protocol_udp;
+    record_header.ip_checksum       = 0;
+    record_header.ip_src_addr       = from_addr ? from_addr->sin_addr.s_addr : htonl(INADDR_ANY);
+    record_header.ip_dst_addr       = dest_addr_;
+    record_header.ip_checksum       = ipv4_header_checksum(&record_header.ip_version_ihl, ipv4_header_size);
+
+    // A zero UDP checksum indicates that none was computed, which is legal for IPv4
+    record_header.udp_src_port = from_addr ? from_addr->sin_port : 0;
+    record_header.udp_dst_port = htons(static_cast<uint16_t>(port));
+    record_header.udp_length   = htons(static_cast<uint16_t>(udp_header_size + datagram_size));
+    record_header.udp_checksum = 0;
+
+    if ((fwrite(&record_header, sizeof(record_header), 1, file_) != 1) ||
+        (header_size && (fwrite(header, header_size, 1, file_) != 1)) ||
+        (payload_size && (fwrite(payload, payload_size, 1, file_) != 1)))
+    {
+        std::stringstream ss;
+        ss << "Failed to write to packet capture file " << file_name_ << ": " << strerror(errno);
+        throw PacketCaptureException(ss.str());
+    }
+
+    packets_++;
+    bytes_ += datagram_size;
+}
+
+//! Flushes datagrams buffered in the stream to the capture file
+
+void PacketCaptureWriter::flush(void)
+{
+    fflush(file_);
+}
+
+//! Returns the name of the capture file
+
+const std::string& PacketCaptureWriter::get_file_name(void) const
+{
+    return file_name_;
+}
+
+//! Returns the number of datagrams written to the capture file
+
+uint64_t PacketCaptureWriter::get_num_packets(void) const
+{
+    return packets_;
+}
+
+//! Returns the number of datagram bytes written to the capture file, excluding record headers
+
+uint64_t PacketCaptureWriter::get_num_bytes(void) const
+{
+    return bytes_;
+}
+
+//! Constructor - opens a capture file and reads the pcap file header.
+//!
+//! \param file_name - name of the capture file
+
+PacketCaptureReader::PacketCaptureReader(const std::string& file_name) :
+        file_name_(file_name),
+        file_(0),
+        swapped_(false),
+        nanosecond_(false),
+        link_type_(0),
+        record_(pcap_snap_length),
+        skipped_(0)
+{
+    file_ = fopen(file_name_.c_str(), "rb");
+    if (file_ == 0)
+    {
+        std::stringstream ss;
+        ss << "Failed to open packet capture file " << file_name_ << ": " << strerror(errno);
+        throw PacketCaptureException(ss.str());
+    }
+
+    PcapFileHeader file_header;
+    if (fread(&file_header, sizeof(file_header), 1, file_) != 1)
+    {
+        fclose(file_);
+        throw PacketCaptureException("Packet capture file " + file_name_ + " is too short for a pcap file header");
+    }
+
+    switch (file_header.magic_number)
+    {
+    case pcap_magic_usec:
+        break;
+    case pcap_magic_nsec:
+        nanosecond_ = true;
+        break;
+    default:
+        swapped_ = true;
+        if (file_to_host(file_header.magic_number) == pcap_magic_nsec)
+        {
+            nanosecond_ = true;
+        }
+        else if (file_to_host(file_header.magic_number) != pcap_magic_usec)
+        {
+            fclose(file_);
+            throw PacketCaptureException("Packet capture file " + file_name_ + " is not a pcap file");
+        }
+        break;
+    }
+
+    link_type_ = file_to_host(file_header.network) & 0xffff;
+    if ((link_type_ != link_type_ethernet) && (link_type_ != link_type_raw) &&
+        (link_type_ != link_type_linux_sll) && (link_type_ != link_type_ipv4))
+    {
+        fclose(file_);
+        std::stringstream ss;
+        ss << "Packet capture file " << file_name_ << " has unsupported link type " << link_type_;
+        throw PacketCaptureException(ss.str());
+    }
+}
+
+//! Destructor - closes the capture file
+
+PacketCaptureReader::~PacketCaptureReader()
+{
+    fclose(file_);
+}
+
+//! Reads the next UDP datagram from the capture file.
+//!
+//! Records which are not UDP datagrams are skipped. A truncated record at the end of the file, as
+//! left by a capture that was not closed cleanly, is treated as the end of the file.
+//!
+//! \param datagram - datagram read, whose data remains valid until the next read
+//! \return true if a datagram was read, false at the end of the file
+
+bool PacketCaptureReader::read(CapturedDatagram& datagram)
+{
+    PcapRecordHeader record_header;
+    while (fread(&record_header, sizeof(record_header), 1, file_) == 1)
+    {
+        size_t incl_len = file_to_host(record_header.incl_len);
+        if (incl_len > record_.size())
+        {
+            record_.resize(incl_len);
+        }
+        if ((incl_len > 0) && (fread(&record_[0], incl_len, 1, file_) != 1))
+        {
+            break;
+        }
+
+        datagram.timestamp.tv_sec  = file_to_host(record_header.ts_sec);
+        datagram.timestamp.tv_nsec = file_to_host(record_header.ts_frac) * (nanosecond_ ? 1 : 1000);
+        datagram.length = incl_len;
+        datagram.original_length = file_to_host(record_header.orig_len);
+
+        if (decode_record(datagram))
+        {
+            return true;
+        }
+        skipped_++;
+    }
+    return false;
+}
+
+//! Rewinds the capture file to the first record, so that it can be replayed again
+
+void PacketCaptureReader::rewind(void)
+{
+    fseek(file_, sizeof(PcapFileHeader), SEEK_SET);
+}
+
+//! Returns the link layer type of the records in the capture file
+
+uint32_t PacketCaptureReader::get_link_type(void) const
+{
+    return link_type_;
+}
+
+//! Returns the number of records skipped as they were not UDP datagrams
+
+uint64_t PacketCaptureReader::get_num_skipped(void) const
+{
+    return skipped_;
+}
+
+uint32_t PacketCaptureReader::file_to_host(uint32_t value) const
+{
+    return swapped_ ? __builtin_bswap32(value) : value;
+}
+
+//! Decodes the link layer, IPv4 and UDP headers of the record just read.
+//!
+//! On entry the datagram length fields hold the captured and original record lengths, which are
+//! converted to those of the UDP payload.
+
+bool PacketCaptureReader::decode_record(CapturedDatagram& datagram)
+{
+    const uint8_t* ptr = &record_[0];
+    size_t remaining = datagram.length;
+    size_t link_header_size = 0;
+    uint16_t ether_type = ether_type_ipv4;
+
+    if (link_type_ == link_type_ethernet)
+    {
+        link_header_size = 14;
+        if (remaining < link_header_size)
+        {
+            return false;
+        }
+        ether_type = read_be16(ptr + 12);
+        while ((ether_type == ether_type_vlan) && (remaining >= link_header_size + 4))
+        {
+            ether_type = read_be16(ptr + link_header_size + 2);
+            link_header_size += 4;
+        }
+    }
+    else if (link_type_ == link_type_linux_sll)
+    {
+        link_header_size = 16;
+        if (remaining < link_header_size)
+        {
+            return false;
+        }
+        ether_type = read_be16(ptr + 14);
+    }
+
+    if ((ether_type != ether_type_ipv4) || (remaining < link_header_size + ipv4_header_size))
+    {
+        return false;
+    }
+    ptr += link_header_size;
+    remaining -= link_header_size;
+
+    // Only unfragmented IPv4 UDP datagrams are replayed
+    size_t ip_header_size = (ptr[0] & 0x0f) * 4;
+    if (((ptr[0] >> 4) != 4) || (ip_header_size < ipv4_header_size) ||
+        (ptr[9] != ip_protocol_udp) || ((read_be16(ptr + 6) & 0x3fff) != 0) ||
+        (remaining < ip_header_size + udp_header_size))
+    {
+        return false;
+    }
+
+    memset(&datagram.from_addr, 0, sizeof(datagram.from_addr));
+    datagram.from_addr.sin_family = AF_INET;
+    memcpy(&datagram.from_addr.sin_addr.s_addr, ptr + 12, sizeof(uint32_t));
+
+    ptr += ip_header_size;
+    remaining -= ip_header_size;
+
+    memcpy(&datagram.from_addr.sin_port, ptr, sizeof(uint16_t));
+    datagram.port = read_be16(ptr + 2);
+    size_t udp_length = read_be16(ptr + 4);
+    if (udp_length < udp_header_size)
+    {
+        return false;
+    }
+
+    // The capture may hold less of the datagram than was on the wire if taken with a short snap
+    // length, and may include link layer padding after it
+    datagram.data = ptr + udp_header_size;
+    datagram.original_length = udp_length - udp_header_size;
+    remaining -= udp_header_size;
+    datagram.length = (remaining < datagram.original_length) ? remaining : datagram.original_length;
+
+    return true;
+}
@@ -0,0 +1,287 @@
+/*!
+ * PacketReplayer.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "PacketReplayer.h"
+#include "FrameReceiverDefaults.h"
+#include "gettime.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace FrameReceiver;
+
+namespace
+{
+    uint64_t clock_mono_ns(void)
+    {
+        struct timespec ts;
+        gettime(&ts, true);
+        return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+    }
+
+    // Number of datagrams replayed between checks for timed out frames
+    const uint64_t timeout_check_packets = 64;
+}
+
+//! Constructor - sets up the replay of captured datagrams into a frame decoder.
+//!
+//! The decoder must have a buffer manager and frame ready callback registered, as for an RX thread.
+//!
+//! \param logger - logger instance
+//! \param frame_decoder - decoder to replay datagrams into
+//! \param batch_size - maximum datagrams per process_packets() call, 1 to use the per-packet methods
+//! \param speed - replay rate relative to the original capture, 0 to replay as fast as possible
+
+PacketReplayer::PacketReplayer(LoggerPtr& logger, FrameDecoderPtr frame_decoder, unsigned int batch_size,
+        double speed) :
+        logger_(logger),
+        frame_decoder_(frame_decoder),
+        batch_size_(batch_size ? batch_size : 1),
+        speed_(speed),
+        header_size_(frame_decoder->get_packet_header_size()),
+        payload_size_(frame_decoder->get_max_payload_size()),
+        batch_depth_(0),
+        timing_started_(false),
+        pacing_start_ns_(0),
+        replay_start_ns_(0),
+        replay_end_ns_(0),
+        packets_(0),
+        bytes_(0),
+        truncated_(0)
+{
+    if (batch_size_ <= 1)
+    {
+        return;
+    }
+
+    // Stage batched datagrams as the RX thread does for recvmmsg
+    batch_datagrams_.resize(batch_size_);
+    batch_from_addrs_.resize(batch_size_);
+    batch_headers_.resize(batch_size_ * header_size_);
+    batch_payloads_.resize(batch_size_ * payload_size_);
+
+    for (unsigned int msg = 0; msg < batch_size_; msg++)
+    {
+        batch_datagrams_[msg].header    = &batch_headers_[msg * header_size_];
+        batch_datagrams_[msg].payload   = &batch_payloads_[msg * payload_size_];
+        batch_datagrams_[msg].from_addr = &batch_from_addrs_[msg];
+    }
+}
+
+//! Restricts the replay to datagrams sent to the specified ports
+//!
+//! \param ports - destination ports to replay datagrams for, all ports if empty
+
+void PacketReplayer::set_ports(const std::vector<uint16_t>& ports)
+{
+    ports_ = ports;
+}
+
+//! Replays the datagrams from a capture file reader into the decoder
+//!
+//! Replay starts from the current position of the reader, so a capture can be replayed repeatedly
+//! by rewinding the reader in between. Each replay is paced relative to its first datagram, while
+//! the counters and elapsed time accumulate over all replays.
+//!
+//! \param reader - reader of the capture file
+
+void PacketReplayer::replay(PacketCaptureReader& reader)
+{
+    CapturedDatagram datagram;
+    uint64_t last_timeout_check_ns = clock_mono_ns();
+    timing_started_ = false;
+
+    while (reader.read(datagram))
+    {
+        if (!handles_port(datagram.port))
+        {
+            continue;
+        }
+
+        if (!timing_started_)
+        {
+            capture_start_ = datagram.timestamp;
+            pacing_start_ns_ = clock_mono_ns();
+            if (packets_ == 0)
+            {
+                replay_start_ns_ = pacing_start_ns_;
+            }
+            timing_started_ = true;
+        }
+
+        wait_until(datagram);
+
+        if (datagram.length < datagram.original_length)
+        {
+            truncated_++;
+        }
+
+        if (batch_size_ > 1)
+        {
+            stage_packet(datagram);
+        }
+        else
+        {
+            inject_packet(datagram);
+        }
+
+        packets_++;
+        bytes_ += datagram.length;
+
+        // Check for timed out frames at the same interval as the RX thread
+        if ((packets_ % timeout_check_packets) == 0)
+        {
+            uint64_t now_ns = clock_mono_ns();
+            if ((now_ns - last_timeout_check_ns) >= ((uint64_t)Defaults::default_frame_timeout_check_ms * 1000000))
+            {
+                flush_batch();
+                frame_decoder_->check_frame_timeouts();
+                last_timeout_check_ns = now_ns;
+            }
+        }
+    }
+
+    flush_batch();
+    frame_decoder_->check_frame_timeouts();
+    replay_end_ns_ = clock_mono_ns();
+
+    LOG4CXX_DEBUG_LEVEL(1, logger_, "Replayed " << packets_ << " datagrams (" << bytes_ << " bytes) in "
+            << get_elapsed_secs() << " secs, " << truncated_ << " truncated in capture, "
+            << reader.get_num_skipped() << " non-UDP records skipped");
+}
+
+//! Replays the datagrams in a capture file into the decoder
+//!
+//! \param file_name - name of the capture file
+
+void PacketReplayer::replay(const std::string& file_name)
+{
+    PacketCaptureReader reader(file_name);
+    replay(reader);
+}
+
+//! Returns the number of datagrams replayed
+
+uint64_t PacketReplayer::get_num_packets(void) const
+{
+    return packets_;
+}
+
+//! Returns the number of datagram bytes replayed
+
+uint64_t PacketReplayer::get_num_bytes(void) const
+{
+    return bytes_;
+}
+
+//! Returns the number of datagrams replayed that were truncated in the capture
+
+uint64_t PacketReplayer::get_num_truncated(void) const
+{
+    return truncated_;
+}
+
+//! Returns the time taken between replaying the first and last datagrams
+
+double PacketReplayer::get_elapsed_secs(void) const
+{
+    return (double)(replay_end_ns_ - replay_start_ns_) / 1000000000;
+}
+
+bool PacketReplayer::handles_port(int port) const
+{
+    return ports_.empty() || (std::find(ports_.begin(), ports_.end(), port) != ports_.end());
+}
+
+//! Waits until a datagram is due to be replayed, handing any batch staged meanwhile to the decoder
+
+void PacketReplayer::wait_until(const CapturedDatagram& datagram)
+{
+    if (speed_ <= 0.0)
+    {
+        return;
+    }
+
+    int64_t capture_offset_ns = ((int64_t)(datagram.timestamp.tv_sec - capture_start_.tv_sec) * 1000000000) +
+            (datagram.timestamp.tv_nsec - capture_start_.tv_nsec);
+    if (capture_offset_ns <= 0)
+    {
+        return;
+    }
+
+    uint64_t due_ns = pacing_start_ns_ + (uint64_t)(capture_offset_ns / speed_);
+    uint64_t now_ns = clock_mono_ns();
+    if (now_ns >= due_ns)
+    {
+        return;
+    }
+
+    // Datagrams received together are delivered together, as a socket wakeup would
+    flush_batch();
+
+    uint64_t wait_ns = due_ns - now_ns;
+    struct timespec wait_time;
+    wait_time.tv_sec  = wait_ns / 1000000000;
+    wait_time.tv_nsec = wait_ns % 1000000000;
+    nanosleep(&wait_time, 0);
+}
+
+//! Hands a datagram to the decoder through the per-packet methods, as the single datagram receive
+//! of the RX thread does
+
+void PacketReplayer::inject_packet(const CapturedDatagram& datagram)
+{
+    struct sockaddr_in from_addr = datagram.from_addr;
+    bool header_peek = frame_decoder_->requires_header_peek();
+
+    size_t header_bytes = std::min(datagram.length, header_size_);
+    memcpy(frame_decoder_->get_packet_header_buffer(), datagram.data, header_bytes);
+
+    if (header_peek)
+    {
+        frame_decoder_->process_packet_header(header_bytes, datagram.port, &from_addr);
+    }
+
+    // As with recvmsg, the payload is truncated to the size offered by the decoder
+    size_t payload_bytes = std::min(datagram.length - header_bytes, frame_decoder_->get_next_payload_size());
+    memcpy(frame_decoder_->get_next_payload_buffer(), datagram.data + header_bytes, payload_bytes);
+
+    size_t bytes_received = header_bytes + payload_bytes;
+    if (!header_peek)
+    {
+        frame_decoder_->process_packet_header(bytes_received, datagram.port, &from_addr);
+    }
+
+    frame_decoder_->process_packet(bytes_received);
+}
+
+//! Stages a datagram in the current batch, handing the batch to the decoder once full
+
+void PacketReplayer::stage_packet(const CapturedDatagram& datagram)
+{
+    size_t header_bytes = std::min(datagram.length, header_size_);
+    size_t payload_bytes = std::min(datagram.length - header_bytes, payload_size_);
+
+    memcpy(&batch_headers_[batch_depth_ * header_size_], datagram.data, header_bytes);
+    memcpy(&batch_payloads_[batch_depth_ * payload_size_], datagram.data + header_bytes, payload_bytes);
+    batch_from_addrs_[batch_depth_] = datagram.from_addr;
+    batch_datagrams_[batch_depth_].bytes_received = header_bytes + payload_bytes;
+    batch_datagrams_[batch_depth_].port = datagram.port;
+
+    if (++batch_depth_ == batch_size_)
+    {
+        flush_batch();
+    }
+}
+
+void PacketReplayer::flush_batch(void)
+{
+    if (batch_depth_)
+    {
+        frame_decoder_->process_packets(&batch_datagrams_[0], batch_depth_);
+        batch_depth_ = 0;
+    }
+}
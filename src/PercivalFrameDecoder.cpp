@@ -0,0 +1,732 @@
+/*
+ * PercivalFrameDecoder.cpp
+ *
+ *  Created on: Feb 24, 2015
+ *      Author: tcn45
+ */
+
+#include "PercivalFrameDecoder.h"
+#include "PercivalEmulatorFrameDecoder.h"
+#include "gettime.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <arpa/inet.h>
+
+#include <boost/bind.hpp>
+
+using namespace FrameReceiver;
+
+// Branch prediction hints for the packet validation checks, which almost never fail
+#define PACKET_LIKELY(x)   __builtin_expect(!!(x), 1)
+#define PACKET_UNLIKELY(x) __builtin_expect(!!(x), 0)
+
+namespace
+{
+    const char* packet_drop_reason_names[] = {"short", "bad type", "bad subframe", "bad packet number", "duplicate",
+            "no buffer", "truncated"};
+}
+
+template<class GeometryTraits>
+PercivalFrameDecoder<GeometryTraits>::PercivalFrameDecoder(LoggerPtr& logger,
+        bool enable_packet_logging, unsigned int frame_timeout_ms) :
+        FrameDecoder(logger, enable_packet_logging),
+		next_payload_location_(0),
+		next_payload_size_(primary_packet_size),
+		packets_relocated_(0),
+		current_frame_seen_(-1),
+		current_release_count_(0),
+		current_frame_buffer_id_(-1),
+		current_frame_buffer_(0),
+		current_frame_header_(0),
+		writing_frame_buffer_(false),
+		dropping_frame_data_(false),
+		frames_dropped_(0),
+		frame_timeout_ms_(frame_timeout_ms),
+		frames_timedout_(0),
+		current_packet_(),
+		current_packet_valid_(false),
+		packets_dropped_(),
+		frame_header_initialiser_(boost::bind(&PercivalFrameDecoder::initialise_buffer, this, _1, _2, _3))
+{
+    current_packet_header_.reset(new uint8_t[sizeof(PacketHeader)]);
+    dropped_frame_header_.reset(new FrameHeader);
+    staging_payload_buffer_.reset(new uint8_t[primary_packet_size]);
+
+    reset_payload_prediction();
+
+    if (enable_packet_logging_) {
+        LOG4CXX_INFO(packet_logger_, "PktHdr: SourceAddress");
+        LOG4CXX_INFO(packet_logger_, "PktHdr: |               SourcePort");
+        LOG4CXX_INFO(packet_logger_, "PktHdr: |               |     DestinationPort");
+        LOG4CXX_INFO(packet_logger_, "PktHdr: |               |     |      PacketType [1 Byte]");
+        LOG4CXX_INFO(packet_logger_, "PktHdr: |               |     |      |  SubframeNumber [1 Byte]");
+        LOG4CXX_INFO(packet_logger_, "PktHdr: |               |     |      |  |  FrameNumber [4 Bytes]");
+        LOG4CXX_INFO(packet_logger_, "PktHdr: |               |     |      |  |  |           PacketNumber [2 Bytes]");
+        LOG4CXX_INFO(packet_logger_, "PktHdr: |               |     |      |  |  |           |       Info [14 Bytes]");
+        LOG4CXX_INFO(packet_logger_, "PktHdr: |               |     |      |  |  |           |       |");
+    }
+}
+
+template<class GeometryTraits>
+PercivalFrameDecoder<GeometryTraits>::~PercivalFrameDecoder()
+{
+}
+
+template<class GeometryTraits>
+const size_t PercivalFrameDecoder<GeometryTraits>::get_frame_buffer_size(void) const
+{
+    return total_frame_size;
+}
+
+template<class GeometryTraits>
+const size_t PercivalFrameDecoder<GeometryTraits>::get_frame_header_size(void) const
+{
+    return sizeof(FrameHeader);
+}
+
+template<class GeometryTraits>
+const size_t PercivalFrameDecoder<GeometryTraits>::get_packet_header_size(void) const
+{
+    return sizeof(PacketHeader);
+}
+
+template<class GeometryTraits>
+void* PercivalFrameDecoder<GeometryTraits>::get_packet_header_buffer(void)
+{
+    return current_packet_header_.get();
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::process_packet_header(size_t bytes_received, int port, struct sockaddr_in* from_addr)
+{
+    if (enable_packet_logging_)
+    {
+        log_packet_header(raw_packet_header(), port, from_addr);
+    }
+
+    decode_packet_header(raw_packet_header(), current_packet_);
+    if (!accept_packet(bytes_received, (next_payload_size_ == 0)))
+    {
+        return;
+    }
+
+    // The payload has already been received into the location offered by get_next_payload_buffer().
+    // If that was not the correct destination for this packet, i.e. the packet arrived out of sequence
+    // or started a new frame, relocate the payload into place
+    uint8_t* payload_dest = payload_location(current_packet_.type, current_packet_.subframe, current_packet_.packet_number);
+    if (payload_dest != next_payload_location_)
+    {
+        memcpy(payload_dest, next_payload_location_, payload_bytes(bytes_received));
+        packets_relocated_++;
+    }
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::process_packets(const ReceivedDatagram* datagrams, size_t num_datagrams)
+{
+    // Each header is decoded once and the payload copied from its staging slot straight to its
+    // destination in the frame buffer, so no payload location prediction or relocation is needed
+    DecodedPacketHeader last_valid_packet = current_packet_;
+    bool batch_had_valid_packet = false;
+
+    for (size_t idx = 0; idx < num_datagrams; idx++)
+    {
+        const ReceivedDatagram& datagram = datagrams[idx];
+        const uint8_t* header = reinterpret_cast<const uint8_t*>(datagram.header);
+
+        if (PACKET_UNLIKELY(enable_packet_logging_))
+        {
+            log_packet_header(header, datagram.port, datagram.from_addr);
+        }
+
+        decode_packet_header(header, current_packet_);
+        if (accept_packet(datagram.bytes_received, false))
+        {
+            memcpy(payload_location(current_packet_.type, current_packet_.subframe, current_packet_.packet_number),
+                    datagram.payload, payload_bytes(datagram.bytes_received));
+        }
+
+        if (PACKET_LIKELY(current_packet_valid_))
+        {
+            complete_packet();
+            last_valid_packet = current_packet_;
+            batch_had_valid_packet = true;
+        }
+    }
+
+    // Predict the payload location following the last valid packet, should the per-packet methods
+    // be used next. As in process_packet(), dropped packets leave the prediction as is.
+    if (batch_had_valid_packet)
+    {
+        current_packet_ = last_valid_packet;
+        predict_next_payload_location();
+    }
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::log_packet_header(const uint8_t* header, int port, struct sockaddr_in* from_addr)
+{
+    std::stringstream ss;
+    const uint8_t* hdr_ptr = header;
+    ss << "PktHdr: " << std::setw(15) << std::left << inet_ntoa(from_addr->sin_addr) << std::right << " "
+       << std::setw(5) << ntohs(from_addr->sin_port) << " "
+       << std::setw(5) << port << std::hex;
+    for (unsigned int hdr_byte = 0; hdr_byte < sizeof(PacketHeader); hdr_byte++)
+    {
+        if (hdr_byte % 8 == 0) {
+            ss << "  ";
+        }
+        ss << std::setw(2) << std::setfill('0') << (unsigned int)*hdr_ptr << " ";
+        hdr_ptr++;
+    }
+    ss << std::dec;
+    LOG4CXX_INFO(packet_logger_, ss.str());
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::decode_packet_header(const uint8_t* header, DecodedPacketHeader& decoded)
+{
+    decoded.type          = header[Geometry::packet_type_offset];
+    decoded.subframe      = header[Geometry::subframe_number_offset];
+    decoded.frame_number  = ntohl(*reinterpret_cast<const uint32_t*>(header + Geometry::frame_number_offset));
+    decoded.packet_number = ntohs(*reinterpret_cast<const uint16_t*>(header + Geometry::packet_number_offset));
+}
+
+template<class GeometryTraits>
+bool PercivalFrameDecoder<GeometryTraits>::accept_packet(size_t bytes_received, bool payload_discarded)
+{
+	uint32_t frame = current_packet_.frame_number;
+	uint16_t packet_number = current_packet_.packet_number;
+	uint8_t  subframe = current_packet_.subframe;
+	uint8_t  type = current_packet_.type;
+
+	// Validate the packet before its header fields are used to locate the frame and payload, so
+	// that short or corrupted packets are dropped without acquiring or writing to a frame buffer
+	current_packet_valid_ = false;
+	if (PACKET_UNLIKELY(bytes_received < sizeof(PacketHeader)))
+	{
+	    drop_packet(PacketDropShort);
+	    return false;
+	}
+	if (PACKET_UNLIKELY(type >= num_data_types))
+	{
+	    drop_packet(PacketDropBadType);
+	    return false;
+	}
+	if (PACKET_UNLIKELY(subframe >= num_subframes))
+	{
+	    drop_packet(PacketDropBadSubframe);
+	    return false;
+	}
+	if (PACKET_UNLIKELY(packet_number >= num_subframe_packets))
+	{
+	    drop_packet(PacketDropBadPacketNumber);
+	    return false;
+	}
+
+	// Emulator firmware increments the frame number between sample and reset subframes, so as a
+	// workaround to allow matching to occur, increment frame number for sample packets
+	if (type == PacketTypeSample)
+	{
+	    frame += 1;
+	}
+
+    LOG4CXX_DEBUG_LEVEL(3, logger_, "Got packet header:"
+            << " type: "     << (int)type << " subframe: " << (int)subframe
+            << " packet: "   << packet_number    << " frame: "    << frame
+    );
+
+    // Look up the buffer for this frame when the frame number changes, or when a frame buffer has
+    // been released from the (possibly shared) frame buffer table since the last lookup. In a shared
+    // table another decoder may release the frame at any time, e.g. on timeout, so register as
+    // writing to the buffer and repeat the lookup if a buffer was released meanwhile. The frame is
+    // then not handed on until this packet has been written to it.
+    bool shared_table = frame_buffer_table_->is_shared();
+    while (true)
+    {
+        uint32_t release_count = frame_buffer_table_->get_release_count();
+        if ((frame != current_frame_seen_) || (release_count != current_release_count_))
+        {
+            lookup_frame_buffer(frame, release_count);
+        }
+        if (!shared_table || dropping_frame_data_ ||
+                frame_buffer_table_->begin_write(current_frame_buffer_id_, current_release_count_))
+        {
+            break;
+        }
+    }
+    writing_frame_buffer_ = shared_table && !dropping_frame_data_;
+
+    // If the payload was discarded by a truncated receive, in the expectation that the packet belonged
+    // to a frame being dropped, but the packet turns out to belong to a frame being received, the
+    // payload is lost and the packet must be dropped
+    if (PACKET_UNLIKELY(payload_discarded && !dropping_frame_data_))
+    {
+        end_frame_buffer_write();
+        drop_packet(PacketDropTruncated);
+        predict_next_payload_location();
+        return false;
+    }
+
+    // Mark the packet as received in the frame header, dropping duplicates so that they cannot
+    // complete the frame early or overwrite the payload already received
+    if (PACKET_UNLIKELY(current_frame_header_->packet_state.set(get_packet_index(type, subframe, packet_number))))
+    {
+        end_frame_buffer_write();
+        drop_packet(PacketDropDuplicate);
+        return false;
+    }
+    current_packet_valid_ = true;
+
+    // Packets of a dropped frame are only accounted in its frame header, their payload is discarded
+    if (PACKET_UNLIKELY(dropping_frame_data_))
+    {
+        packets_dropped_[PacketDropNoBuffer]++;
+        return false;
+    }
+
+    return true;
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::lookup_frame_buffer(uint32_t frame, uint32_t release_count)
+{
+    current_frame_seen_ = frame;
+    current_release_count_ = release_count;
+
+    int buffer_id = frame_buffer_table_->acquire_buffer(current_frame_seen_, frame_header_initialiser_);
+    if (buffer_id < 0)
+    {
+        // Frames without a free buffer are dropped, their packets being accounted in a private
+        // frame header. The lookup is repeated on buffer releases while dropping, so only start a
+        // new dropped frame when the frame number changes.
+        if (!dropping_frame_data_ || (dropped_frame_header_->frame_number != current_frame_seen_))
+        {
+            if (dropping_frame_data_)
+            {
+                log_dropped_frame();
+            }
+            else
+            {
+                LOG4CXX_ERROR(logger_, "First packet from frame " << current_frame_seen_ << " detected but no free buffers available. Dropping packet data for this frame");
+                dropping_frame_data_ = true;
+            }
+            initialise_frame_header(dropped_frame_header_.get(), current_frame_seen_);
+            frames_dropped_++;
+        }
+        current_frame_buffer_ = 0;
+        current_frame_header_ = dropped_frame_header_.get();
+    }
+    else
+    {
+        current_frame_buffer_id_ = buffer_id;
+        current_frame_buffer_ = buffer_manager_->get_buffer_address(current_frame_buffer_id_);
+        current_frame_header_ = reinterpret_cast<FrameHeader*>(buffer_manager_->get_metadata_address(current_frame_buffer_id_));
+
+        if (dropping_frame_data_)
+        {
+            log_dropped_frame();
+            dropping_frame_data_ = false;
+            LOG4CXX_DEBUG_LEVEL(2, logger_, "Free buffer now available for frame " << current_frame_seen_ << ", using frame buffer ID " << current_frame_buffer_id_);
+        }
+    }
+}
+
+//! Deregister as writing the current packet to a shared frame buffer, which must be done before
+//! the frame is released by this decoder, as the release waits for all writers to finish.
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::end_frame_buffer_write(void)
+{
+    if (writing_frame_buffer_)
+    {
+        frame_buffer_table_->end_write(current_frame_buffer_id_);
+        writing_frame_buffer_ = false;
+    }
+}
+
+template<class GeometryTraits>
+void* PercivalFrameDecoder<GeometryTraits>::get_next_payload_buffer(void) const
+{
+    return reinterpret_cast<void*>(next_payload_location_);
+}
+
+template<class GeometryTraits>
+size_t PercivalFrameDecoder<GeometryTraits>::get_next_payload_size(void) const
+{
+    // Payloads are received into a primary packet sized location, either a predicted frame buffer
+    // location or the staging buffer, unless the payload is to be discarded
+    return next_payload_size_;
+}
+
+template<class GeometryTraits>
+const size_t PercivalFrameDecoder<GeometryTraits>::get_max_payload_size(void) const
+{
+    return primary_packet_size;
+}
+
+template<class GeometryTraits>
+FrameDecoder::FrameReceiveState PercivalFrameDecoder<GeometryTraits>::process_packet(size_t bytes_received)
+{
+
+    FrameDecoder::FrameReceiveState frame_state = FrameDecoder::FrameReceiveStateIncomplete;
+
+    // Dropped packets are not counted and leave the predicted location of the next payload as is
+    if (PACKET_UNLIKELY(!current_packet_valid_))
+    {
+        return frame_state;
+    }
+
+	frame_state = complete_packet();
+
+	// Predict where the payload of the next packet should be received
+	predict_next_payload_location();
+
+	return frame_state;
+}
+
+template<class GeometryTraits>
+FrameDecoder::FrameReceiveState PercivalFrameDecoder<GeometryTraits>::complete_packet(void)
+{
+    FrameDecoder::FrameReceiveState frame_state = FrameDecoder::FrameReceiveStateIncomplete;
+
+	// Frame buffers may be shared with decoders in other RX threads, so count packets atomically
+	uint32_t packets_received = __sync_add_and_fetch(&(current_frame_header_->packets_received), 1);
+	end_frame_buffer_write();
+
+	if (packets_received == num_frame_packets)
+	{
+
+	    // Set frame state accordingly
+		frame_state = FrameDecoder::FrameReceiveStateComplete;
+
+		if (dropping_frame_data_)
+		{
+			current_frame_header_->frame_state = frame_state;
+		}
+		else
+		{
+			// Release frame from the buffer table and notify main thread that frame is ready, unless
+			// the frame has already timed out and been released
+			if (frame_buffer_table_->release_buffer(current_frame_seen_, current_frame_buffer_id_))
+			{
+				current_frame_header_->frame_state = frame_state;
+				ready_callback_(current_frame_buffer_id_, current_frame_seen_);
+			}
+
+			// Reset current frame seen ID so that if next frame has same number (e.g. repeated
+			// sends of single frame 0), it is detected properly
+			current_frame_seen_ = -1;
+		}
+	}
+
+	return frame_state;
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::monitor_buffers(void)
+{
+    check_frame_timeouts();
+
+    LOG4CXX_DEBUG_LEVEL(2, logger_, get_num_mapped_buffers() << " frame buffers in use, "
+            << get_num_empty_buffers() << " empty buffers available, "
+            << frames_timedout_ << " incomplete frames timed out, "
+            << frames_dropped_ << " frames dropped");
+
+    if (get_num_dropped_packets())
+    {
+        std::stringstream ss;
+        for (int reason = 0; reason < NumPacketDropReasons; reason++)
+        {
+            ss << " " << packet_drop_reason_names[reason] << ": " << packets_dropped_[reason];
+        }
+        LOG4CXX_DEBUG_LEVEL(1, logger_, "Packets dropped by reason:" << ss.str());
+    }
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::check_frame_timeouts(void)
+{
+    if (frame_deadlines_.empty())
+    {
+        return;
+    }
+
+    // Frames are acquired in order of start time and share the same timeout, so deadlines are
+    // queued in order and only the expired frames at the front of the queue need checking
+    int frames_timedout = 0;
+    uint64_t now_ns = clock_mono_ns();
+
+    while (!frame_deadlines_.empty() && (frame_deadlines_.front().deadline_ns <= now_ns))
+    {
+        uint32_t frame_num   = frame_deadlines_.front().frame_number;
+        int      buffer_id   = frame_deadlines_.front().buffer_id;
+        uint32_t acquisition = frame_deadlines_.front().acquisition;
+        frame_deadlines_.pop_front();
+
+        // Frames completed before their deadline have already been released from the table, and
+        // their buffer may since have been acquired again for the same frame number, which the
+        // acquisition number distinguishes. Decoders sharing the buffer table may also race to
+        // complete the frame, only the one releasing it from the table hands it on
+        if (!frame_buffer_table_->release_buffer(frame_num, buffer_id, acquisition))
+        {
+            continue;
+        }
+
+        void* buffer_addr = buffer_manager_->get_buffer_address(buffer_id);
+        FrameHeader* frame_header = reinterpret_cast<FrameHeader*>(buffer_manager_->get_metadata_address(buffer_id));
+
+        LOG4CXX_DEBUG_LEVEL(1, logger_, "Frame " << frame_num << " in buffer " << buffer_id
+                << " addr 0x" << std::hex << buffer_addr << std::dec
+                << " timed out with " << frame_header->packets_received << " packets received, first missing packet "
+                << frame_header->packet_state.find_missing(0));
+
+        frame_header->frame_state = FrameReceiveStateTimedout;
+        ready_callback_(buffer_id, frame_num);
+        frames_timedout++;
+
+        // If the timed out frame is the one currently being received, stop receiving into its
+        // buffer, which now belongs to the downstream processing
+        if (frame_num == current_frame_seen_)
+        {
+            current_frame_seen_ = -1;
+            reset_payload_prediction();
+        }
+    }
+
+    if (frames_timedout)
+    {
+        LOG4CXX_WARN(logger_, "Released " << frames_timedout << " timed out incomplete frames");
+    }
+    frames_timedout_ += frames_timedout;
+}
+
+template<class GeometryTraits>
+bool PercivalFrameDecoder<GeometryTraits>::get_frame_status(int buffer_id, FrameReceiveState& frame_state,
+        struct timespec& frame_start_time) const
+{
+    if (!buffer_manager_)
+    {
+        return false;
+    }
+
+    const FrameHeader* frame_header = reinterpret_cast<const FrameHeader*>(buffer_manager_->get_metadata_address(buffer_id));
+    frame_state = static_cast<FrameReceiveState>(frame_header->frame_state);
+    frame_start_time = frame_header->frame_start_time;
+
+    return true;
+}
+
+template<class GeometryTraits>
+size_t PercivalFrameDecoder<GeometryTraits>::get_missing_packets(int buffer_id, std::vector<PacketRange>& ranges) const
+{
+    if (!buffer_manager_)
+    {
+        ranges.clear();
+        return 0;
+    }
+
+    const FrameHeader* frame_header = reinterpret_cast<const FrameHeader*>(buffer_manager_->get_metadata_address(buffer_id));
+    return frame_header->packet_state.get_missing_ranges(ranges);
+}
+
+template<class GeometryTraits>
+uint8_t PercivalFrameDecoder<GeometryTraits>::get_packet_type(void) const
+{
+    return *(reinterpret_cast<uint8_t*>(raw_packet_header() + Geometry::packet_type_offset));
+}
+
+template<class GeometryTraits>
+uint8_t PercivalFrameDecoder<GeometryTraits>::get_subframe_number(void) const
+{
+    return *(reinterpret_cast<uint8_t*>(raw_packet_header() + Geometry::subframe_number_offset));
+}
+
+template<class GeometryTraits>
+uint16_t PercivalFrameDecoder<GeometryTraits>::get_packet_number(void) const
+{
+	uint16_t packet_number_raw = *(reinterpret_cast<uint16_t*>(raw_packet_header() + Geometry::packet_number_offset));
+    return ntohs(packet_number_raw);
+}
+
+template<class GeometryTraits>
+uint32_t PercivalFrameDecoder<GeometryTraits>::get_frame_number(void) const
+{
+	uint32_t frame_number_raw = *(reinterpret_cast<uint32_t*>(raw_packet_header() + Geometry::frame_number_offset));
+    return ntohl(frame_number_raw);
+}
+
+template<class GeometryTraits>
+const unsigned int PercivalFrameDecoder<GeometryTraits>::get_num_relocated_packets(void) const
+{
+    return packets_relocated_;
+}
+
+template<class GeometryTraits>
+const unsigned int PercivalFrameDecoder<GeometryTraits>::get_num_dropped_packets(PacketDropReason reason) const
+{
+    return packets_dropped_[reason];
+}
+
+template<class GeometryTraits>
+const unsigned int PercivalFrameDecoder<GeometryTraits>::get_num_dropped_frames(void) const
+{
+    return frames_dropped_;
+}
+
+template<class GeometryTraits>
+const unsigned int PercivalFrameDecoder<GeometryTraits>::get_num_dropped_packets(void) const
+{
+    unsigned int packets_dropped = 0;
+    for (int reason = 0; reason < NumPacketDropReasons; reason++)
+    {
+        packets_dropped += packets_dropped_[reason];
+    }
+    return packets_dropped;
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::log_dropped_frame(void)
+{
+    LOG4CXX_DEBUG_LEVEL(2, logger_, "Dropped frame " << dropped_frame_header_->frame_number << " after "
+            << dropped_frame_header_->packets_received << " packets received, "
+            << frames_dropped_ << " frames dropped in total");
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::drop_packet(PacketDropReason reason)
+{
+    packets_dropped_[reason]++;
+    LOG4CXX_DEBUG_LEVEL(3, logger_, "Dropping packet, reason: " << packet_drop_reason_names[reason]);
+}
+
+template<class GeometryTraits>
+uint8_t* PercivalFrameDecoder<GeometryTraits>::raw_packet_header(void) const
+{
+    return reinterpret_cast<uint8_t*>(current_packet_header_.get());
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::initialise_buffer(int buffer_id, uint32_t frame_number, uint32_t acquisition)
+{
+    LOG4CXX_DEBUG_LEVEL(2, logger_, "First packet from frame " << frame_number << " detected, allocating frame buffer ID " << buffer_id);
+    initialise_frame_header(reinterpret_cast<FrameHeader*>(buffer_manager_->get_metadata_address(buffer_id)), frame_number);
+
+    // Track the timeout deadline of the frame. Only the decoder acquiring the buffer tracks it,
+    // even if the buffer table is shared with other decoders
+    FrameDeadline deadline = {frame_number, buffer_id, acquisition, clock_mono_ns() + ((uint64_t)frame_timeout_ms_ * 1000000)};
+    frame_deadlines_.push_back(deadline);
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::initialise_frame_header(FrameHeader* frame_header, uint32_t frame_number)
+{
+    frame_header->frame_number = frame_number;
+    frame_header->frame_state = FrameDecoder::FrameReceiveStateIncomplete;
+    frame_header->packets_received = 0;
+    frame_header->packet_state.clear();
+
+    gettime(reinterpret_cast<struct timespec*>(&(frame_header->frame_start_time)));
+}
+
+template<class GeometryTraits>
+uint8_t* PercivalFrameDecoder<GeometryTraits>::payload_location(uint8_t type, uint8_t subframe, uint16_t packet_number) const
+{
+    return reinterpret_cast<uint8_t*>(current_frame_buffer_) + Geometry::payload_offset(type, subframe, packet_number);
+}
+
+template<class GeometryTraits>
+size_t PercivalFrameDecoder<GeometryTraits>::payload_bytes(size_t bytes_received) const
+{
+    // Never copy more than the payload size of the current packet, so that an oversized datagram
+    // cannot overrun its location in the frame
+    size_t payload_received = bytes_received - sizeof(PacketHeader);
+    size_t payload_size = Geometry::payload_size(current_packet_.packet_number);
+    return (payload_received < payload_size) ? payload_received : payload_size;
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::predict_next_payload_location(void)
+{
+    // Without a frame in progress there is nothing to predict, so receive into the staging buffer
+    if (current_frame_seen_ == (uint32_t)-1)
+    {
+        reset_payload_prediction();
+        return;
+    }
+
+    // Assume the next packet follows the current one in sequence through the packets, subframes
+    // and data types of the frame
+    unsigned int type = current_packet_.type;
+    unsigned int subframe = current_packet_.subframe;
+    unsigned int packet_number = current_packet_.packet_number + 1;
+
+    if (packet_number >= num_subframe_packets)
+    {
+        packet_number = 0;
+        if (++subframe >= num_subframes)
+        {
+            subframe = 0;
+            type++;
+        }
+    }
+
+    // While dropping a frame, discard the payload of the next packet if it is expected to belong to
+    // the same frame, shedding the cost of receiving the payload of packets that will be dropped
+    if (dropping_frame_data_)
+    {
+        if (type < num_data_types)
+        {
+            next_payload_location_ = reinterpret_cast<uint8_t*>(staging_payload_buffer_.get());
+            next_payload_size_ = 0;
+        }
+        else
+        {
+            reset_payload_prediction();
+        }
+        return;
+    }
+
+    // When the frame buffer table is shared, another RX thread may complete or time out the frame
+    // and hand its buffer on while the next receive is pending, so payloads are received into the
+    // staging buffer and copied into place once the buffer mapping has been checked
+    if (frame_buffer_table_->is_shared())
+    {
+        reset_payload_prediction();
+        return;
+    }
+
+    // Only predict locations of primary packets within this frame that have not yet been received,
+    // so that a mispredicted payload can never overwrite received data or overrun the location
+    if ((type < num_data_types) && (packet_number < num_primary_packets) &&
+        !current_frame_header_->packet_state.test(get_packet_index(type, subframe, packet_number)))
+    {
+        next_payload_location_ = payload_location(type, subframe, packet_number);
+        next_payload_size_ = primary_packet_size;
+    }
+    else
+    {
+        reset_payload_prediction();
+    }
+}
+
+template<class GeometryTraits>
+void PercivalFrameDecoder<GeometryTraits>::reset_payload_prediction(void)
+{
+    next_payload_location_ = reinterpret_cast<uint8_t*>(staging_payload_buffer_.get());
+    next_payload_size_ = primary_packet_size;
+}
+
+
+template<class GeometryTraits>
+uint64_t PercivalFrameDecoder<GeometryTraits>::clock_mono_ns(void)
+{
+    struct timespec ts;
+    gettime(&ts, true);
+
+    return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+// Explicit instantiations of the decoder for the detector geometries in use
+template class FrameReceiver::PercivalFrameDecoder<PercivalEmulatorGeometry>;
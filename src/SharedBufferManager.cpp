@@ -6,15 +6,36 @@
  */
 
 #include "SharedBufferManager.h"
+#include "ThreadPlacement.h"
 
 #include <iostream>
 #include <sstream>
+#include <cstring>
+#include <fstream>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// Populate (prefault) pages writably, available in Linux 5.14 onwards
+#if defined(__linux__) && !defined(MADV_POPULATE_WRITE)
+#define MADV_POPULATE_WRITE 23
+#endif
 
 using namespace FrameReceiver;
 using namespace boost::interprocess;
 
+namespace
+{
+    // Round a size or offset up to a multiple of the specified power of two alignment
+    size_t align_up(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
 SharedBufferManager::SharedBufferManager(const std::string& shared_mem_name, const size_t shared_mem_size,
-        const size_t buffer_size, bool remove_when_deleted) try :
+        const size_t buffer_size, bool remove_when_deleted, const size_t aux_size,
+        const size_t metadata_size) try :
     shared_mem_name_(shared_mem_name),
     shared_mem_size_(shared_mem_size),
     remove_when_deleted_(remove_when_deleted),
@@ -22,12 +43,6 @@ SharedBufferManager::SharedBufferManager(const std::string& shared_mem_name, con
     manager_hdr_(0)
 {
 
-    // Set the size of the shared memory object
-    shared_mem_.truncate(sizeof(Header) + shared_mem_size_);
-
-    // Map the whole shared memory region into this process
-    shared_mem_region_ = mapped_region(shared_mem_, read_write);
-
     // Determine how many buffers of the requested size fit into the shared memory region
     size_t num_buffers = shared_mem_size_ / buffer_size;
     if (!num_buffers)
@@ -35,11 +50,30 @@ SharedBufferManager::SharedBufferManager(const std::string& shared_mem_name, con
         throw SharedBufferManagerException("Buffer size requested exceeds size of shared memory");
     }
 
+    // Lay out the metadata slots, page aligned buffer slots and auxiliary region after the header,
+    // and set the size of the shared memory object accordingly
+    size_t metadata_offset = align_up(sizeof(Header), metadata_alignment);
+    size_t metadata_stride = align_up(metadata_size, metadata_alignment);
+    size_t buffer_offset = align_up(metadata_offset + (num_buffers * metadata_stride), buffer_alignment);
+    size_t buffer_stride = align_up(buffer_size, buffer_alignment);
+    size_t aux_offset = buffer_offset + (num_buffers * buffer_stride);
+    shared_mem_.truncate(aux_offset + aux_size);
+
+    // Map the whole shared memory region into this process
+    shared_mem_region_ = mapped_region(shared_mem_, read_write);
+
     // Initialise the buffer manager header
     manager_hdr_ = reinterpret_cast<Header*>(shared_mem_region_.get_address());
     manager_hdr_->manager_id = last_manager_id++;
     manager_hdr_->num_buffers = num_buffers;
     manager_hdr_->buffer_size = buffer_size;
+    manager_hdr_->magic = layout_magic;
+    manager_hdr_->version = layout_version;
+    manager_hdr_->metadata_offset = metadata_offset;
+    manager_hdr_->metadata_stride = metadata_stride;
+    manager_hdr_->buffer_offset = buffer_offset;
+    manager_hdr_->buffer_stride = buffer_stride;
+    manager_hdr_->aux_offset = aux_offset;
 
 }
 catch (interprocess_exception& e)
@@ -62,8 +96,15 @@ SharedBufferManager::SharedBufferManager(const std::string& shared_mem_name) try
     // Determine how big the region is
     shared_mem_size_ = shared_mem_region_.get_size();
 
-    // Map the buffer manager header
+    // Map the buffer manager header and check the segment layout is compatible
     manager_hdr_ = reinterpret_cast<Header*>(shared_mem_region_.get_address());
+    if ((shared_mem_size_ < sizeof(Header)) || (manager_hdr_->magic != layout_magic) ||
+            (manager_hdr_->version != layout_version))
+    {
+        std::stringstream ss;
+        ss << "Shared memory " << shared_mem_name_ << " does not have a compatible shared buffer layout";
+        throw SharedBufferManagerException(ss.str());
+    }
 
 }
 catch (interprocess_exception& e)
@@ -104,7 +145,198 @@ void* SharedBufferManager::get_buffer_address(const unsigned int buffer) const
         ss << "Illegal buffer index specified: " << buffer;
         throw SharedBufferManagerException(ss.str());
     }
-    return reinterpret_cast<void *>(((char*)shared_mem_region_.get_address() + sizeof(Header)) + buffer * manager_hdr_->buffer_size);
+    return reinterpret_cast<void *>((char*)shared_mem_region_.get_address() + manager_hdr_->buffer_offset +
+            (buffer * manager_hdr_->buffer_stride));
+}
+
+//! Returns the address of the metadata slot of a buffer.
+//!
+//! Metadata slots hold per-buffer data apart from the buffer itself, e.g. the header of the frame
+//! received into the buffer, and are padded to a multiple of a cache line.
+//!
+//! \param buffer - index of the buffer
+//! \return address of the metadata slot
+
+void* SharedBufferManager::get_metadata_address(const unsigned int buffer) const
+{
+    if (buffer >= manager_hdr_->num_buffers)
+    {
+        std::stringstream ss;
+        ss << "Illegal buffer index specified: " << buffer;
+        throw SharedBufferManagerException(ss.str());
+    }
+    if (!manager_hdr_->metadata_stride)
+    {
+        throw SharedBufferManagerException("Shared buffer has no metadata slots");
+    }
+    return reinterpret_cast<void *>((char*)shared_mem_region_.get_address() + manager_hdr_->metadata_offset +
+            (buffer * manager_hdr_->metadata_stride));
+}
+
+//! Returns the size of each metadata slot, including padding, or 0 if there are none
+
+const size_t SharedBufferManager::get_metadata_size(void) const
+{
+    return manager_hdr_->metadata_stride;
+}
+
+//! Returns the address of the auxiliary region of the shared memory.
+//!
+//! The auxiliary region follows the last buffer and extends to the end of the shared memory. It
+//! holds data shared with processes mapping the buffers, e.g. frame notification rings.
+//!
+//! \return address of the auxiliary region, or 0 if there is none
+
+void* SharedBufferManager::get_aux_address(void) const
+{
+    if (!get_aux_size())
+    {
+        return 0;
+    }
+    return reinterpret_cast<void*>((char*)shared_mem_region_.get_address() + manager_hdr_->aux_offset);
+}
+
+//! Returns the size of the auxiliary region of the shared memory, or 0 if there is none
+
+const size_t SharedBufferManager::get_aux_size(void) const
+{
+    size_t aux_offset = manager_hdr_->aux_offset;
+    return (shared_mem_region_.get_size() > aux_offset) ? (shared_mem_region_.get_size() - aux_offset) : 0;
+}
+
+void SharedBufferManager::bind_numa_node(const int numa_node)
+{
+    // Bind the whole mapped region, moving any pages already allocated on other nodes
+    int rc = bind_memory_to_numa_node(shared_mem_region_.get_address(), shared_mem_region_.get_size(), numa_node);
+    if (rc != 0)
+    {
+        std::stringstream ss;
+        ss << "Failed to bind shared buffer memory to NUMA node " << numa_node << ": " << strerror(rc);
+        throw SharedBufferManagerException(ss.str());
+    }
+}
+
+//! Advise the kernel to back the shared memory with transparent huge pages.
+//!
+//! Huge pages reduce the number of page faults taken on first writing each frame buffer and the TLB
+//! misses while receiving into it. Shared memory is only backed with huge pages if enabled for the
+//! host in /sys/kernel/mm/transparent_hugepage/shmem_enabled, which can be checked with
+//! get_memory_stats() once the memory is faulted in.
+
+void SharedBufferManager::advise_huge_pages(void)
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (madvise(shared_mem_region_.get_address(), shared_mem_region_.get_size(), MADV_HUGEPAGE) != 0)
+    {
+        std::stringstream ss;
+        ss << "Failed to advise huge pages for shared buffer memory: " << strerror(errno);
+        throw SharedBufferManagerException(ss.str());
+    }
+#else
+    throw SharedBufferManagerException("Huge pages for shared buffer memory are not supported on this platform");
+#endif
+}
+
+//! Fault in the whole shared memory, so that no page faults are taken when frames are first
+//! received into the buffers. Any existing contents of the memory are preserved.
+
+void SharedBufferManager::prefault(void)
+{
+#ifdef __linux__
+    if (madvise(shared_mem_region_.get_address(), shared_mem_region_.get_size(), MADV_POPULATE_WRITE) == 0)
+    {
+        return;
+    }
+#endif
+
+    // Fall back to writing each page in turn where populating is not supported by the kernel
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    volatile char* mem = reinterpret_cast<volatile char*>(shared_mem_region_.get_address());
+    for (size_t offset = 0; offset < shared_mem_region_.get_size(); offset += page_size)
+    {
+        mem[offset] = mem[offset];
+    }
+}
+
+//! Lock the whole shared memory into RAM, preventing it being paged out. This requires the memory
+//! lock resource limit (RLIMIT_MEMLOCK) of the process to exceed the size of the shared memory.
+
+void SharedBufferManager::lock_memory(void)
+{
+    if (mlock(shared_mem_region_.get_address(), shared_mem_region_.get_size()) != 0)
+    {
+        std::stringstream ss;
+        ss << "Failed to lock shared buffer memory: " << strerror(errno);
+        if (errno == ENOMEM || errno == EPERM)
+        {
+            ss << " (check the memory lock limit, ulimit -l)";
+        }
+        throw SharedBufferManagerException(ss.str());
+    }
+}
+
+//! Returns memory statistics of the shared memory mapping in this process.
+//!
+//! The statistics are read from /proc/self/smaps and indicate how much of the memory has been
+//! faulted in, locked and mapped with huge pages. Fields are zero if they cannot be determined.
+//!
+//! \return memory statistics of the mapping
+
+SharedBufferManager::MemoryStats SharedBufferManager::get_memory_stats(void) const
+{
+    MemoryStats stats;
+    memset(&stats, 0, sizeof(stats));
+    stats.mapped_size = shared_mem_region_.get_size();
+
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool in_mapping = false;
+    unsigned long mapping_start = reinterpret_cast<unsigned long>(shared_mem_region_.get_address());
+
+    // The mapping may have been split into several areas by the kernel, e.g. by partial locking,
+    // so accumulate the statistics of all areas within it. Area header lines start with the
+    // address range, field lines with a name and colon.
+    while (std::getline(smaps, line))
+    {
+        unsigned long range_start, range_end;
+        char dash;
+        std::istringstream line_stream(line);
+        if ((line.find(':') > line.find(' ')) && (line_stream >> std::hex >> range_start >> dash >> range_end))
+        {
+            in_mapping = (range_start >= mapping_start) && (range_start < mapping_start + stats.mapped_size);
+            continue;
+        }
+        if (!in_mapping)
+        {
+            continue;
+        }
+
+        std::string field;
+        size_t value_kb = 0;
+        line_stream.clear();
+        line_stream.str(line);
+        line_stream >> field >> std::dec >> value_kb;
+        size_t value = value_kb * 1024;
+
+        if (field == "Rss:")
+        {
+            stats.resident_size += value;
+        }
+        else if ((field == "ShmemPmdMapped:") || (field == "Shared_Hugetlb:") || (field == "Private_Hugetlb:"))
+        {
+            stats.huge_page_size += value;
+        }
+        else if (field == "Locked:")
+        {
+            stats.locked_size += value;
+        }
+        else if (field == "KernelPageSize:")
+        {
+            stats.kernel_page_size = value;
+        }
+    }
+
+    return stats;
 }
 
 size_t SharedBufferManager::last_manager_id = 0;
@@ -0,0 +1,133 @@
+/*!
+ * ThreadPlacement.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "ThreadPlacement.h"
+
+#include <fstream>
+#include <cstring>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <ifaddrs.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace FrameReceiver
+{
+
+int set_thread_affinity(int cpu)
+{
+#ifdef __linux__
+    if ((cpu < 0) || (cpu >= CPU_SETSIZE))
+    {
+        return EINVAL;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#else
+    return ENOTSUP;
+#endif
+}
+
+int set_thread_realtime_priority(int priority)
+{
+    if ((priority < sched_get_priority_min(SCHED_FIFO)) || (priority > sched_get_priority_max(SCHED_FIFO)))
+    {
+        return EINVAL;
+    }
+
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+}
+
+int bind_memory_to_numa_node(void* addr, size_t length, int numa_node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    // Invoke mbind directly to avoid a dependency on libnuma; the constants are as defined in numaif.h
+    const int          mpol_bind     = 2;
+    const unsigned int mpol_mf_move  = (1 << 1);
+    const unsigned int mask_bits     = sizeof(unsigned long) * 8;
+
+    if ((numa_node < 0) || (numa_node >= static_cast<int>(mask_bits)))
+    {
+        return EINVAL;
+    }
+
+    // mbind requires a page-aligned start address
+    long page_size = sysconf(_SC_PAGESIZE);
+    unsigned long start = reinterpret_cast<unsigned long>(addr);
+    unsigned long aligned_start = start & ~(static_cast<unsigned long>(page_size) - 1);
+    length += (start - aligned_start);
+
+    unsigned long node_mask = (1UL << numa_node);
+    if (syscall(SYS_mbind, aligned_start, length, mpol_bind, &node_mask, mask_bits + 1, mpol_mf_move) != 0)
+    {
+        return errno;
+    }
+    return 0;
+#else
+    return ENOTSUP;
+#endif
+}
+
+int get_interface_numa_node(const std::string& ip_address)
+{
+    int numa_node = -1;
+
+#ifdef __linux__
+    struct in_addr address;
+    if ((inet_aton(ip_address.c_str(), &address) == 0) || (address.s_addr == INADDR_ANY))
+    {
+        return numa_node;
+    }
+
+    // Find the name of the interface with the specified address
+    struct ifaddrs* if_addrs = 0;
+    if (getifaddrs(&if_addrs) != 0)
+    {
+        return numa_node;
+    }
+
+    std::string if_name;
+    for (struct ifaddrs* if_addr = if_addrs; if_addr != 0; if_addr = if_addr->ifa_next)
+    {
+        if ((if_addr->ifa_addr != 0) && (if_addr->ifa_addr->sa_family == AF_INET) &&
+            (reinterpret_cast<struct sockaddr_in*>(if_addr->ifa_addr)->sin_addr.s_addr == address.s_addr))
+        {
+            if_name = if_addr->ifa_name;
+            break;
+        }
+    }
+    freeifaddrs(if_addrs);
+
+    // Read the NUMA node of the interface device from sysfs, virtual interfaces have no device
+    if (!if_name.empty())
+    {
+        std::string numa_node_path = "/sys/class/net/" + if_name + "/device/numa_node";
+        std::ifstream numa_node_file(numa_node_path.c_str());
+        if (!(numa_node_file >> numa_node))
+        {
+            numa_node = -1;
+        }
+    }
+#endif
+
+    return numa_node;
+}
+
+} // namespace FrameReceiver
@@ -0,0 +1,243 @@
+/*!
+ * FrameDecoderBench.cpp - microbenchmarks of the Percival emulator frame decoder
+ *
+ * Synthetic packet headers for whole frames are fed straight into the decoder without sockets.
+ * Frame buffers are released back to the decoder as soon as frames are ready, as by a processor
+ * keeping up with the receiver.
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameReceiverBench.h"
+#include "PercivalEmulatorFrameDecoder.h"
+#include "SharedBufferManager.h"
+
+#include <cstring>
+#include <sstream>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+#include <boost/bind.hpp>
+
+using namespace FrameReceiver;
+using namespace FrameReceiverBench;
+
+namespace
+{
+    typedef PercivalEmulatorFrameDecoder Decoder;
+    typedef Decoder::Geometry Geometry;
+
+    const size_t num_frame_buffers = 4;
+    const size_t process_packets_batch_size = 64;
+
+    //! DecoderBenchmark - base of the decoder benchmarks, holding a decoder with frame buffers and
+    //! the packet headers of a frame in the order sent by the emulator
+    class DecoderBenchmark : public Benchmark
+    {
+    public:
+        DecoderBenchmark(const std::string& name) :
+            Benchmark(name),
+            logger_(Logger::getLogger("FrameReceiverBench")),
+            frame_number_(1)
+        {
+            memset(&from_addr_, 0, sizeof(from_addr_));
+        }
+
+        void setup(void)
+        {
+            decoder_.reset(new Decoder(logger_));
+
+            std::stringstream buffer_name;
+            buffer_name << "FrameReceiverBenchBuffer_" << getpid();
+            buffer_manager_.reset(new SharedBufferManager(buffer_name.str(), num_frame_buffers * Geometry::total_frame_size,
+                    Geometry::total_frame_size, true, 0, sizeof(Decoder::FrameHeader)));
+            decoder_->register_buffer_manager(buffer_manager_);
+            decoder_->register_frame_ready_callback(boost::bind(&DecoderBenchmark::frame_ready, this, _1, _2));
+            for (size_t buffer_id = 0; buffer_id < num_frame_buffers; buffer_id++)
+            {
+                decoder_->push_empty_buffer(buffer_id);
+            }
+
+            headers_.resize(Geometry::num_frame_packets * Geometry::packet_header_size);
+            payloads_.resize(Geometry::primary_packet_size);
+            frame_number_ = 1;
+            build_frame_headers();
+        }
+
+        void teardown(void)
+        {
+            decoder_.reset();
+            buffer_manager_.reset();
+        }
+
+    protected:
+
+        //! Writes the packet headers of the next frame, sample packets carrying the preceding frame
+        //! number as sent by the emulator firmware
+        void build_frame_headers(void)
+        {
+            for (unsigned int type = 0; type < Geometry::num_data_types; type++)
+            {
+                for (unsigned int subframe = 0; subframe < Geometry::num_subframes; subframe++)
+                {
+                    for (unsigned int packet_number = 0; packet_number < Geometry::num_subframe_packets; packet_number++)
+                    {
+                        uint8_t* header = packet_header(Geometry::packet_index(type, subframe, packet_number));
+                        uint32_t frame_number_be = htonl((type == Decoder::PacketTypeSample) ? frame_number_ - 1 : frame_number_);
+                        uint16_t packet_number_be = htons(packet_number);
+                        memset(header, 0, Geometry::packet_header_size);
+                        header[Geometry::packet_type_offset] = type;
+                        header[Geometry::subframe_number_offset] = subframe;
+                        memcpy(header + Geometry::frame_number_offset, &frame_number_be, sizeof(frame_number_be));
+                        memcpy(header + Geometry::packet_number_offset, &packet_number_be, sizeof(packet_number_be));
+                    }
+                }
+            }
+        }
+
+        //! Advances the headers to the next frame, rewriting only the frame numbers
+        void next_frame(void)
+        {
+            frame_number_++;
+            for (size_t packet = 0; packet < Geometry::num_frame_packets; packet++)
+            {
+                uint8_t* header = packet_header(packet);
+                uint32_t frame_number_be = htonl((header[Geometry::packet_type_offset] == Decoder::PacketTypeSample) ?
+                        frame_number_ - 1 : frame_number_);
+                memcpy(header + Geometry::frame_number_offset, &frame_number_be, sizeof(frame_number_be));
+            }
+        }
+
+        uint8_t* packet_header(size_t packet)
+        {
+            return &headers_[packet * Geometry::packet_header_size];
+        }
+
+        size_t packet_size(size_t packet) const
+        {
+            return Geometry::packet_header_size + Geometry::payload_size(packet % Geometry::num_subframe_packets);
+        }
+
+        void frame_ready(int buffer_id, int frame_number)
+        {
+            decoder_->push_empty_buffer(buffer_id);
+        }
+
+        LoggerPtr                          logger_;
+        boost::shared_ptr<Decoder>         decoder_;
+        SharedBufferManagerPtr             buffer_manager_;
+        std::vector<uint8_t>               headers_;   //!< Packet headers of the current frame
+        std::vector<uint8_t>               payloads_;  //!< Payload source for batched datagrams
+        uint32_t                           frame_number_;
+        struct sockaddr_in                 from_addr_;
+    };
+
+    //! Decodes the packet headers of a frame in turn without completing the packets, measuring the
+    //! steady state cost of process_packet_header() within a frame
+    class DecoderProcessPacketHeaderBenchmark : public DecoderBenchmark
+    {
+    public:
+        DecoderProcessPacketHeaderBenchmark() : DecoderBenchmark("decoder.process_packet_header") { };
+
+        void run(size_t iterations)
+        {
+            uint8_t* header_buffer = reinterpret_cast<uint8_t*>(decoder_->get_packet_header_buffer());
+            size_t packet = 0;
+            for (size_t iter = 0; iter < iterations; iter++)
+            {
+                memcpy(header_buffer, packet_header(packet), Geometry::packet_header_size);
+                decoder_->process_packet_header(packet_size(packet), 0, &from_addr_);
+                if (++packet == Geometry::num_frame_packets)
+                {
+                    packet = 0;
+                }
+            }
+        }
+    };
+
+    //! Receives every packet of successive frames through the per-packet decoder methods, the
+    //! payload being left as received into the buffer offered by the decoder
+    class DecoderProcessPacketBenchmark : public DecoderBenchmark
+    {
+    public:
+        DecoderProcessPacketBenchmark() : DecoderBenchmark("decoder.process_packet") { };
+
+        void run(size_t iterations)
+        {
+            uint8_t* header_buffer = reinterpret_cast<uint8_t*>(decoder_->get_packet_header_buffer());
+            for (size_t iter = 0; iter < iterations; iter++)
+            {
+                size_t packet = packet_in_frame_++;
+                memcpy(header_buffer, packet_header(packet), Geometry::packet_header_size);
+                size_t bytes_received = packet_size(packet);
+                decoder_->process_packet_header(bytes_received, 0, &from_addr_);
+                decoder_->process_packet(bytes_received);
+
+                if (packet_in_frame_ == Geometry::num_frame_packets)
+                {
+                    next_frame();
+                    packet_in_frame_ = 0;
+                }
+            }
+        }
+
+        void setup(void)
+        {
+            DecoderBenchmark::setup();
+            packet_in_frame_ = 0;
+        }
+
+    private:
+        size_t packet_in_frame_;
+    };
+
+    //! Receives every packet of successive frames in batches through process_packets(), including
+    //! the copy of each payload into the frame buffer
+    class DecoderProcessPacketsBenchmark : public DecoderBenchmark
+    {
+    public:
+        DecoderProcessPacketsBenchmark() : DecoderBenchmark("decoder.process_packets.batch64") { };
+
+        void setup(void)
+        {
+            DecoderBenchmark::setup();
+            datagrams_.resize(Geometry::num_frame_packets);
+            for (size_t packet = 0; packet < Geometry::num_frame_packets; packet++)
+            {
+                datagrams_[packet].header         = packet_header(packet);
+                datagrams_[packet].payload        = &payloads_[0];
+                datagrams_[packet].bytes_received = packet_size(packet);
+                datagrams_[packet].port           = 0;
+                datagrams_[packet].from_addr      = &from_addr_;
+            }
+            packet_in_frame_ = 0;
+        }
+
+        //! Each operation is one packet, handed to the decoder in batches which do not span frames
+        void run(size_t iterations)
+        {
+            size_t remaining = iterations;
+            while (remaining)
+            {
+                size_t batch_depth = std::min(std::min(remaining, process_packets_batch_size), Geometry::num_frame_packets - packet_in_frame_);
+                decoder_->process_packets(&datagrams_[packet_in_frame_], batch_depth);
+                packet_in_frame_ += batch_depth;
+                remaining -= batch_depth;
+
+                if (packet_in_frame_ == Geometry::num_frame_packets)
+                {
+                    next_frame();
+                    packet_in_frame_ = 0;
+                }
+            }
+        }
+
+    private:
+        std::vector<ReceivedDatagram> datagrams_;
+        size_t packet_in_frame_;
+    };
+}
+
+FRAME_RECEIVER_BENCHMARK(DecoderProcessPacketHeaderBenchmark);
+FRAME_RECEIVER_BENCHMARK(DecoderProcessPacketBenchmark);
+FRAME_RECEIVER_BENCHMARK(DecoderProcessPacketsBenchmark);
@@ -0,0 +1,77 @@
+/*!
+ * FrameReceiverBench.h - microbenchmark framework for frame receiver components
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef FRAMERECEIVERBENCH_H_
+#define FRAMERECEIVERBENCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+namespace FrameReceiverBench
+{
+    //! Benchmark - a repeatable microbenchmark of a component operation
+    //!
+    //! Benchmarks are registered with the FRAME_RECEIVER_BENCHMARK macro. The runner calls setup()
+    //! once, then run() repeatedly with increasing numbers of operations to calibrate, and finally
+    //! for each timed repetition. Only run() is timed and has its allocations counted, so state
+    //! that is not part of the operation being measured should be created in setup().
+
+    class Benchmark
+    {
+    public:
+        Benchmark(const std::string& name) : name_(name) { };
+        virtual ~Benchmark() { };
+
+        //! Returns the name of the benchmark
+        const std::string& name(void) const { return name_; };
+
+        //! Prepares the state used by run(), outside the timed region
+        virtual void setup(void) { };
+        //! Performs the specified number of operations
+        virtual void run(size_t iterations) = 0;
+        //! Releases the state created by setup()
+        virtual void teardown(void) { };
+
+    private:
+        std::string name_;
+    };
+
+    typedef boost::shared_ptr<Benchmark> BenchmarkPtr;
+
+    //! Returns the registered benchmarks, in order of registration
+    std::vector<BenchmarkPtr>& registered_benchmarks(void);
+
+    //! Registers a benchmark class at static initialisation time
+    template<class BenchmarkClass>
+    struct BenchmarkRegistrar
+    {
+        BenchmarkRegistrar()
+        {
+            registered_benchmarks().push_back(BenchmarkPtr(new BenchmarkClass));
+        }
+    };
+
+    //! Returns the number of heap allocations made by the calling thread, or zero if allocations
+    //! are not counted on this platform
+    uint64_t thread_allocation_count(void);
+    bool allocations_counted(void);
+
+    //! Prevents the compiler from optimising away a computed value
+    template<typename T> inline void do_not_optimise(const T& value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+} // namespace FrameReceiverBench
+
+#define FRAME_RECEIVER_BENCHMARK(BenchmarkClass) \
+    static FrameReceiverBench::BenchmarkRegistrar<BenchmarkClass> BenchmarkClass##_registrar
+
+#endif /* FRAMERECEIVERBENCH_H_ */
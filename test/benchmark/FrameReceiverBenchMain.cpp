@@ -0,0 +1,373 @@
+/*!
+ * FrameReceiverBenchMain.cpp - frame receiver microbenchmark runner
+ *
+ * Runs the registered microbenchmarks, reporting the median time and the number of heap
+ * allocations per operation. Results can be saved to a baseline file and later runs compared
+ * against it, failing if any benchmark has slowed down by more than a tolerance or allocates more
+ * per operation.
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameReceiverBench.h"
+#include "DebugLevelLogger.h"
+#include "gettime.h"
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+
+#include <log4cxx/basicconfigurator.h>
+
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+using namespace FrameReceiverBench;
+
+extern void set_debug_level(DebugLevel level);
+
+// Heap allocations are counted per thread by interposing the C allocator, through which the C++
+// allocator also allocates, so that allocations by ZeroMQ background threads are not counted
+#if defined(__GLIBC__)
+extern "C"
+{
+    extern void* __libc_malloc(size_t size);
+    extern void* __libc_calloc(size_t num, size_t size);
+    extern void* __libc_realloc(void* ptr, size_t size);
+}
+
+namespace
+{
+    __thread uint64_t allocation_count = 0;
+}
+
+extern "C" void* malloc(size_t size)
+{
+    allocation_count++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t num, size_t size)
+{
+    allocation_count++;
+    return __libc_calloc(num, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size)
+{
+    allocation_count++;
+    return __libc_realloc(ptr, size);
+}
+
+uint64_t FrameReceiverBench::thread_allocation_count(void)
+{
+    return allocation_count;
+}
+
+bool FrameReceiverBench::allocations_counted(void)
+{
+    return true;
+}
+#else
+uint64_t FrameReceiverBench::thread_allocation_count(void)
+{
+    return 0;
+}
+
+bool FrameReceiverBench::allocations_counted(void)
+{
+    return false;
+}
+#endif
+
+std::vector<BenchmarkPtr>& FrameReceiverBench::registered_benchmarks(void)
+{
+    static std::vector<BenchmarkPtr> benchmarks;
+    return benchmarks;
+}
+
+namespace
+{
+    //! Results of a benchmark, per operation
+    typedef struct
+    {
+        std::string name;
+        size_t      iterations;     //!< Operations per timed repetition
+        double      ns_per_op;      //!< Median time per operation over the repetitions
+        double      min_ns_per_op;  //!< Minimum time per operation over the repetitions
+        double      allocs_per_op;  //!< Heap allocations per operation
+    } BenchmarkResult;
+
+    typedef std::map<std::string, BenchmarkResult> BaselineMap;
+
+    // Upper limit on operations per repetition, reached only by trivially cheap operations
+    const size_t max_iterations = 1000000000;
+
+    uint64_t clock_mono_ns(void)
+    {
+        struct timespec ts;
+        gettime(&ts, true);
+        return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+    }
+
+    uint64_t time_run(BenchmarkPtr benchmark, size_t iterations, uint64_t& allocations)
+    {
+        uint64_t allocations_start = thread_allocation_count();
+        uint64_t start_ns = clock_mono_ns();
+        benchmark->run(iterations);
+        uint64_t elapsed_ns = clock_mono_ns() - start_ns;
+        allocations = thread_allocation_count() - allocations_start;
+        return elapsed_ns;
+    }
+
+    //! Runs a benchmark, calibrating the number of operations so that each repetition takes at
+    //! least the minimum time
+    BenchmarkResult run_benchmark(BenchmarkPtr benchmark, double min_time_secs, unsigned int repetitions)
+    {
+        BenchmarkResult result;
+        result.name = benchmark->name();
+
+        benchmark->setup();
+
+        uint64_t min_time_ns = (uint64_t)(min_time_secs * 1.0e9);
+        uint64_t allocations = 0;
+        size_t iterations = 1;
+        while (iterations < max_iterations)
+        {
+            uint64_t elapsed_ns = time_run(benchmark, iterations, allocations);
+            if (elapsed_ns >= min_time_ns)
+            {
+                break;
+            }
+
+            // Scale towards the minimum time with some margin, growing by at most 100 times per step
+            size_t next_iterations = elapsed_ns ?
+                    (size_t)((double)iterations * 1.2 * min_time_ns / elapsed_ns) : iterations * 100;
+            iterations = std::max(iterations + 1, std::min(next_iterations, iterations * 100));
+        }
+        iterations = std::min(iterations, max_iterations);
+
+        std::vector<double> ns_per_op;
+        uint64_t total_allocations = 0;
+        for (unsigned int rep = 0; rep < repetitions; rep++)
+        {
+            uint64_t elapsed_ns = time_run(benchmark, iterations, allocations);
+            ns_per_op.push_back((double)elapsed_ns / iterations);
+            total_allocations += allocations;
+        }
+
+        benchmark->teardown();
+
+        std::sort(ns_per_op.begin(), ns_per_op.end());
+        result.iterations = iterations;
+        result.ns_per_op = ns_per_op[ns_per_op.size() / 2];
+        result.min_ns_per_op = ns_per_op[0];
+        result.allocs_per_op = (double)total_allocations / ((double)iterations * repetitions);
+
+        return result;
+    }
+
+    void save_results(const std::string& file_name, const std::vector<BenchmarkResult>& results)
+    {
+        std::ofstream results_file(file_name.c_str());
+        if (!results_file)
+        {
+            throw std::runtime_error("Failed to open results file " + file_name);
+        }
+        results_file << "# frameReceiverBench results: name ns_per_op allocs_per_op" << std::endl;
+        for (std::vector<BenchmarkResult>::const_iterator itr = results.begin(); itr != results.end(); ++itr)
+        {
+            results_file << itr->name << " " << itr->ns_per_op << " " << itr->allocs_per_op << std::endl;
+        }
+    }
+
+    BaselineMap load_baseline(const std::string& file_name)
+    {
+        std::ifstream baseline_file(file_name.c_str());
+        if (!baseline_file)
+        {
+            throw std::runtime_error("Failed to open baseline file " + file_name);
+        }
+
+        BaselineMap baseline;
+        std::string line;
+        while (std::getline(baseline_file, line))
+        {
+            if (line.empty() || (line[0] == '#'))
+            {
+                continue;
+            }
+            std::istringstream fields(line);
+            BenchmarkResult result;
+            if (fields >> result.name >> result.ns_per_op >> result.allocs_per_op)
+            {
+                baseline[result.name] = result;
+            }
+        }
+        return baseline;
+    }
+
+    //! Compares results against a baseline, returning the number of regressions
+    unsigned int compare_baseline(const std::vector<BenchmarkResult>& results, const BaselineMap& baseline,
+            double tolerance)
+    {
+        unsigned int regressions = 0;
+
+        std::cout << std::endl << std::left << std::setw(44) << "Benchmark" << std::right
+                  << std::setw(14) << "baseline ns" << std::setw(14) << "ns/op" << std::setw(10) << "change"
+                  << std::setw(16) << "allocs/op" << std::endl;
+
+        for (std::vector<BenchmarkResult>::const_iterator itr = results.begin(); itr != results.end(); ++itr)
+        {
+            BaselineMap::const_iterator base = baseline.find(itr->name);
+            if (base == baseline.end())
+            {
+                continue;
+            }
+
+            double change = (itr->ns_per_op - base->second.ns_per_op) / base->second.ns_per_op;
+            bool slower = change > tolerance;
+            // Allocations per operation are deterministic apart from amortised growth of containers
+            bool allocates_more = allocations_counted() && (itr->allocs_per_op > base->second.allocs_per_op + 0.01);
+
+            std::ostringstream allocs;
+            allocs << std::fixed << std::setprecision(2) << base->second.allocs_per_op << "->" << itr->allocs_per_op;
+
+            std::cout << std::left << std::setw(44) << itr->name << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(14) << base->second.ns_per_op << std::setw(14) << itr->ns_per_op
+                      << std::setw(9) << std::showpos << (change * 100.0) << std::noshowpos << "%"
+                      << std::setw(16) << allocs.str()
+                      << (slower || allocates_more ? "  REGRESSION" : "") << std::endl;
+
+            if (slower || allocates_more)
+            {
+                regressions++;
+            }
+        }
+
+        return regressions;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BasicConfigurator::configure();
+    Logger::getRootLogger()->setLevel(Level::getWarn());
+
+    std::string filter;
+    double min_time_secs;
+    unsigned int repetitions;
+    double tolerance;
+    po::variables_map vm;
+
+    try
+    {
+        po::options_description options("Options");
+        options.add_options()
+                ("help,h",
+                    "Print this help message")
+                ("list",
+                    "List the available benchmarks")
+                ("filter,f",      po::value<std::string>(&filter)->default_value(""),
+                    "Only run benchmarks whose name contains the specified string")
+                ("mintime",       po::value<double>(&min_time_secs)->default_value(0.2),
+                    "Set the minimum time in seconds of each timed repetition")
+                ("repetitions,r", po::value<unsigned int>(&repetitions)->default_value(5),
+                    "Set the number of timed repetitions of each benchmark")
+                ("save,s",        po::value<std::string>(),
+                    "Save the results to the specified baseline file")
+                ("baseline,b",    po::value<std::string>(),
+                    "Compare the results with the specified baseline file, failing on regressions")
+                ("tolerance,t",   po::value<double>(&tolerance)->default_value(0.1),
+                    "Set the fractional increase in time per operation counted as a regression")
+                ;
+
+        po::store(po::parse_command_line(argc, argv, options), vm);
+        po::notify(vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << "usage: frameReceiverBench [options]" << std::endl << std::endl << options << std::endl;
+            return 0;
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Error parsing options: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (repetitions == 0)
+    {
+        repetitions = 1;
+    }
+    set_debug_level(0);
+
+    std::vector<BenchmarkPtr>& benchmarks = registered_benchmarks();
+    if (vm.count("list"))
+    {
+        for (std::vector<BenchmarkPtr>::iterator itr = benchmarks.begin(); itr != benchmarks.end(); ++itr)
+        {
+            std::cout << (*itr)->name() << std::endl;
+        }
+        return 0;
+    }
+
+    std::vector<BenchmarkResult> results;
+    try
+    {
+        std::cout << std::left << std::setw(44) << "Benchmark" << std::right << std::setw(12) << "iterations"
+                  << std::setw(14) << "ns/op" << std::setw(14) << "min ns/op" << std::setw(12) << "allocs/op"
+                  << std::endl;
+
+        for (std::vector<BenchmarkPtr>::iterator itr = benchmarks.begin(); itr != benchmarks.end(); ++itr)
+        {
+            if ((*itr)->name().find(filter) == std::string::npos)
+            {
+                continue;
+            }
+
+            BenchmarkResult result = run_benchmark(*itr, min_time_secs, repetitions);
+            results.push_back(result);
+
+            std::cout << std::left << std::setw(44) << result.name << std::right << std::setw(12) << result.iterations
+                      << std::fixed << std::setprecision(1) << std::setw(14) << result.ns_per_op
+                      << std::setw(14) << result.min_ns_per_op << std::setprecision(2) << std::setw(12);
+            if (allocations_counted())
+            {
+                std::cout << result.allocs_per_op;
+            }
+            else
+            {
+                std::cout << "n/a";
+            }
+            std::cout << std::endl;
+        }
+
+        if (vm.count("save"))
+        {
+            save_results(vm["save"].as<std::string>(), results);
+        }
+
+        if (vm.count("baseline"))
+        {
+            BaselineMap baseline = load_baseline(vm["baseline"].as<std::string>());
+            unsigned int regressions = compare_baseline(results, baseline, tolerance);
+            if (regressions)
+            {
+                std::cout << regressions << " benchmark(s) regressed against baseline" << std::endl;
+                return 2;
+            }
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*!
+ * FrameSlotTableBench.cpp - microbenchmarks of the per-packet frame buffer lookup
+ *
+ * Each operation looks up the buffer of one packet, with packets from several frames interleaved
+ * as happens when frames arrive on several ports, comparing the FrameSlotTable with the std::map
+ * based lookup (count then operator[]) it replaced.
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameReceiverBench.h"
+#include "FrameSlotTable.h"
+
+#include <map>
+
+using namespace FrameReceiver;
+using namespace FrameReceiverBench;
+
+namespace
+{
+    const int num_buffers = 500;
+    const int num_interleaved = 4;
+
+    //! Returns the frame number of a packet, frames being interleaved in runs of 1024 packets
+    inline uint32_t packet_frame(size_t packet)
+    {
+        return 1000 + ((packet / 1024) * num_interleaved + (packet % num_interleaved)) % num_buffers;
+    }
+
+    //! Looks up the buffer of each packet in a std::map, as the frame decoder previously did
+    class FrameMapLookupBenchmark : public Benchmark
+    {
+    public:
+        FrameMapLookupBenchmark() : Benchmark("framemap.lookup") { };
+
+        void setup(void)
+        {
+            for (int buffer = 0; buffer < num_buffers; buffer++)
+            {
+                frame_map_[1000 + buffer] = buffer;
+            }
+        }
+
+        void run(size_t iterations)
+        {
+            for (size_t packet = 0; packet < iterations; packet++)
+            {
+                uint32_t frame = packet_frame(packet);
+                int buffer = -1;
+                if (frame_map_.count(frame))
+                {
+                    buffer = frame_map_[frame];
+                }
+                do_not_optimise(buffer);
+            }
+        }
+
+        void teardown(void)
+        {
+            frame_map_.clear();
+        }
+
+    private:
+        std::map<uint32_t, int> frame_map_;
+    };
+
+    //! Looks up the buffer of each packet in a FrameSlotTable
+    class FrameSlotTableLookupBenchmark : public Benchmark
+    {
+    public:
+        FrameSlotTableLookupBenchmark() : Benchmark("frameslottable.lookup"), table_(num_buffers) { };
+
+        void setup(void)
+        {
+            for (int buffer = 0; buffer < num_buffers; buffer++)
+            {
+                table_.insert(1000 + buffer, buffer);
+            }
+        }
+
+        void run(size_t iterations)
+        {
+            for (size_t packet = 0; packet < iterations; packet++)
+            {
+                int buffer = table_.find(packet_frame(packet));
+                do_not_optimise(buffer);
+            }
+        }
+
+        void teardown(void)
+        {
+            for (int buffer = 0; buffer < num_buffers; buffer++)
+            {
+                table_.erase(1000 + buffer);
+            }
+        }
+
+    private:
+        FrameSlotTable table_;
+    };
+}
+
+FRAME_RECEIVER_BENCHMARK(FrameMapLookupBenchmark);
+FRAME_RECEIVER_BENCHMARK(FrameSlotTableLookupBenchmark);
@@ -0,0 +1,117 @@
+/*!
+ * IpcMessageBench.cpp - microbenchmarks of frame notification message encoding and parsing
+ *
+ * Each operation handles one frame notification as the frame receiver does on the frame ready and
+ * release paths, in both the JSON IpcMessage and binary IpcFrameNotification formats.
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameReceiverBench.h"
+#include "IpcMessage.h"
+#include "IpcFrameNotification.h"
+
+#include <string>
+
+using namespace FrameReceiver;
+using namespace FrameReceiverBench;
+
+namespace
+{
+    //! Builds and encodes a frame ready notification, as the RX thread does for each frame
+    class IpcMessageEncodeBenchmark : public Benchmark
+    {
+    public:
+        IpcMessageEncodeBenchmark() : Benchmark("ipcmessage.encode") { };
+
+        void run(size_t iterations)
+        {
+            for (size_t iter = 0; iter < iterations; iter++)
+            {
+                IpcMessage frame_ready(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyFrameReady);
+                frame_ready.set_param("frame", (int)iter);
+                frame_ready.set_param("buffer_id", (int)(iter & 0xFF));
+                const char* encoded = frame_ready.encode();
+                do_not_optimise(encoded);
+            }
+        }
+    };
+
+    //! Parses a frame release notification and extracts its parameters, as the main thread does
+    //! for each frame released by a processor
+    class IpcMessageParseBenchmark : public Benchmark
+    {
+    public:
+        IpcMessageParseBenchmark() : Benchmark("ipcmessage.parse") { };
+
+        void setup(void)
+        {
+            IpcMessage frame_release(IpcMessage::MsgTypeNotify, IpcMessage::MsgValNotifyFrameRelease);
+            frame_release.set_param("frame", 1234);
+            frame_release.set_param("buffer_id", 5);
+            encoded_ = frame_release.encode();
+        }
+
+        void run(size_t iterations)
+        {
+            for (size_t iter = 0; iter < iterations; iter++)
+            {
+                IpcMessage frame_release(encoded_.c_str());
+                int frame = frame_release.get_param<int>("frame", -1);
+                int buffer_id = frame_release.get_param<int>("buffer_id", -1);
+                do_not_optimise(frame);
+                do_not_optimise(buffer_id);
+            }
+        }
+
+    private:
+        std::string encoded_;
+    };
+
+    //! Builds and encodes a binary frame ready notification
+    class IpcFrameNotificationEncodeBenchmark : public Benchmark
+    {
+    public:
+        IpcFrameNotificationEncodeBenchmark() : Benchmark("ipcframenotification.encode") { };
+
+        void run(size_t iterations)
+        {
+            for (size_t iter = 0; iter < iterations; iter++)
+            {
+                IpcFrameNotification frame_ready(IpcMessage::MsgValNotifyFrameReady, (int)iter, (int)(iter & 0xFF));
+                std::string encoded = frame_ready.encode();
+                do_not_optimise(encoded);
+            }
+        }
+    };
+
+    //! Parses a binary frame release notification
+    class IpcFrameNotificationParseBenchmark : public Benchmark
+    {
+    public:
+        IpcFrameNotificationParseBenchmark() : Benchmark("ipcframenotification.parse") { };
+
+        void setup(void)
+        {
+            encoded_ = IpcFrameNotification(IpcMessage::MsgValNotifyFrameRelease, 1234, 5).encode();
+        }
+
+        void run(size_t iterations)
+        {
+            for (size_t iter = 0; iter < iterations; iter++)
+            {
+                IpcFrameNotification frame_release(encoded_);
+                int buffer_id = frame_release.get_buffer_id();
+                do_not_optimise(buffer_id);
+            }
+        }
+
+    private:
+        std::string encoded_;
+    };
+}
+
+FRAME_RECEIVER_BENCHMARK(IpcMessageEncodeBenchmark);
+FRAME_RECEIVER_BENCHMARK(IpcMessageParseBenchmark);
+FRAME_RECEIVER_BENCHMARK(IpcFrameNotificationEncodeBenchmark);
+FRAME_RECEIVER_BENCHMARK(IpcFrameNotificationParseBenchmark);
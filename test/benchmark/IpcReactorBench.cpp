@@ -0,0 +1,180 @@
+/*!
+ * IpcReactorBench.cpp - microbenchmarks of IpcReactor loop iterations
+ *
+ * Each operation is one reactor iteration handling a single ready channel, socket or timer. The
+ * channel and socket handlers send the next message to themselves, so the reactor always has
+ * exactly one event to handle per iteration. A fresh reactor is run for each set of operations,
+ * as a stopped reactor cannot be restarted; its construction is amortised over the operations.
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameReceiverBench.h"
+#include "IpcReactor.h"
+#include "IpcChannel.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+
+using namespace FrameReceiver;
+using namespace FrameReceiverBench;
+
+namespace
+{
+    //! Handles a message on an inproc channel pair per iteration
+    class IpcReactorChannelBenchmark : public Benchmark
+    {
+    public:
+        IpcReactorChannelBenchmark() : Benchmark("ipcreactor.channel_iteration") { };
+
+        void setup(void)
+        {
+            send_channel_.reset(new IpcChannel(ZMQ_PAIR));
+            recv_channel_.reset(new IpcChannel(ZMQ_PAIR));
+
+            std::stringstream ss;
+            ss << "inproc://bench_reactor_channel_" << getpid();
+            std::string endpoint = ss.str();
+            send_channel_->bind(endpoint);
+            recv_channel_->connect(endpoint);
+            message_ = "frame";
+        }
+
+        void run(size_t iterations)
+        {
+            IpcReactor reactor;
+            reactor_ = &reactor;
+            remaining_ = iterations;
+            reactor.register_channel(*recv_channel_, boost::bind(&IpcReactorChannelBenchmark::handle_channel, this));
+            send_channel_->send(message_);
+            reactor.run();
+            reactor.remove_channel(*recv_channel_);
+        }
+
+        void teardown(void)
+        {
+            recv_channel_->close();
+            send_channel_->close();
+            recv_channel_.reset();
+            send_channel_.reset();
+        }
+
+    private:
+        void handle_channel(void)
+        {
+            std::string message = recv_channel_->recv();
+            if (--remaining_ == 0)
+            {
+                reactor_->stop();
+            }
+            else
+            {
+                send_channel_->send(message_);
+            }
+        }
+
+        boost::scoped_ptr<IpcChannel> send_channel_;
+        boost::scoped_ptr<IpcChannel> recv_channel_;
+        IpcReactor* reactor_;
+        size_t remaining_;
+        std::string message_;
+    };
+
+    //! Handles a datagram on a registered socket per iteration, as the RX thread does for each
+    //! received packet
+    class IpcReactorSocketBenchmark : public Benchmark
+    {
+    public:
+        IpcReactorSocketBenchmark() : Benchmark("ipcreactor.socket_iteration") { };
+
+        void setup(void)
+        {
+            if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets_) < 0)
+            {
+                throw std::runtime_error("Failed to create socket pair");
+            }
+        }
+
+        void run(size_t iterations)
+        {
+            IpcReactor reactor;
+            reactor_ = &reactor;
+            remaining_ = iterations;
+            reactor.register_socket(sockets_[1], boost::bind(&IpcReactorSocketBenchmark::handle_socket, this));
+            send_datagram();
+            reactor.run();
+            reactor.remove_socket(sockets_[1]);
+        }
+
+        void teardown(void)
+        {
+            close(sockets_[0]);
+            close(sockets_[1]);
+        }
+
+    private:
+        void send_datagram(void)
+        {
+            char datagram = 0;
+            if (send(sockets_[0], &datagram, sizeof(datagram), 0) < 0)
+            {
+                throw std::runtime_error("Failed to send datagram");
+            }
+        }
+
+        void handle_socket(void)
+        {
+            char datagram;
+            if (recv(sockets_[1], &datagram, sizeof(datagram), 0) < 0)
+            {
+                throw std::runtime_error("Failed to receive datagram");
+            }
+            if (--remaining_ == 0)
+            {
+                reactor_->stop();
+            }
+            else
+            {
+                send_datagram();
+            }
+        }
+
+        int sockets_[2];
+        IpcReactor* reactor_;
+        size_t remaining_;
+    };
+
+    //! Fires an immediately due timer per iteration
+    class IpcReactorTimerBenchmark : public Benchmark
+    {
+    public:
+        IpcReactorTimerBenchmark() : Benchmark("ipcreactor.timer_iteration") { };
+
+        void run(size_t iterations)
+        {
+            IpcReactor reactor;
+            fired_ = 0;
+            // The reactor exits once the timer has fired the requested number of times
+            reactor.register_timer_us(0, iterations, boost::bind(&IpcReactorTimerBenchmark::handle_timer, this));
+            reactor.run();
+            do_not_optimise(fired_);
+        }
+
+    private:
+        void handle_timer(void)
+        {
+            fired_++;
+        }
+
+        size_t fired_;
+    };
+}
+
+FRAME_RECEIVER_BENCHMARK(IpcReactorChannelBenchmark);
+FRAME_RECEIVER_BENCHMARK(IpcReactorSocketBenchmark);
+FRAME_RECEIVER_BENCHMARK(IpcReactorTimerBenchmark);
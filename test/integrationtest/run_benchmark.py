@@ -0,0 +1,386 @@
+#!/bin/env python
+
+import argparse
+import sys
+import os
+import subprocess
+import shlex
+import signal
+import socket
+import time
+import datetime
+import tempfile
+import itertools
+import json
+import re
+from threading import Timer
+
+class BenchmarkException(Exception):
+    pass
+
+class Benchmark(object):
+    """Runs the frame receiver, frameProducer and frameProcessor on loopback over a sweep of
+    configurations and records throughput, loss, latency and CPU usage into a JSON report,
+    optionally flagging regressions against a baseline report."""
+
+    # Frame buffer size of the Percival emulator decoder, used to size the shared buffer
+    PERCIVAL_EMULATOR_FRAME_SIZE = 2 * 2 * ((255 * 8192) + 512)
+    PERCIVAL_EMULATOR_PACKET_SIZE = 8192
+
+    def __init__(self):
+
+        parser = argparse.ArgumentParser(prog="Benchmark", description="Benchmark - run PERCIVAL frame receiver end-to-end loopback benchmark")
+
+        parser.add_argument('--rates', type=str, default='10,50,0',
+                            help='comma-separated frame rates to sweep in frames/s (0 sends as fast as possible)')
+        parser.add_argument('--ports', type=str, default='1,2',
+                            help='comma-separated numbers of receive ports to sweep')
+        parser.add_argument('--buffers', type=str, default='8,32',
+                            help='comma-separated numbers of shared frame buffers to sweep')
+        parser.add_argument('--sendbatch', type=str, default='64',
+                            help='comma-separated producer datagrams per sendmmsg call to sweep')
+        parser.add_argument('--rxbatch', type=str, default='1',
+                            help='comma-separated receiver datagrams per socket wakeup to sweep')
+        parser.add_argument('--frames', '-n', type=int, default=100,
+                            help='select number of frames to transmit in each run')
+        parser.add_argument('--threads', type=int, default=2,
+                            help='set the maximum number of producer sending threads')
+        parser.add_argument('--baseport', type=int, default=8989,
+                            help='set the first receive port')
+        parser.add_argument('--notify', type=str, default='binary', choices=['json', 'binary', 'ring'],
+                            help='select how frame notifications are exchanged with the processor')
+        parser.add_argument('--mode', type=str, default='release', choices=['release', 'touch', 'validate'],
+                            help='select the frame handling of the processor before release')
+        parser.add_argument('--frametimeout', type=int, default=1000,
+                            help='set the receiver incomplete frame timeout in ms')
+        parser.add_argument('--bindir', type=str, default='bin',
+                            help='set the directory containing the frame receiver and tool binaries')
+        parser.add_argument('--report', '-r', type=str, default='benchmark_report.json',
+                            help='set the file to write the JSON benchmark report to')
+        parser.add_argument('--baseline', '-b', type=str, default=None,
+                            help='compare results with a previous benchmark report and fail on regressions')
+        parser.add_argument('--tolerance', type=float, default=0.1,
+                            help='set the fractional drop in frames/s from the baseline counted as a regression')
+        parser.add_argument('--losstolerance', type=float, default=0.01,
+                            help='set the increase in packet loss fraction from the baseline counted as a regression')
+        parser.add_argument('--timeout', '-t', type=float, default=60.0,
+                            help="sets timeout for process completion in each run")
+
+        args = parser.parse_args()
+
+        self.args = args
+        self.sweep = {
+            'rate'       : self.parse_list(args.rates, float),
+            'ports'      : self.parse_list(args.ports, int),
+            'buffers'    : self.parse_list(args.buffers, int),
+            'send_batch' : self.parse_list(args.sendbatch, int),
+            'rx_batch'   : self.parse_list(args.rxbatch, int),
+        }
+        self.shared_buffer = "FrameReceiverBench_%d" % os.getpid()
+        self.clock_ticks = float(os.sysconf('SC_CLK_TCK'))
+
+    @staticmethod
+    def parse_list(list_str, conv):
+
+        return [conv(val) for val in list_str.split(',') if val.strip()]
+
+    def run(self):
+
+        report = {
+            'timestamp' : datetime.datetime.now().isoformat(),
+            'host'      : socket.gethostname(),
+            'num_cpus'  : os.sysconf('SC_NPROCESSORS_ONLN'),
+            'config'    : vars(self.args),
+            'runs'      : [],
+        }
+
+        names = sorted(self.sweep.keys())
+        for values in itertools.product(*[self.sweep[name] for name in names]):
+
+            params = dict(zip(names, values))
+            params['frames'] = self.args.frames
+            params['packet_size'] = Benchmark.PERCIVAL_EMULATOR_PACKET_SIZE
+            params['notify'] = self.args.notify
+            params['mode'] = self.args.mode
+
+            print "Running benchmark: %s" % self.describe(params)
+            try:
+                metrics = self.run_one(params)
+            except BenchmarkException as e:
+                print "ERROR: %s" % e
+                metrics = { 'error' : str(e) }
+            else:
+                print "  %.1f frames/s %.3f Gbit/s, %d of %d frames, %d timed out, packet loss %.4f%%, latency p50/p99 %s/%s us" % (
+                    metrics['frames_per_sec'], metrics['gbit_per_sec'], metrics['frames_processed'], metrics['frames_sent'],
+                    metrics['frames_timedout'], metrics['packet_loss'] * 100.0,
+                    metrics['latency_us']['p50'], metrics['latency_us']['p99'])
+
+            report['runs'].append({ 'params' : params, 'metrics' : metrics })
+
+        with open(self.args.report, 'w') as report_file:
+            json.dump(report, report_file, indent=2, sort_keys=True)
+        print "Benchmark report written to %s" % self.args.report
+
+        rc = 1 if [run for run in report['runs'] if 'error' in run['metrics']] else 0
+        if self.args.baseline:
+            rc = rc + self.compare_baseline(report)
+
+        if rc == 0:
+            print "Benchmark (%d runs) PASSED" % len(report['runs'])
+        else:
+            print "Benchmark (%d runs) FAILED" % len(report['runs'])
+
+        return rc
+
+    @staticmethod
+    def describe(params):
+
+        return ' '.join("%s=%s" % (name, params[name]) for name in sorted(params.keys()))
+
+    @staticmethod
+    def run_key(params):
+
+        return tuple((name, params[name]) for name in sorted(params.keys()))
+
+    def run_one(self, params):
+
+        ports = ','.join(str(self.args.baseport + port) for port in range(params['ports']))
+        max_mem = params['buffers'] * Benchmark.PERCIVAL_EMULATOR_FRAME_SIZE
+        notify_format = 'json' if self.args.notify == 'json' else 'binary'
+        notify_ring = 1 if self.args.notify == 'ring' else 0
+        hold_log = tempfile.NamedTemporaryFile(prefix='frameProcessorHold', suffix='.csv', delete=False)
+        hold_log.close()
+
+        receiver = None
+        processor = None
+        try:
+            receiver = self.launch_process("%s/frameReceiver --sensortype percivalemulator --maxmem %d --port %s --sharedbuf %s "
+                                           "--notifyformat %s --notifyring %d --rxbatch %d --frametimeout %d" %
+                                           (self.args.bindir, max_mem, ports, self.shared_buffer, notify_format, notify_ring,
+                                            params['rx_batch'], self.args.frametimeout))
+            self.wait_shared_buffer(receiver)
+
+            processor = self.launch_process("%s/frameProcessor --sharedbuf %s --notifyformat %s --notifyring %d --mode %s "
+                                            "--interval 0 --holdlog %s" %
+                                            (self.args.bindir, self.shared_buffer, notify_format, notify_ring,
+                                             self.args.mode, hold_log.name))
+            time.sleep(0.5)
+
+            cpu_start = self.read_cpu_times()
+            receiver_cpu_start = self.read_process_cpu(receiver.pid)
+
+            producer = self.launch_process("%s/frameProducer --port %s --threads %d --frames %d --rate %f --batch %d" %
+                                           (self.args.bindir, ports, min(params['ports'], self.args.threads),
+                                            self.args.frames, params['rate'], params['send_batch']))
+            (producer_timedout, producer_stdout, producer_stderr) = self.wait_process_output(producer, self.args.timeout)
+            if producer_timedout or producer.returncode != 0:
+                raise BenchmarkException("producer failed: %s %s" % (producer_stdout, producer_stderr))
+
+            # Let incomplete frames time out and be released before sampling CPU and stopping
+            time.sleep((self.args.frametimeout / 1000.0) + 0.5)
+
+            cpu_end = self.read_cpu_times()
+            receiver_cpu_end = self.read_process_cpu(receiver.pid)
+
+            processor.send_signal(signal.SIGINT)
+            (processor_timedout, processor_stdout, processor_stderr) = self.wait_process_output(processor, self.args.timeout)
+            processor = None
+            if processor_timedout:
+                raise BenchmarkException("processor timed out")
+
+        finally:
+            for process in (processor, receiver):
+                if process is not None and process.poll() is None:
+                    process.send_signal(signal.SIGINT)
+                    self.wait_process_output(process, 5.0)
+
+            # Remove the shared buffer so that each run starts from a freshly created one
+            shared_buffer_path = os.path.join('/dev/shm', self.shared_buffer)
+            if os.path.exists(shared_buffer_path):
+                os.unlink(shared_buffer_path)
+
+        metrics = self.parse_producer_output(producer_stdout)
+        metrics.update(self.parse_processor_output(processor_stdout, processor_stderr))
+        metrics.update(self.parse_hold_log(hold_log.name))
+        os.unlink(hold_log.name)
+
+        metrics['frames_lost'] = metrics['frames_sent'] - metrics['frames_processed']
+        if metrics['packets_sent']:
+            metrics['packet_loss'] = 1.0 - (float(metrics['packets_received']) / metrics['packets_sent'])
+        else:
+            metrics['packet_loss'] = 0.0
+
+        metrics['cpu_percent_per_core'] = self.cpu_usage(cpu_start, cpu_end)
+        metrics['receiver_cpu_secs'] = round(receiver_cpu_end - receiver_cpu_start, 3)
+
+        return metrics
+
+    def launch_process(self, cmd_line):
+
+        proc = subprocess.Popen(shlex.split(cmd_line), stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+        return proc
+
+    def wait_shared_buffer(self, receiver, timeout=5.0):
+
+        shared_buffer_path = os.path.join('/dev/shm', self.shared_buffer)
+        deadline = time.time() + timeout
+        while not os.path.exists(shared_buffer_path):
+            if receiver.poll() is not None:
+                (stdout, stderr) = receiver.communicate()
+                raise BenchmarkException("receiver exited during startup: %s %s" % (stdout, stderr))
+            if time.time() > deadline:
+                raise BenchmarkException("receiver did not create shared buffer %s" % self.shared_buffer)
+            time.sleep(0.1)
+
+        # Allow the receiver to bind its channels after creating the shared buffer
+        time.sleep(0.5)
+
+    def kill_process(self, process, timedout):
+
+        timedout['value'] = True
+        process.kill()
+
+    def wait_process_output(self, process, timeout=None):
+
+        timedout = { 'value' : False }
+
+        if timeout is not None:
+            timer = Timer(timeout, self.kill_process, [process, timedout])
+            timer.start()
+
+        (process_stdout, process_stderr) = process.communicate()
+
+        if timeout is not None:
+            timer.cancel()
+
+        return (timedout['value'], process_stdout, process_stderr)
+
+    @staticmethod
+    def match_output(pattern, output, name):
+
+        match = re.search(pattern, output)
+        if not match:
+            raise BenchmarkException("failed to find expected %s output \"%s\" in: %s" % (name, pattern, output))
+        return match
+
+    def parse_producer_output(self, output):
+
+        match = self.match_output(r"Sent (\d+) frames, (\d+) packets, (\d+) bytes in ([\d.e+-]+) secs", output, "producer")
+
+        return {
+            'frames_sent'  : int(match.group(1)),
+            'packets_sent' : int(match.group(2)),
+            'bytes_sent'   : int(match.group(3)),
+            'send_secs'    : float(match.group(4)),
+        }
+
+    def parse_processor_output(self, output, errors):
+
+        match = self.match_output(r"Processed (\d+) frames(?: \(([\d.e+-]+) frames/s, ([\d.e+-]+) GB/s\))?",
+                                  output, "processor")
+        metrics = {
+            'frames_processed' : int(match.group(1)),
+            'frames_per_sec'   : float(match.group(2)) if match.group(2) else 0.0,
+            'gbit_per_sec'     : float(match.group(3)) * 8 if match.group(3) else 0.0,
+        }
+
+        match = self.match_output(r"Frames timed out: (\d+) packets received: (\d+)", output, "processor")
+        metrics['frames_timedout'] = int(match.group(1))
+        metrics['packets_received'] = int(match.group(2))
+
+        return metrics
+
+    @staticmethod
+    def percentiles(values):
+
+        if not values:
+            return { 'p50' : None, 'p99' : None, 'max' : None }
+        values = sorted(values)
+        pick = lambda fraction: round(values[min(len(values) - 1, int(fraction * len(values)))], 1)
+        return { 'p50' : pick(0.5), 'p99' : pick(0.99), 'max' : round(values[-1], 1) }
+
+    def parse_hold_log(self, hold_log_name):
+
+        hold_us = []
+        latency_us = []
+        with open(hold_log_name) as hold_log:
+            hold_log.readline()
+            for line in hold_log:
+                fields = line.strip().split(',')
+                if len(fields) < 5:
+                    continue
+                hold_us.append(int(fields[3]) / 1000.0)
+                if int(fields[4]) >= 0:
+                    latency_us.append(int(fields[4]) / 1000.0)
+
+        return {
+            'hold_us'    : self.percentiles(hold_us),
+            'latency_us' : self.percentiles(latency_us),
+        }
+
+    @staticmethod
+    def read_cpu_times():
+
+        cpu_times = {}
+        with open('/proc/stat') as stat:
+            for line in stat:
+                fields = line.split()
+                if fields[0].startswith('cpu') and fields[0] != 'cpu':
+                    times = [int(val) for val in fields[1:]]
+                    # Idle and iowait are the fourth and fifth fields
+                    cpu_times[fields[0]] = (sum(times), times[3] + times[4])
+        return cpu_times
+
+    @staticmethod
+    def cpu_usage(start, end):
+
+        usage = {}
+        for cpu in sorted(end.keys(), key=lambda name: int(name[3:])):
+            if cpu not in start:
+                continue
+            total = end[cpu][0] - start[cpu][0]
+            idle = end[cpu][1] - start[cpu][1]
+            usage[cpu] = round(100.0 * (total - idle) / total, 1) if total else 0.0
+        return usage
+
+    def read_process_cpu(self, pid):
+
+        try:
+            with open('/proc/%d/stat' % pid) as stat:
+                # Skip the command name, which may contain spaces, then take utime and stime
+                fields = stat.read().rsplit(')', 1)[1].split()
+                return (int(fields[11]) + int(fields[12])) / self.clock_ticks
+        except IOError:
+            return 0.0
+
+    def compare_baseline(self, report):
+
+        with open(self.args.baseline) as baseline_file:
+            baseline = json.load(baseline_file)
+
+        baseline_runs = {}
+        for run in baseline['runs']:
+            baseline_runs[self.run_key(run['params'])] = run['metrics']
+
+        regressions = 0
+        for run in report['runs']:
+            base = baseline_runs.get(self.run_key(run['params']))
+            metrics = run['metrics']
+            if base is None or 'error' in base or 'error' in metrics:
+                continue
+
+            if metrics['frames_per_sec'] < base['frames_per_sec'] * (1.0 - self.args.tolerance):
+                print "REGRESSION: %s frames/s %.1f below baseline %.1f" % (
+                    self.describe(run['params']), metrics['frames_per_sec'], base['frames_per_sec'])
+                regressions += 1
+            if metrics['packet_loss'] > base['packet_loss'] + self.args.losstolerance:
+                print "REGRESSION: %s packet loss %.4f above baseline %.4f" % (
+                    self.describe(run['params']), metrics['packet_loss'], base['packet_loss'])
+                regressions += 1
+
+        return 1 if regressions else 0
+
+if __name__ == '__main__':
+
+    rc = Benchmark().run()
+    sys.exit(rc)
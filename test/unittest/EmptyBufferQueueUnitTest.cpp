@@ -0,0 +1,108 @@
+/*!
+ * EmptyBufferQueueUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include "EmptyBufferQueue.h"
+
+#include <poll.h>
+
+namespace
+{
+    bool notification_pending(FrameReceiver::EmptyBufferQueue& queue)
+    {
+        struct pollfd poll_fd;
+        poll_fd.fd = queue.get_notify_fd();
+        poll_fd.events = POLLIN;
+        poll_fd.revents = 0;
+        return (poll(&poll_fd, 1, 0) == 1);
+    }
+
+    void produce_buffers(FrameReceiver::EmptyBufferQueue* queue, int num_buffers)
+    {
+        for (int buffer_id = 0; buffer_id < num_buffers; buffer_id++)
+        {
+            while (!queue->push(buffer_id))
+            {
+                boost::this_thread::yield();
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(EmptyBufferQueueUnitTest);
+
+BOOST_AUTO_TEST_CASE( PushPopAndNotify )
+{
+    FrameReceiver::EmptyBufferQueue queue(4);
+    int buffer_id;
+
+    BOOST_CHECK_EQUAL(notification_pending(queue), false);
+    BOOST_CHECK_EQUAL(queue.pop(buffer_id), false);
+
+    BOOST_CHECK_EQUAL(queue.push(1), true);
+    BOOST_CHECK_EQUAL(queue.push(2), true);
+    BOOST_CHECK_EQUAL(notification_pending(queue), true);
+
+    // Clearing the notification leaves the queued IDs to be drained
+    queue.clear_notification();
+    BOOST_CHECK_EQUAL(notification_pending(queue), false);
+    BOOST_CHECK_EQUAL(queue.pop(buffer_id), true);
+    BOOST_CHECK_EQUAL(buffer_id, 1);
+    BOOST_CHECK_EQUAL(queue.pop(buffer_id), true);
+    BOOST_CHECK_EQUAL(buffer_id, 2);
+    BOOST_CHECK_EQUAL(queue.pop(buffer_id), false);
+
+    // A push after clearing signals again
+    BOOST_CHECK_EQUAL(queue.push(3), true);
+    BOOST_CHECK_EQUAL(notification_pending(queue), true);
+
+    // Pushes fail once the queue is full
+    BOOST_CHECK_EQUAL(queue.push(4), true);
+    BOOST_CHECK_EQUAL(queue.push(5), true);
+    BOOST_CHECK_EQUAL(queue.push(6), true);
+    BOOST_CHECK_EQUAL(queue.push(7), false);
+}
+
+BOOST_AUTO_TEST_CASE( ProducerConsumerThreads )
+{
+    const int num_buffers = 100000;
+    FrameReceiver::EmptyBufferQueue queue(64);
+
+    boost::thread producer(boost::bind(produce_buffers, &queue, num_buffers));
+
+    // Consume in the same way as an RX thread, waiting on the notification descriptor and then
+    // clearing it before draining the queue. All IDs must arrive, in order.
+    int expected_id = 0;
+    bool in_order = true;
+    while (expected_id < num_buffers)
+    {
+        struct pollfd poll_fd;
+        poll_fd.fd = queue.get_notify_fd();
+        poll_fd.events = POLLIN;
+        poll_fd.revents = 0;
+        if (poll(&poll_fd, 1, 1000) != 1)
+        {
+            break;
+        }
+
+        queue.clear_notification();
+        int buffer_id;
+        while (queue.pop(buffer_id))
+        {
+            in_order &= (buffer_id == expected_id);
+            expected_id++;
+        }
+    }
+    producer.join();
+
+    BOOST_CHECK_EQUAL(expected_id, num_buffers);
+    BOOST_CHECK_EQUAL(in_order, true);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
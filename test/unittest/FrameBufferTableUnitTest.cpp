@@ -0,0 +1,224 @@
+/*!
+ * FrameBufferTableUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include "FrameBufferTable.h"
+
+class FrameBufferTableTestFixture
+{
+public:
+    FrameBufferTableTestFixture() :
+        initialiser(boost::bind(&FrameBufferTableTestFixture::initialise, this, _1, _2, _3)),
+        initialise_count(0),
+        last_acquisition(0),
+        release_count(0)
+    {
+    }
+
+    void initialise(int buffer_id, uint32_t frame_number, uint32_t acquisition)
+    {
+        initialise_count++;
+        last_acquisition = acquisition;
+    }
+
+    void release_frames(uint32_t num_frames)
+    {
+        for (uint32_t frame = 0; frame < num_frames; frame++)
+        {
+            if (table.release_buffer(frame, frame))
+            {
+                boost::mutex::scoped_lock lock(release_mutex);
+                release_count++;
+            }
+        }
+    }
+
+    void release_frame_when_written(uint32_t frame, int buffer_id, volatile bool* released)
+    {
+        bool result = table.release_buffer(frame, buffer_id);
+        __sync_synchronize();
+        *released = result;
+    }
+
+    FrameReceiver::FrameBufferTable table;
+    FrameReceiver::FrameBufferInitialiser initialiser;
+    int initialise_count;
+    uint32_t last_acquisition;
+    int release_count;
+    boost::mutex release_mutex;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FrameBufferTableUnitTest, FrameBufferTableTestFixture);
+
+BOOST_AUTO_TEST_CASE( AcquireAndReleaseBuffer )
+{
+    table.push_empty_buffer(3);
+    table.push_empty_buffer(7);
+    BOOST_CHECK_EQUAL(table.get_num_empty_buffers(), 2);
+    BOOST_CHECK_EQUAL(table.get_num_mapped_buffers(), 0);
+
+    // First acquisition of a frame allocates and initialises a buffer, subsequent ones return it
+    BOOST_CHECK_EQUAL(table.acquire_buffer(100, initialiser), 3);
+    BOOST_CHECK_EQUAL(table.acquire_buffer(100, initialiser), 3);
+    BOOST_CHECK_EQUAL(table.acquire_buffer(101, initialiser), 7);
+    BOOST_CHECK_EQUAL(initialise_count, 2);
+    BOOST_CHECK_EQUAL(table.get_num_empty_buffers(), 0);
+    BOOST_CHECK_EQUAL(table.get_num_mapped_buffers(), 2);
+
+    // No buffers left for a further frame
+    BOOST_CHECK_EQUAL(table.acquire_buffer(102, initialiser), -1);
+
+    std::vector<std::pair<uint32_t, int> > mapped;
+    table.get_mapped_buffers(mapped);
+    BOOST_REQUIRE_EQUAL(mapped.size(), 2);
+    BOOST_CHECK_EQUAL(mapped[0].first, 100);
+    BOOST_CHECK_EQUAL(mapped[0].second, 3);
+
+    // A frame can only be released once, and only from the buffer it is mapped to
+    uint32_t release_count = table.get_release_count();
+    BOOST_CHECK_EQUAL(table.release_buffer(100, 7), false);
+    BOOST_CHECK_EQUAL(table.release_buffer(100, 3), true);
+    BOOST_CHECK_EQUAL(table.release_buffer(100, 3), false);
+    BOOST_CHECK_EQUAL(table.get_release_count(), release_count + 1);
+    BOOST_CHECK_EQUAL(table.get_num_mapped_buffers(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( RejectOutOfRangeBuffers )
+{
+    // A table sized for the buffers in circulation rejects buffer IDs outside them, e.g. from a
+    // corrupt release notification, rather than growing to fit them
+    table.reserve_buffers(4);
+    BOOST_CHECK_EQUAL(table.push_empty_buffer(3), true);
+    BOOST_CHECK_EQUAL(table.push_empty_buffer(4), false);
+    BOOST_CHECK_EQUAL(table.push_empty_buffer(0x7FFFFFFF), false);
+    BOOST_CHECK_EQUAL(table.push_empty_buffer(-1), false);
+    BOOST_CHECK_EQUAL(table.get_num_empty_buffers(), 1);
+    BOOST_CHECK_EQUAL(table.acquire_buffer(1, initialiser), 3);
+    BOOST_CHECK_EQUAL(table.acquire_buffer(2, initialiser), -1);
+}
+
+BOOST_AUTO_TEST_CASE( ReleaseByAcquisition )
+{
+    table.reserve_buffers(1);
+    table.push_empty_buffer(0);
+
+    // Each allocation of a buffer to a frame has a distinct acquisition number
+    BOOST_CHECK_EQUAL(table.acquire_buffer(0, initialiser), 0);
+    uint32_t first_acquisition = last_acquisition;
+    BOOST_CHECK_EQUAL(table.release_buffer(0, 0), true);
+
+    table.push_empty_buffer(0);
+    BOOST_CHECK_EQUAL(table.acquire_buffer(0, initialiser), 0);
+    uint32_t second_acquisition = last_acquisition;
+    BOOST_CHECK(second_acquisition != first_acquisition);
+
+    // A release for an earlier allocation of the same frame to the same buffer is ignored
+    BOOST_CHECK_EQUAL(table.release_buffer(0, 0, first_acquisition), false);
+    BOOST_CHECK_EQUAL(table.get_num_mapped_buffers(), 1);
+    BOOST_CHECK_EQUAL(table.release_buffer(0, 0, second_acquisition), true);
+    BOOST_CHECK_EQUAL(table.release_buffer(0, 0, second_acquisition), false);
+    BOOST_CHECK_EQUAL(table.get_num_mapped_buffers(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( EmptyBuffersAllocatedInOrder )
+{
+    // Buffers are allocated in the order pushed, both in a table sized for the buffers in
+    // circulation and when an unsized table grows as buffers are pushed
+    table.reserve_buffers(4);
+    for (int cycle = 0; cycle < 3; cycle++)
+    {
+        for (int buffer_id = 0; buffer_id < 4; buffer_id++)
+        {
+            table.push_empty_buffer(buffer_id);
+        }
+        for (int buffer_id = 0; buffer_id < 4; buffer_id++)
+        {
+            uint32_t frame = (cycle * 4) + buffer_id;
+            BOOST_CHECK_EQUAL(table.acquire_buffer(frame, initialiser), buffer_id);
+            BOOST_CHECK_EQUAL(table.release_buffer(frame, buffer_id), true);
+        }
+        BOOST_CHECK_EQUAL(table.get_num_empty_buffers(), 0);
+    }
+
+    FrameReceiver::FrameBufferTable unsized_table;
+    unsized_table.push_empty_buffer(100);
+    BOOST_CHECK_EQUAL(unsized_table.acquire_buffer(1, initialiser), 100);
+    for (int buffer_id = 0; buffer_id < 20; buffer_id++)
+    {
+        unsized_table.push_empty_buffer(buffer_id);
+    }
+    BOOST_CHECK_EQUAL(unsized_table.get_num_empty_buffers(), 20);
+    for (int buffer_id = 0; buffer_id < 20; buffer_id++)
+    {
+        BOOST_CHECK_EQUAL(unsized_table.acquire_buffer(buffer_id + 2, initialiser), buffer_id);
+    }
+    BOOST_CHECK_EQUAL(unsized_table.get_num_mapped_buffers(), 21);
+}
+
+BOOST_AUTO_TEST_CASE( SharedByMultipleDecoders )
+{
+    // A table is only shared once more than one decoder has attached to it
+    BOOST_CHECK_EQUAL(table.is_shared(), false);
+    table.attach_decoder();
+    BOOST_CHECK_EQUAL(table.is_shared(), false);
+    table.attach_decoder();
+    BOOST_CHECK_EQUAL(table.is_shared(), true);
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentReleaseIsExclusive )
+{
+    const uint32_t num_frames = 1000;
+
+    for (uint32_t frame = 0; frame < num_frames; frame++)
+    {
+        table.push_empty_buffer(frame);
+        BOOST_REQUIRE_EQUAL(table.acquire_buffer(frame, initialiser), static_cast<int>(frame));
+    }
+
+    // Race several threads to release every frame, each frame must be released exactly once
+    boost::thread_group threads;
+    for (int thread = 0; thread < 4; thread++)
+    {
+        threads.create_thread(boost::bind(&FrameBufferTableTestFixture::release_frames, this, num_frames));
+    }
+    threads.join_all();
+
+    BOOST_CHECK_EQUAL(release_count, static_cast<int>(num_frames));
+    BOOST_CHECK_EQUAL(table.get_num_mapped_buffers(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( ReleaseWaitsForWriters )
+{
+    table.reserve_buffers(2);
+    table.push_empty_buffer(0);
+    table.push_empty_buffer(1);
+    BOOST_CHECK_EQUAL(table.acquire_buffer(10, initialiser), 0);
+    BOOST_CHECK_EQUAL(table.acquire_buffer(11, initialiser), 1);
+
+    // A decoder registers as writing to a buffer it looked up while no buffer has been released
+    uint32_t lookup_release_count = table.get_release_count();
+    BOOST_REQUIRE_EQUAL(table.begin_write(0, lookup_release_count), true);
+
+    // Releasing the frame, e.g. on timeout in another RX thread, waits for the write to finish
+    volatile bool released = false;
+    boost::thread releaser(boost::bind(&FrameBufferTableTestFixture::release_frame_when_written, this, 10, 0, &released));
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    BOOST_CHECK_EQUAL(released, false);
+    table.end_write(0);
+    releaser.join();
+    BOOST_CHECK_EQUAL(released, true);
+
+    // A decoder that looked up a buffer before a release must look it up again before writing
+    BOOST_CHECK_EQUAL(table.begin_write(1, lookup_release_count), false);
+    BOOST_REQUIRE_EQUAL(table.begin_write(1, table.get_release_count()), true);
+    table.end_write(1);
+    BOOST_CHECK_EQUAL(table.release_buffer(11, 1), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,65 @@
+/*!
+ * FrameDecoderRegistryUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "FrameDecoderRegistry.h"
+#include "PercivalEmulatorFrameDecoder.h"
+
+class FrameDecoderRegistryTestFixture
+{
+public:
+    FrameDecoderRegistryTestFixture() :
+        logger(log4cxx::Logger::getLogger("FrameDecoderRegistryUnitTest"))
+    { }
+
+    LoggerPtr logger;
+    FrameReceiver::FrameDecoderParams params;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FrameDecoderRegistryUnitTest, FrameDecoderRegistryTestFixture);
+
+BOOST_AUTO_TEST_CASE( BuiltinDecoders )
+{
+    FrameReceiver::FrameDecoderRegistry registry;
+
+    BOOST_CHECK_EQUAL(registry.has_decoder("percivalemulator"), true);
+    BOOST_CHECK_EQUAL(registry.has_decoder("percival2m"), false);
+
+    FrameReceiver::FrameDecoderPtr decoder = registry.create_decoder("percivalemulator", logger, false, 1000, params);
+    BOOST_CHECK_EQUAL(decoder->get_frame_buffer_size(),
+            static_cast<size_t>(FrameReceiver::PercivalEmulatorFrameDecoder::total_frame_size));
+
+    BOOST_CHECK_THROW(registry.create_decoder("percival2m", logger, false, 1000, params),
+            FrameReceiver::FrameDecoderRegistryException);
+    BOOST_CHECK_THROW(registry.register_decoder("percivalemulator",
+            &FrameReceiver::create_frame_decoder<FrameReceiver::PercivalEmulatorFrameDecoder>),
+            FrameReceiver::FrameDecoderRegistryException);
+}
+
+BOOST_AUTO_TEST_CASE( LoadDecoderPlugin )
+{
+    FrameReceiver::FrameDecoderRegistry registry;
+
+    BOOST_CHECK_THROW(registry.load_plugin("/nonexistent/libNoSuchDecoder.so"), FrameReceiver::FrameDecoderRegistryException);
+
+    registry.load_plugin(TEST_DECODER_PLUGIN_PATH);
+    std::vector<std::string> sensor_names = registry.get_sensor_names();
+    BOOST_REQUIRE_EQUAL(sensor_names.size(), 2);
+    BOOST_CHECK_EQUAL(sensor_names[0], "percivalemulator");
+    BOOST_CHECK_EQUAL(sensor_names[1], "testdecoder");
+
+    // The plugin decoder is configured from the decoder parameters
+    BOOST_CHECK_THROW(registry.create_decoder("testdecoder", logger, false, 1000, params), FrameReceiver::FrameDecoderException);
+
+    params["framesize"] = "4096";
+    FrameReceiver::FrameDecoderPtr decoder = registry.create_decoder("testdecoder", logger, false, 1000, params);
+    BOOST_CHECK_EQUAL(decoder->get_frame_buffer_size(), 4096);
+    decoder->push_empty_buffer(3);
+    BOOST_CHECK_EQUAL(decoder->get_num_empty_buffers(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -14,6 +14,26 @@
 #include <log4cxx/simplelayout.h>
 
 #include "PercivalEmulatorFrameDecoder.h"
+#include "SharedBufferManager.h"
+
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <boost/bind.hpp>
+
+namespace
+{
+    // Detector geometry with several tail packets per subframe
+    struct TestGeometryTraits
+    {
+        static const size_t primary_packet_size = 1000;
+        static const size_t num_primary_packets = 3;
+        static const size_t tail_packet_size    = 100;
+        static const size_t num_tail_packets    = 2;
+        static const size_t num_subframes       = 2;
+        static const size_t num_data_types      = 3;
+    };
+}
 
 class FrameDecoderTestFixture
 {
@@ -23,7 +43,14 @@ public:
     {
 
     }
+
+    void frame_ready(int buffer_id, int frame_number)
+    {
+        ready_frames.push_back(std::make_pair(buffer_id, frame_number));
+    }
+
     log4cxx::LoggerPtr logger;
+    std::vector<std::pair<int, int> > ready_frames;
 };
 BOOST_FIXTURE_TEST_SUITE(FrameDecoderUnitTest, FrameDecoderTestFixture);
 
@@ -64,5 +91,552 @@ BOOST_AUTO_TEST_CASE( PercivalEmulatorDecoderTest )
 
 }
 
+BOOST_AUTO_TEST_CASE( DetectorGeometryTest )
+{
+    typedef FrameReceiver::DetectorGeometry<TestGeometryTraits> Geometry;
+
+    BOOST_CHECK_EQUAL(Geometry::num_subframe_packets, 5);
+    BOOST_CHECK_EQUAL(Geometry::num_frame_packets, 30);
+    BOOST_CHECK_EQUAL(Geometry::subframe_size, 3200);
+    BOOST_CHECK_EQUAL(Geometry::total_frame_size, 19200);
+
+    // Packet indices and payload offsets run contiguously through the frame
+    size_t expected_offset = 0;
+    for (unsigned int type = 0; type < Geometry::num_data_types; type++)
+    {
+        for (unsigned int subframe = 0; subframe < Geometry::num_subframes; subframe++)
+        {
+            for (unsigned int packet = 0; packet < Geometry::num_subframe_packets; packet++)
+            {
+                BOOST_CHECK_EQUAL(Geometry::packet_index(type, subframe, packet),
+                        (((type * Geometry::num_subframes) + subframe) * Geometry::num_subframe_packets) + packet);
+                BOOST_CHECK_EQUAL(Geometry::payload_offset(type, subframe, packet), expected_offset);
+                expected_offset += Geometry::payload_size(packet);
+            }
+        }
+    }
+    BOOST_CHECK_EQUAL(expected_offset, Geometry::total_frame_size);
+}
+
+BOOST_AUTO_TEST_CASE( PercivalEmulatorDecodeAfterReceiveTest )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+
+    boost::shared_ptr<Decoder> decoder(new Decoder(logger));
+    BOOST_CHECK_EQUAL(decoder->requires_header_peek(), false);
+
+    FrameReceiver::SharedBufferManagerPtr buffer_manager(
+            new FrameReceiver::SharedBufferManager("TestDecoderSharedBuffer", Decoder::total_frame_size, Decoder::total_frame_size,
+                    true, 0, sizeof(Decoder::FrameHeader)));
+    decoder->register_buffer_manager(buffer_manager);
+    decoder->push_empty_buffer(0);
+
+    struct sockaddr_in from_addr;
+    memset(&from_addr, 0, sizeof(from_addr));
+
+    uint8_t* hdr_raw = reinterpret_cast<uint8_t*>(decoder->get_packet_header_buffer());
+
+    // Receive the primary packets of the first reset subframe, sending packets 2 and 3 out of order
+    const uint8_t  type = Decoder::PacketTypeReset;
+    const uint8_t  subframe = 0;
+    const uint32_t frame_number = htonl(1);
+    const uint16_t send_order[] = {0, 1, 3, 2, 4, 5, 6, 7};
+    const unsigned int num_packets = sizeof(send_order) / sizeof(send_order[0]);
+
+    for (unsigned int pkt = 0; pkt < num_packets; pkt++)
+    {
+        uint16_t packet_number_be = htons(send_order[pkt]);
+        hdr_raw[0] = type;
+        hdr_raw[1] = subframe;
+        memcpy(&hdr_raw[2], &frame_number, sizeof(frame_number));
+        memcpy(&hdr_raw[6], &packet_number_be, sizeof(packet_number_be));
+
+        // Simulate the receive of the payload into the location offered in advance by the decoder
+        BOOST_REQUIRE_EQUAL(decoder->get_next_payload_size(), static_cast<size_t>(Decoder::primary_packet_size));
+        memset(decoder->get_next_payload_buffer(), send_order[pkt] + 1, Decoder::primary_packet_size);
+
+        size_t bytes_received = sizeof(Decoder::PacketHeader) + Decoder::primary_packet_size;
+        decoder->process_packet_header(bytes_received, 0, &from_addr);
+        decoder->process_packet(bytes_received);
+    }
+
+    // The first packet of the frame and each packet following a misprediction are relocated
+    BOOST_CHECK_EQUAL(decoder->get_num_relocated_packets(), 4);
+
+    // Every payload must have ended up at its correct location in the frame buffer
+    uint8_t* frame_data = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(0)) +
+            (Decoder::data_type_size * type);
+    for (uint16_t packet_number = 0; packet_number < num_packets; packet_number++)
+    {
+        uint8_t* payload = frame_data + (Decoder::primary_packet_size * packet_number);
+        BOOST_CHECK_EQUAL(payload[0], packet_number + 1);
+        BOOST_CHECK_EQUAL(payload[Decoder::primary_packet_size - 1], packet_number + 1);
+    }
+
+    Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(buffer_manager->get_metadata_address(0));
+    BOOST_CHECK_EQUAL(frame_header->packets_received, num_packets);
+    BOOST_CHECK_EQUAL(frame_header->packet_state.count(), num_packets);
+
+    // All packets of the frame after those received are missing
+    std::vector<FrameReceiver::PacketRange> missing;
+    size_t first_missing = Decoder::get_packet_index(type, subframe, num_packets);
+    BOOST_CHECK_EQUAL(decoder->get_missing_packets(0, missing), Decoder::num_frame_packets - num_packets);
+    BOOST_REQUIRE_EQUAL(missing.size(), 2);
+    BOOST_CHECK_EQUAL(missing[0].first, 0);
+    BOOST_CHECK_EQUAL(missing[0].second, Decoder::get_packet_index(type, subframe, 0));
+    BOOST_CHECK_EQUAL(missing[1].first, first_missing);
+    BOOST_CHECK_EQUAL(missing[1].second, Decoder::num_frame_packets - first_missing);
+}
+
+BOOST_AUTO_TEST_CASE( PercivalEmulatorDropInvalidPacketsTest )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+
+    boost::shared_ptr<Decoder> decoder(new Decoder(logger));
+
+    FrameReceiver::SharedBufferManagerPtr buffer_manager(
+            new FrameReceiver::SharedBufferManager("TestDecoderSharedBuffer", Decoder::total_frame_size, Decoder::total_frame_size,
+                    true, 0, sizeof(Decoder::FrameHeader)));
+    decoder->register_buffer_manager(buffer_manager);
+    decoder->push_empty_buffer(0);
+
+    struct sockaddr_in from_addr;
+    memset(&from_addr, 0, sizeof(from_addr));
+
+    uint8_t* hdr_raw = reinterpret_cast<uint8_t*>(decoder->get_packet_header_buffer());
+    const size_t bytes_received = sizeof(Decoder::PacketHeader) + Decoder::primary_packet_size;
+
+    // Packets with header fields out of range, given as type, subframe, packet number and size
+    struct { uint8_t type; uint8_t subframe; uint16_t packet_number; size_t size; } packets[] = {
+        {Decoder::PacketTypeReset, 0, 0, sizeof(Decoder::PacketHeader) - 1},
+        {Decoder::num_data_types, 0, 0, bytes_received},
+        {Decoder::PacketTypeReset, Decoder::num_subframes, 0, bytes_received},
+        {Decoder::PacketTypeReset, 0, Decoder::num_subframe_packets, bytes_received},
+        {Decoder::PacketTypeReset, 0, 0xffff, bytes_received},
+        // Valid packets followed by duplicates of them
+        {Decoder::PacketTypeReset, 0, 0, bytes_received},
+        {Decoder::PacketTypeReset, 0, 1, bytes_received},
+        {Decoder::PacketTypeReset, 0, 0, bytes_received},
+        {Decoder::PacketTypeReset, 0, 1, bytes_received},
+    };
+    const unsigned int num_packets = sizeof(packets) / sizeof(packets[0]);
+    const uint32_t frame_number = htonl(3);
+
+    for (unsigned int pkt = 0; pkt < num_packets; pkt++)
+    {
+        uint16_t packet_number_be = htons(packets[pkt].packet_number);
+        memset(hdr_raw, 0, sizeof(Decoder::PacketHeader));
+        hdr_raw[0] = packets[pkt].type;
+        hdr_raw[1] = packets[pkt].subframe;
+        memcpy(&hdr_raw[2], &frame_number, sizeof(frame_number));
+        memcpy(&hdr_raw[6], &packet_number_be, sizeof(packet_number_be));
+        memset(decoder->get_next_payload_buffer(), pkt + 1, Decoder::primary_packet_size);
+
+        decoder->process_packet_header(packets[pkt].size, 0, &from_addr);
+        BOOST_CHECK_EQUAL(decoder->process_packet(packets[pkt].size), FrameReceiver::FrameDecoder::FrameReceiveStateIncomplete);
+
+        // Invalid packets must not acquire a frame buffer
+        if (pkt < 5)
+        {
+            BOOST_CHECK_EQUAL(decoder->get_num_mapped_buffers(), 0);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropShort), 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropBadType), 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropBadSubframe), 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropBadPacketNumber), 2);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropDuplicate), 2);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(), 7);
+
+    // Only the first copy of each valid packet is counted and kept in the frame buffer
+    Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(buffer_manager->get_metadata_address(0));
+    BOOST_CHECK_EQUAL(frame_header->packets_received, 2);
+    BOOST_CHECK_EQUAL(frame_header->packet_state.count(), 2);
+
+    uint8_t* frame_data = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(0)) +
+            (Decoder::data_type_size * Decoder::PacketTypeReset);
+    BOOST_CHECK_EQUAL(frame_data[0], 6);
+    BOOST_CHECK_EQUAL(frame_data[Decoder::primary_packet_size], 7);
+}
+
+BOOST_AUTO_TEST_CASE( PercivalEmulatorProcessBatchTest )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+
+    boost::shared_ptr<Decoder> decoder(new Decoder(logger));
+
+    FrameReceiver::SharedBufferManagerPtr buffer_manager(
+            new FrameReceiver::SharedBufferManager("TestDecoderSharedBuffer", Decoder::total_frame_size, Decoder::total_frame_size,
+                    true, 0, sizeof(Decoder::FrameHeader)));
+    decoder->register_buffer_manager(buffer_manager);
+    decoder->push_empty_buffer(0);
+
+    struct sockaddr_in from_addr;
+    memset(&from_addr, 0, sizeof(from_addr));
+
+    // Stage a batch of datagrams as received by recvmmsg, with packets out of order, a duplicate
+    // and a packet of an invalid type
+    const uint16_t packet_numbers[] = {0, 2, 1, 0, 3, 4};
+    const uint8_t  packet_types[]   = {Decoder::PacketTypeReset, Decoder::PacketTypeReset, Decoder::PacketTypeReset,
+            Decoder::PacketTypeReset, Decoder::PacketTypeReset, Decoder::num_data_types};
+    const size_t num_datagrams = sizeof(packet_numbers) / sizeof(packet_numbers[0]);
+    const size_t bytes_received = sizeof(Decoder::PacketHeader) + Decoder::primary_packet_size;
+    const uint32_t frame_number = htonl(5);
+
+    std::vector<uint8_t> headers(num_datagrams * sizeof(Decoder::PacketHeader), 0);
+    std::vector<uint8_t> payloads(num_datagrams * Decoder::primary_packet_size);
+    std::vector<FrameReceiver::ReceivedDatagram> datagrams(num_datagrams);
+
+    for (size_t idx = 0; idx < num_datagrams; idx++)
+    {
+        uint8_t* hdr_raw = &headers[idx * sizeof(Decoder::PacketHeader)];
+        uint16_t packet_number_be = htons(packet_numbers[idx]);
+        hdr_raw[0] = packet_types[idx];
+        hdr_raw[1] = 0;
+        memcpy(&hdr_raw[2], &frame_number, sizeof(frame_number));
+        memcpy(&hdr_raw[6], &packet_number_be, sizeof(packet_number_be));
+        memset(&payloads[idx * Decoder::primary_packet_size], idx + 1, Decoder::primary_packet_size);
+
+        datagrams[idx].header = hdr_raw;
+        datagrams[idx].payload = &payloads[idx * Decoder::primary_packet_size];
+        datagrams[idx].bytes_received = bytes_received;
+        datagrams[idx].port = 0;
+        datagrams[idx].from_addr = &from_addr;
+    }
+
+    decoder->process_packets(&datagrams[0], num_datagrams);
+
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropDuplicate), 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropBadType), 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(), 2);
+
+    // Payloads are copied straight to their locations, so none are relocated
+    BOOST_CHECK_EQUAL(decoder->get_num_relocated_packets(), 0);
+
+    Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(buffer_manager->get_metadata_address(0));
+    BOOST_CHECK_EQUAL(frame_header->packets_received, 4);
+    BOOST_CHECK_EQUAL(frame_header->packet_state.count(), 4);
+
+    // Each payload is at the location of its packet, the duplicate not overwriting the first copy
+    const uint8_t expected_fill[] = {1, 3, 2, 5};
+    uint8_t* frame_data = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(0)) +
+            (Decoder::data_type_size * Decoder::PacketTypeReset);
+    for (uint16_t packet_number = 0; packet_number < 4; packet_number++)
+    {
+        uint8_t* payload = frame_data + (Decoder::primary_packet_size * packet_number);
+        BOOST_CHECK_EQUAL(payload[0], expected_fill[packet_number]);
+        BOOST_CHECK_EQUAL(payload[Decoder::primary_packet_size - 1], expected_fill[packet_number]);
+    }
+
+    // The payload of the packet following the batch is predicted to follow the last valid packet
+    BOOST_CHECK_EQUAL(decoder->get_next_payload_buffer(), frame_data + (Decoder::primary_packet_size * 4));
+}
+
+BOOST_AUTO_TEST_CASE( PercivalEmulatorDropFrameWithoutBufferTest )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+
+    boost::shared_ptr<Decoder> decoder(new Decoder(logger));
+
+    FrameReceiver::SharedBufferManagerPtr buffer_manager(
+            new FrameReceiver::SharedBufferManager("TestDecoderSharedBuffer", Decoder::total_frame_size, Decoder::total_frame_size,
+                    true, 0, sizeof(Decoder::FrameHeader)));
+    decoder->register_buffer_manager(buffer_manager);
+
+    struct sockaddr_in from_addr;
+    memset(&from_addr, 0, sizeof(from_addr));
+
+    uint8_t* hdr_raw = reinterpret_cast<uint8_t*>(decoder->get_packet_header_buffer());
+    const uint8_t type = Decoder::PacketTypeReset;
+    const unsigned int num_packets = 4;
+
+    // With no empty buffers the first frame is dropped, the payloads of its packets after the first
+    // being discarded by offering a zero payload size. A buffer is then freed before the second frame,
+    // the payload of whose first packet is discarded in the expectation of it belonging to the first.
+    const size_t expected_payload_size[2][num_packets] = {
+            {Decoder::primary_packet_size, 0, 0, 0},
+            {0, Decoder::primary_packet_size, Decoder::primary_packet_size, Decoder::primary_packet_size}
+    };
+    for (unsigned int frame = 0; frame < 2; frame++)
+    {
+        if (frame == 1)
+        {
+            decoder->push_empty_buffer(0);
+        }
+
+        const uint32_t frame_number = htonl(frame + 1);
+        for (uint16_t packet_number = 0; packet_number < num_packets; packet_number++)
+        {
+            uint16_t packet_number_be = htons(packet_number);
+            memset(hdr_raw, 0, sizeof(Decoder::PacketHeader));
+            hdr_raw[0] = type;
+            memcpy(&hdr_raw[2], &frame_number, sizeof(frame_number));
+            memcpy(&hdr_raw[6], &packet_number_be, sizeof(packet_number_be));
+
+            size_t payload_size = decoder->get_next_payload_size();
+            BOOST_CHECK_EQUAL(payload_size, expected_payload_size[frame][packet_number]);
+            memset(decoder->get_next_payload_buffer(), packet_number + 1, payload_size);
+
+            size_t bytes_received = sizeof(Decoder::PacketHeader) + payload_size;
+            decoder->process_packet_header(bytes_received, 0, &from_addr);
+            decoder->process_packet(bytes_received);
+        }
+    }
+
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_frames(), 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropNoBuffer), num_packets);
+    BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropTruncated), 1);
+
+    // The second frame is received into the freed buffer, apart from the discarded packet
+    BOOST_CHECK_EQUAL(decoder->get_num_mapped_buffers(), 1);
+    Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(buffer_manager->get_metadata_address(0));
+    BOOST_CHECK_EQUAL(frame_header->frame_number, 2);
+    BOOST_CHECK_EQUAL(frame_header->packets_received, num_packets - 1);
+    BOOST_CHECK_EQUAL(frame_header->packet_state.test(Decoder::get_packet_index(type, 0, 0)), false);
+
+    uint8_t* frame_data = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(0)) +
+            (Decoder::data_type_size * type);
+    BOOST_CHECK_EQUAL(frame_data[Decoder::primary_packet_size], 2);
+    BOOST_CHECK_EQUAL(frame_data[Decoder::primary_packet_size * (num_packets - 1)], num_packets);
+}
+
+BOOST_AUTO_TEST_CASE( PercivalEmulatorFrameTimeoutTest )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+
+    const unsigned int frame_timeout_ms = 20;
+    boost::shared_ptr<Decoder> decoder(new Decoder(logger, false, frame_timeout_ms));
+
+    FrameReceiver::SharedBufferManagerPtr buffer_manager(
+            new FrameReceiver::SharedBufferManager("TestDecoderSharedBuffer", Decoder::total_frame_size, Decoder::total_frame_size,
+                    true, 0, sizeof(Decoder::FrameHeader)));
+    decoder->register_buffer_manager(buffer_manager);
+    decoder->register_frame_ready_callback(boost::bind(&FrameDecoderTestFixture::frame_ready, this, _1, _2));
+    decoder->push_empty_buffer(0);
+
+    // Receive a single packet of a frame, leaving it incomplete
+    struct sockaddr_in from_addr;
+    memset(&from_addr, 0, sizeof(from_addr));
+
+    uint8_t* hdr_raw = reinterpret_cast<uint8_t*>(decoder->get_packet_header_buffer());
+    const uint32_t frame_number = htonl(7);
+    memset(hdr_raw, 0, sizeof(Decoder::PacketHeader));
+    hdr_raw[0] = Decoder::PacketTypeReset;
+    memcpy(&hdr_raw[2], &frame_number, sizeof(frame_number));
+
+    size_t bytes_received = sizeof(Decoder::PacketHeader) + Decoder::primary_packet_size;
+    decoder->process_packet_header(bytes_received, 0, &from_addr);
+    decoder->process_packet(bytes_received);
+    BOOST_CHECK_EQUAL(decoder->get_num_mapped_buffers(), 1);
+
+    // The frame is not released before its deadline
+    decoder->check_frame_timeouts();
+    BOOST_CHECK_EQUAL(ready_frames.size(), 0);
+
+    // After the deadline the frame is released in the timed out state
+    usleep((frame_timeout_ms + 10) * 1000);
+    decoder->check_frame_timeouts();
+    BOOST_REQUIRE_EQUAL(ready_frames.size(), 1);
+    BOOST_CHECK_EQUAL(ready_frames[0].first, 0);
+    BOOST_CHECK_EQUAL(ready_frames[0].second, 7);
+    BOOST_CHECK_EQUAL(decoder->get_num_mapped_buffers(), 0);
+
+    Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(buffer_manager->get_metadata_address(0));
+    BOOST_CHECK_EQUAL(frame_header->frame_state, static_cast<uint32_t>(FrameReceiver::FrameDecoder::FrameReceiveStateTimedout));
+
+    // A frame is only timed out once
+    decoder->check_frame_timeouts();
+    BOOST_CHECK_EQUAL(ready_frames.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( PercivalEmulatorRepeatedFrameTimeoutTest )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+    typedef Decoder::Geometry Geometry;
+
+    const unsigned int frame_timeout_ms = 100;
+    boost::shared_ptr<Decoder> decoder(new Decoder(logger, false, frame_timeout_ms));
+
+    FrameReceiver::SharedBufferManagerPtr buffer_manager(
+            new FrameReceiver::SharedBufferManager("TestDecoderSharedBuffer", Decoder::total_frame_size, Decoder::total_frame_size,
+                    true, 0, sizeof(Decoder::FrameHeader)));
+    decoder->register_buffer_manager(buffer_manager);
+    decoder->register_frame_ready_callback(boost::bind(&FrameDecoderTestFixture::frame_ready, this, _1, _2));
+    decoder->push_empty_buffer(0);
+
+    struct sockaddr_in from_addr;
+    memset(&from_addr, 0, sizeof(from_addr));
+
+    // Build the headers of every packet of frame 0, sample packets carrying the preceding frame number
+    std::vector<uint8_t> headers(Geometry::num_frame_packets * Geometry::packet_header_size, 0);
+    for (unsigned int type = 0; type < Geometry::num_data_types; type++)
+    {
+        for (unsigned int subframe = 0; subframe < Geometry::num_subframes; subframe++)
+        {
+            for (unsigned int packet_number = 0; packet_number < Geometry::num_subframe_packets; packet_number++)
+            {
+                uint8_t* header = &headers[Geometry::packet_index(type, subframe, packet_number) * Geometry::packet_header_size];
+                uint32_t frame_number_be = htonl((type == Decoder::PacketTypeSample) ? (uint32_t)-1 : 0);
+                uint16_t packet_number_be = htons(packet_number);
+                header[Geometry::packet_type_offset] = type;
+                header[Geometry::subframe_number_offset] = subframe;
+                memcpy(header + Geometry::frame_number_offset, &frame_number_be, sizeof(frame_number_be));
+                memcpy(header + Geometry::packet_number_offset, &packet_number_be, sizeof(packet_number_be));
+            }
+        }
+    }
+
+    // Receive every packet of frame 0, completing it before its deadline
+    std::vector<uint8_t> payload(Decoder::primary_packet_size, 0x5A);
+    std::vector<FrameReceiver::ReceivedDatagram> datagrams;
+    for (size_t packet = 0; packet < Geometry::num_frame_packets; packet++)
+    {
+        FrameReceiver::ReceivedDatagram datagram;
+        datagram.header         = &headers[packet * Geometry::packet_header_size];
+        datagram.payload        = &payload[0];
+        datagram.bytes_received = Geometry::packet_header_size + Geometry::payload_size(packet % Geometry::num_subframe_packets);
+        datagram.port           = 0;
+        datagram.from_addr      = &from_addr;
+        datagrams.push_back(datagram);
+    }
+    decoder->process_packets(&datagrams[0], datagrams.size());
+    BOOST_REQUIRE_EQUAL(ready_frames.size(), 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_mapped_buffers(), 0);
+
+    // Frame 0 is sent again before the deadline of the first send expires and is received into
+    // the same buffer once it has been returned
+    decoder->push_empty_buffer(0);
+    usleep((frame_timeout_ms / 2) * 1000);
+    decoder->process_packets(&datagrams[Geometry::packet_index(Decoder::PacketTypeReset, 0, 0)], 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_mapped_buffers(), 1);
+
+    // The deadline of the first send does not time out the frame being received again
+    usleep(((frame_timeout_ms / 2) + 20) * 1000);
+    decoder->check_frame_timeouts();
+    BOOST_CHECK_EQUAL(ready_frames.size(), 1);
+    BOOST_CHECK_EQUAL(decoder->get_num_mapped_buffers(), 1);
+
+    // The frame is timed out at its own deadline
+    usleep((frame_timeout_ms / 2) * 1000);
+    decoder->check_frame_timeouts();
+    BOOST_REQUIRE_EQUAL(ready_frames.size(), 2);
+    BOOST_CHECK_EQUAL(ready_frames[1].first, 0);
+    BOOST_CHECK_EQUAL(ready_frames[1].second, 0);
+    BOOST_CHECK_EQUAL(decoder->get_num_mapped_buffers(), 0);
+
+    Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(buffer_manager->get_metadata_address(0));
+    BOOST_CHECK_EQUAL(frame_header->frame_state, static_cast<uint32_t>(FrameReceiver::FrameDecoder::FrameReceiveStateTimedout));
+    BOOST_CHECK_EQUAL(frame_header->packets_received, 1);
+}
+
+BOOST_AUTO_TEST_CASE( PercivalEmulatorSharedTableInterleavedDecodersTest )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+    typedef Decoder::Geometry Geometry;
+
+    // Two decoders sharing a frame buffer table, as in two RX threads receiving the same frame
+    boost::shared_ptr<Decoder> decoder_a(new Decoder(logger));
+    boost::shared_ptr<Decoder> decoder_b(new Decoder(logger));
+
+    FrameReceiver::SharedBufferManagerPtr buffer_manager(
+            new FrameReceiver::SharedBufferManager("TestDecoderSharedBuffer", 2 * Decoder::total_frame_size,
+                    Decoder::total_frame_size, true, 0, sizeof(Decoder::FrameHeader)));
+    FrameReceiver::FrameBufferTablePtr frame_buffer_table(new FrameReceiver::FrameBufferTable());
+
+    decoder_a->register_buffer_manager(buffer_manager);
+    decoder_b->register_buffer_manager(buffer_manager);
+    decoder_a->register_frame_buffer_table(frame_buffer_table);
+    decoder_b->register_frame_buffer_table(frame_buffer_table);
+    decoder_a->register_frame_ready_callback(boost::bind(&FrameDecoderTestFixture::frame_ready, this, _1, _2));
+    decoder_b->register_frame_ready_callback(boost::bind(&FrameDecoderTestFixture::frame_ready, this, _1, _2));
+    BOOST_CHECK_EQUAL(frame_buffer_table->is_shared(), true);
+    decoder_a->push_empty_buffer(0);
+    decoder_a->push_empty_buffer(1);
+
+    struct sockaddr_in from_addr;
+    memset(&from_addr, 0, sizeof(from_addr));
+
+    // Build the headers of every packet of frame 1, sample packets carrying the preceding frame number
+    std::vector<uint8_t> headers(Geometry::num_frame_packets * Geometry::packet_header_size, 0);
+    for (unsigned int type = 0; type < Geometry::num_data_types; type++)
+    {
+        for (unsigned int subframe = 0; subframe < Geometry::num_subframes; subframe++)
+        {
+            for (unsigned int packet_number = 0; packet_number < Geometry::num_subframe_packets; packet_number++)
+            {
+                uint8_t* header = &headers[Geometry::packet_index(type, subframe, packet_number) * Geometry::packet_header_size];
+                uint32_t frame_number_be = htonl((type == Decoder::PacketTypeSample) ? 0 : 1);
+                uint16_t packet_number_be = htons(packet_number);
+                header[Geometry::packet_type_offset] = type;
+                header[Geometry::subframe_number_offset] = subframe;
+                memcpy(header + Geometry::frame_number_offset, &frame_number_be, sizeof(frame_number_be));
+                memcpy(header + Geometry::packet_number_offset, &packet_number_be, sizeof(packet_number_be));
+            }
+        }
+    }
+
+    // Decoder A receives the first reset packet of the frame, then waits for its next datagram
+    const size_t first_packet = Geometry::packet_index(Decoder::PacketTypeReset, 0, 0);
+    memcpy(decoder_a->get_packet_header_buffer(), &headers[first_packet * Geometry::packet_header_size],
+            Geometry::packet_header_size);
+    memset(decoder_a->get_next_payload_buffer(), 0x11, decoder_a->get_next_payload_size());
+    size_t bytes_received = Geometry::packet_header_size + Decoder::primary_packet_size;
+    decoder_a->process_packet_header(bytes_received, 0, &from_addr);
+    decoder_a->process_packet(bytes_received);
+
+    // Decoder A must not offer a location in the frame buffer for its next receive, as the buffer
+    // can be handed on by decoder B before that receive completes
+    uint8_t* next_payload = reinterpret_cast<uint8_t*>(decoder_a->get_next_payload_buffer());
+    uint8_t* buffers_start = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(0));
+    uint8_t* buffers_end = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(1)) + Decoder::total_frame_size;
+    BOOST_CHECK((next_payload < buffers_start) || (next_payload >= buffers_end));
+
+    // Decoder B receives every other packet of the frame, completing and releasing it
+    std::vector<uint8_t> payload(Decoder::primary_packet_size, 0x5A);
+    std::vector<FrameReceiver::ReceivedDatagram> datagrams;
+    for (size_t packet = 0; packet < Geometry::num_frame_packets; packet++)
+    {
+        if (packet == first_packet)
+        {
+            continue;
+        }
+        FrameReceiver::ReceivedDatagram datagram;
+        datagram.header         = &headers[packet * Geometry::packet_header_size];
+        datagram.payload        = &payload[0];
+        datagram.bytes_received = Geometry::packet_header_size + Geometry::payload_size(packet % Geometry::num_subframe_packets);
+        datagram.port           = 0;
+        datagram.from_addr      = &from_addr;
+        datagrams.push_back(datagram);
+    }
+    decoder_b->process_packets(&datagrams[0], datagrams.size());
+
+    BOOST_REQUIRE_EQUAL(ready_frames.size(), 1);
+    BOOST_CHECK_EQUAL(ready_frames[0].first, 0);
+    BOOST_CHECK_EQUAL(ready_frames[0].second, 1);
+
+    // The next datagram of decoder A now lands, belonging to the following frame
+    memset(decoder_a->get_next_payload_buffer(), 0xEE, decoder_a->get_next_payload_size());
+    uint8_t* header_a = reinterpret_cast<uint8_t*>(decoder_a->get_packet_header_buffer());
+    memcpy(header_a, &headers[Geometry::packet_index(Decoder::PacketTypeReset, 0, 1) * Geometry::packet_header_size],
+            Geometry::packet_header_size);
+    uint32_t next_frame_be = htonl(2);
+    memcpy(header_a + Geometry::frame_number_offset, &next_frame_be, sizeof(next_frame_be));
+    decoder_a->process_packet_header(bytes_received, 0, &from_addr);
+    decoder_a->process_packet(bytes_received);
+
+    // The released frame is intact and the late payload is placed in the buffer of the next frame
+    size_t payload_offset = Geometry::payload_offset(Decoder::PacketTypeReset, 0, 1);
+    uint8_t* released_frame = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(0));
+    uint8_t* next_frame = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(1));
+    BOOST_CHECK_EQUAL(released_frame[Geometry::payload_offset(Decoder::PacketTypeReset, 0, 0)], 0x11);
+    BOOST_CHECK_EQUAL(released_frame[payload_offset], 0x5A);
+    BOOST_CHECK_EQUAL(released_frame[payload_offset + Decoder::primary_packet_size - 1], 0x5A);
+    BOOST_CHECK_EQUAL(next_frame[payload_offset], 0xEE);
+
+    Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(buffer_manager->get_metadata_address(0));
+    BOOST_CHECK_EQUAL(frame_header->packets_received, static_cast<uint32_t>(Decoder::num_frame_packets));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
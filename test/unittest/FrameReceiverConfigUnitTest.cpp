@@ -32,6 +32,13 @@ namespace FrameReceiver
             }
             BOOST_CHECK_EQUAL(mConfig.rx_address_, FrameReceiver::Defaults::default_rx_address);
         }
+        void test_decoder_params(void)
+        {
+            BOOST_REQUIRE_EQUAL(mConfig.decoder_params_.size(), 3);
+            BOOST_CHECK_EQUAL(mConfig.decoder_params_["framesize"], "1024");
+            BOOST_CHECK_EQUAL(mConfig.decoder_params_["layout"], "a=b");
+            BOOST_CHECK_EQUAL(mConfig.decoder_params_["empty"], "");
+        }
     private:
         FrameReceiver::FrameReceiverConfig& mConfig;
     };
@@ -65,6 +72,52 @@ BOOST_AUTO_TEST_CASE( ValidSensorNameToTypeMapping )
     BOOST_CHECK_EQUAL(theConfig.map_sensor_name_to_type(badName), FrameReceiver::Defaults::SensorTypeIllegal);
 }
 
+BOOST_AUTO_TEST_CASE( ValidDecoderParamParsing )
+{
+    FrameReceiver::FrameReceiverConfig theConfig;
+    FrameReceiver::FrameReceiverConfigTestProxy testProxy(theConfig);
+
+    BOOST_CHECK_EQUAL(theConfig.add_decoder_param("framesize=1024"), true);
+    BOOST_CHECK_EQUAL(theConfig.add_decoder_param("layout=a=b"), true);
+    BOOST_CHECK_EQUAL(theConfig.add_decoder_param("empty="), true);
+    BOOST_CHECK_EQUAL(theConfig.add_decoder_param("novalue"), false);
+    BOOST_CHECK_EQUAL(theConfig.add_decoder_param("=noname"), false);
+
+    testProxy.test_decoder_params();
+}
+
+BOOST_AUTO_TEST_CASE( ValidCpuListAndNumaNodeParsing )
+{
+    FrameReceiver::FrameReceiverConfig theConfig;
+
+    // CPU lists may include CPU 0 and ignore malformed entries
+    std::vector<int> cpu_list;
+    theConfig.tokenize_cpu_list(cpu_list, "0,3,foo,12");
+    BOOST_REQUIRE_EQUAL(cpu_list.size(), 3);
+    BOOST_CHECK_EQUAL(cpu_list[0], 0);
+    BOOST_CHECK_EQUAL(cpu_list[1], 3);
+    BOOST_CHECK_EQUAL(cpu_list[2], 12);
+
+    cpu_list.clear();
+    theConfig.tokenize_cpu_list(cpu_list, FrameReceiver::Defaults::default_rx_cpu_list);
+    BOOST_CHECK_EQUAL(cpu_list.size(), 0);
+
+    BOOST_CHECK_EQUAL(theConfig.map_numa_node_option("none"), FrameReceiver::Defaults::numa_node_none);
+    BOOST_CHECK_EQUAL(theConfig.map_numa_node_option("auto"), FrameReceiver::Defaults::numa_node_auto);
+    BOOST_CHECK_EQUAL(theConfig.map_numa_node_option("1"), 1);
+    BOOST_CHECK_EQUAL(theConfig.map_numa_node_option("1x"), FrameReceiver::Defaults::numa_node_none);
+}
+
+BOOST_AUTO_TEST_CASE( ValidNotifyFormatNameMapping )
+{
+    FrameReceiver::FrameReceiverConfig theConfig;
+
+    BOOST_CHECK_EQUAL(theConfig.map_notify_format_name(FrameReceiver::Defaults::default_notify_format),
+            FrameReceiver::Defaults::NotificationFormatJson);
+    BOOST_CHECK_EQUAL(theConfig.map_notify_format_name("binary"), FrameReceiver::Defaults::NotificationFormatBinary);
+    BOOST_CHECK_EQUAL(theConfig.map_notify_format_name("xml"), FrameReceiver::Defaults::NotificationFormatIllegal);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 
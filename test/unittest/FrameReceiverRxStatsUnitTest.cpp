@@ -0,0 +1,144 @@
+/*!
+ * FrameReceiverRxStatsUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include "FrameReceiverRxStats.h"
+#include "IpcMessage.h"
+
+namespace
+{
+    void count_packets(FrameReceiver::FrameReceiverRxStats* stats, unsigned int port_slot, unsigned int num_packets,
+            volatile bool* done)
+    {
+        for (unsigned int packet = 0; packet < num_packets; packet++)
+        {
+            stats->count_receive_calls(1);
+            stats->count_packets(port_slot, 1, 100);
+        }
+        __sync_synchronize();
+        *done = true;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(FrameReceiverRxStatsUnitTest);
+
+BOOST_AUTO_TEST_CASE( CountersStartAtZero )
+{
+    FrameReceiver::FrameReceiverRxStats stats;
+    stats.add_port(8000);
+
+    FrameReceiver::FrameReceiverRxStats::Snapshot snapshot;
+    stats.snapshot(snapshot);
+
+    BOOST_CHECK_EQUAL(snapshot.packets_received, 0);
+    BOOST_CHECK_EQUAL(snapshot.bytes_received, 0);
+    BOOST_CHECK_EQUAL(snapshot.receive_calls, 0);
+    BOOST_CHECK_EQUAL(snapshot.frames_released, 0);
+    BOOST_CHECK_EQUAL(snapshot.frames_dropped, 0);
+    BOOST_REQUIRE_EQUAL(snapshot.ports.size(), 1);
+    BOOST_CHECK_EQUAL(snapshot.ports[0].port, 8000);
+    BOOST_CHECK_EQUAL(snapshot.ports[0].packets_received, 0);
+}
+
+BOOST_AUTO_TEST_CASE( CountPacketsAndFrames )
+{
+    FrameReceiver::FrameReceiverRxStats stats;
+    unsigned int slot_a = stats.add_port(8000);
+    unsigned int slot_b = stats.add_port(8001);
+    BOOST_CHECK_EQUAL(stats.get_num_ports(), 2);
+
+    stats.count_receive_calls(3);
+    stats.count_packets(slot_a, 2, 2000);
+    stats.count_packets(slot_b, 16, 16000);
+    stats.count_frame_released(true, false);
+    stats.count_frame_released(false, true);
+    stats.count_frame_released(false, false);
+    stats.count_buffers_released(5);
+    stats.update_decoder_state(7, 3, 2);
+
+    FrameReceiver::FrameReceiverRxStats::Snapshot snapshot;
+    stats.snapshot(snapshot);
+
+    BOOST_CHECK_EQUAL(snapshot.packets_received, 18);
+    BOOST_CHECK_EQUAL(snapshot.bytes_received, 18000);
+    BOOST_CHECK_EQUAL(snapshot.receive_calls, 3);
+    BOOST_CHECK_EQUAL(snapshot.frames_complete, 1);
+    BOOST_CHECK_EQUAL(snapshot.frames_timedout, 1);
+    BOOST_CHECK_EQUAL(snapshot.frames_released, 3);
+    BOOST_CHECK_EQUAL(snapshot.buffers_released, 5);
+    BOOST_CHECK_EQUAL(snapshot.frames_dropped, 7);
+    BOOST_CHECK_EQUAL(snapshot.empty_buffers, 3);
+    BOOST_CHECK_EQUAL(snapshot.mapped_buffers, 2);
+    BOOST_REQUIRE_EQUAL(snapshot.ports.size(), 2);
+    BOOST_CHECK_EQUAL(snapshot.ports[0].packets_received, 2);
+    BOOST_CHECK_EQUAL(snapshot.ports[0].bytes_received, 2000);
+    BOOST_CHECK_EQUAL(snapshot.ports[1].port, 8001);
+    BOOST_CHECK_EQUAL(snapshot.ports[1].packets_received, 16);
+
+    // Decoder state is replaced rather than accumulated
+    stats.update_decoder_state(8, 0, 1);
+    stats.snapshot(snapshot);
+    BOOST_CHECK_EQUAL(snapshot.frames_dropped, 8);
+    BOOST_CHECK_EQUAL(snapshot.empty_buffers, 0);
+    BOOST_CHECK_EQUAL(snapshot.mapped_buffers, 1);
+}
+
+BOOST_AUTO_TEST_CASE( AddParamsToMessage )
+{
+    FrameReceiver::FrameReceiverRxStats stats;
+    unsigned int slot = stats.add_port(8000);
+    stats.count_receive_calls(2);
+    stats.count_packets(slot, 8, 8000);
+    stats.count_frame_released(true, false);
+
+    FrameReceiver::IpcMessage status_reply(FrameReceiver::IpcMessage::MsgTypeAck, FrameReceiver::IpcMessage::MsgValCmdStatus);
+    stats.add_params(status_reply, "rx_thread_0/");
+
+    // Parameters survive encoding, as they are read by a client of the control channel
+    FrameReceiver::IpcMessage decoded(status_reply.encode());
+    BOOST_CHECK_EQUAL(decoded.get_param<uint64_t>("rx_thread_0/packets_received"), 8);
+    BOOST_CHECK_EQUAL(decoded.get_param<uint64_t>("rx_thread_0/bytes_received"), 8000);
+    BOOST_CHECK_EQUAL(decoded.get_param<uint64_t>("rx_thread_0/receive_calls"), 2);
+    BOOST_CHECK_CLOSE(decoded.get_param<double>("rx_thread_0/syscalls_per_packet"), 0.25, 0.001);
+    BOOST_CHECK_EQUAL(decoded.get_param<uint64_t>("rx_thread_0/frames_complete"), 1);
+    BOOST_CHECK_EQUAL(decoded.get_param<uint64_t>("rx_thread_0/frames_timedout"), 0);
+    BOOST_CHECK_EQUAL(decoded.get_param<uint64_t>("rx_thread_0/port_8000/packets_received"), 8);
+    BOOST_CHECK_EQUAL(decoded.get_param<uint64_t>("rx_thread_0/port_8000/bytes_received"), 8000);
+}
+
+BOOST_AUTO_TEST_CASE( ReadWhileCounting )
+{
+    const unsigned int num_packets = 1000000;
+
+    FrameReceiver::FrameReceiverRxStats stats;
+    unsigned int slot = stats.add_port(8000);
+    volatile bool done = false;
+
+    boost::thread writer(boost::bind(count_packets, &stats, slot, num_packets, &done));
+
+    // Counters read while the writer is running never go backwards or exceed the final count
+    FrameReceiver::FrameReceiverRxStats::Snapshot snapshot;
+    uint64_t last_packets = 0;
+    bool monotonic = true;
+    while (!done)
+    {
+        stats.snapshot(snapshot);
+        monotonic &= (snapshot.packets_received >= last_packets) && (snapshot.packets_received <= num_packets);
+        last_packets = snapshot.packets_received;
+    }
+    writer.join();
+    BOOST_CHECK(monotonic);
+
+    stats.snapshot(snapshot);
+    BOOST_CHECK_EQUAL(snapshot.packets_received, num_packets);
+    BOOST_CHECK_EQUAL(snapshot.bytes_received, (uint64_t)num_packets * 100);
+    BOOST_CHECK_EQUAL(snapshot.ports[0].packets_received, num_packets);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -9,6 +9,7 @@
 
 #include "FrameReceiverRxThread.h"
 #include "IpcMessage.h"
+#include "IpcFrameNotification.h"
 #include "SharedBufferManager.h"
 #include "FrameDecoder.h"
 #include "PercivalEmulatorFrameDecoder.h"
@@ -18,6 +19,9 @@
 #include <log4cxx/basicconfigurator.h>
 #include <log4cxx/simplelayout.h>
 
+#include <arpa/inet.h>
+#include <unistd.h>
+
 namespace FrameReceiver
 {
     class FrameReceiverRxThreadTestProxy
@@ -37,6 +41,22 @@ namespace FrameReceiver
         {
             return config_.rx_channel_endpoint_;
         }
+
+        void set_rx_ports(const std::string& port_list)
+        {
+            config_.rx_ports_.clear();
+            config_.tokenize_port_list(config_.rx_ports_, port_list);
+        }
+
+        void set_rx_batch_size(unsigned int batch_size)
+        {
+            config_.rx_batch_size_ = batch_size;
+        }
+
+        void set_rx_threads(unsigned int rx_threads)
+        {
+            config_.rx_threads_ = rx_threads;
+        }
     private:
         FrameReceiver::FrameReceiverConfig& config_;
     };
@@ -54,6 +74,13 @@ public:
 
         BOOST_TEST_MESSAGE("Setup test fixture");
 
+        // Use a unique channel endpoint for each test case, as inproc endpoints are not always
+        // released immediately when the previous fixture is torn down
+        static int fixture_count = 0;
+        std::stringstream ss;
+        ss << proxy.get_rx_channel_endpoint() << "_" << fixture_count++;
+        proxy.get_rx_channel_endpoint() = ss.str();
+
         // Bind the endpoint of the channel to communicate with the RX thread
         rx_channel.bind(proxy.get_rx_channel_endpoint());
 
@@ -113,6 +140,7 @@ BOOST_AUTO_TEST_CASE( CreateAndPingRxThread )
                 msgMatch &= (response.get_msg_type() == FrameReceiver::IpcMessage::MsgTypeAck);
                 msgMatch &= (response.get_msg_val() == FrameReceiver::IpcMessage::MsgValCmdStatus);
                 msgMatch &= (response.get_param<int>("count", -1) == replyCount);
+                msgMatch &= (response.get_param<uint64_t>("packets_received", 1) == 0);
                 replyCount++;
                 timeoutCount = 0;
             }
@@ -135,6 +163,275 @@ BOOST_AUTO_TEST_CASE( CreateAndPingRxThread )
 
 }
 
+BOOST_AUTO_TEST_CASE( ConfigureNotificationFormat )
+{
+    bool initOK = true;
+
+    try {
+        FrameReceiver::FrameReceiverRxThread rxThread(config, logger, buffer_manager, frame_decoder, 1);
+
+        const char* formats[] = {"binary", "xml"};
+        FrameReceiver::IpcMessage::MsgType expected_types[] = {
+                FrameReceiver::IpcMessage::MsgTypeAck, FrameReceiver::IpcMessage::MsgTypeNack};
+
+        for (int i = 0; i < 2; i++)
+        {
+            FrameReceiver::IpcMessage configure_msg(FrameReceiver::IpcMessage::MsgTypeCmd, FrameReceiver::IpcMessage::MsgValCmdConfigure);
+            configure_msg.set_param("notification_format", std::string(formats[i]));
+            rx_channel.send(configure_msg.encode());
+
+            BOOST_REQUIRE(rx_channel.poll(1000));
+            FrameReceiver::IpcMessage reply(rx_channel.recv().c_str());
+            BOOST_CHECK_EQUAL(reply.get_msg_type(), expected_types[i]);
+            BOOST_CHECK_EQUAL(reply.get_msg_val(), FrameReceiver::IpcMessage::MsgValCmdConfigure);
+        }
+    }
+    catch (FrameReceiver::FrameReceiverException& e)
+    {
+        initOK = false;
+        BOOST_TEST_MESSAGE("Creation of FrameReceiverRxThread failed: " << e.what());
+    }
+    BOOST_REQUIRE_EQUAL(initOK, true);
+}
+
+BOOST_AUTO_TEST_CASE( ReceiveFrameWithBatchedReceive )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+
+    const uint16_t rx_port = 8989;
+    proxy.set_rx_ports("8989");
+    proxy.set_rx_batch_size(16);
+
+    FrameReceiver::SharedBufferManagerPtr frame_buffers(
+            new FrameReceiver::SharedBufferManager("TestBatchSharedBuffer", Decoder::total_frame_size, Decoder::total_frame_size,
+                    true, 0, sizeof(Decoder::FrameHeader)));
+    frame_decoder->register_buffer_manager(frame_buffers);
+
+    bool initOK = true;
+
+    try {
+        FrameReceiver::FrameReceiverRxThread rxThread(config, logger, frame_buffers, frame_decoder, 1);
+
+        // Select binary frame ready notifications
+        FrameReceiver::IpcMessage configure_msg(FrameReceiver::IpcMessage::MsgTypeCmd, FrameReceiver::IpcMessage::MsgValCmdConfigure);
+        configure_msg.set_param("notification_format", std::string("binary"));
+        rx_channel.send(configure_msg.encode());
+        BOOST_REQUIRE(rx_channel.poll(1000));
+        FrameReceiver::IpcMessage configure_reply(rx_channel.recv().c_str());
+        BOOST_CHECK_EQUAL(configure_reply.get_msg_type(), FrameReceiver::IpcMessage::MsgTypeAck);
+
+        // Hand the only frame buffer to the RX thread
+        FrameReceiver::IpcMessage release_msg(FrameReceiver::IpcMessage::MsgTypeNotify, FrameReceiver::IpcMessage::MsgValNotifyFrameRelease);
+        release_msg.set_param<int>("buffer_id", 0);
+        rx_channel.send(release_msg.encode());
+
+        int send_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        BOOST_REQUIRE(send_socket >= 0);
+
+        struct sockaddr_in dest_addr;
+        memset(&dest_addr, 0, sizeof(dest_addr));
+        dest_addr.sin_family      = AF_INET;
+        dest_addr.sin_port        = htons(rx_port);
+        dest_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+        // Send a complete emulator frame, sample packets followed by reset packets. The emulator
+        // firmware numbers the sample frame one lower than the matching reset frame.
+        std::vector<uint8_t> packet(sizeof(Decoder::PacketHeader) + Decoder::primary_packet_size, 0);
+        int packets_sent = 0;
+        for (uint8_t type = 0; type < Decoder::num_data_types; type++)
+        {
+            uint32_t frame_number = htonl(type);
+            for (uint8_t subframe = 0; subframe < Decoder::num_subframes; subframe++)
+            {
+                for (uint16_t packet_number = 0; packet_number < Decoder::num_primary_packets + Decoder::num_tail_packets; packet_number++)
+                {
+                    size_t payload_size = (packet_number < Decoder::num_primary_packets) ?
+                            Decoder::primary_packet_size : Decoder::tail_packet_size;
+                    uint16_t packet_number_be = htons(packet_number);
+
+                    packet[0] = type;
+                    packet[1] = subframe;
+                    memcpy(&packet[2], &frame_number, sizeof(frame_number));
+                    memcpy(&packet[6], &packet_number_be, sizeof(packet_number_be));
+
+                    sendto(send_socket, &packet[0], sizeof(Decoder::PacketHeader) + payload_size, 0,
+                            (struct sockaddr*)&dest_addr, sizeof(dest_addr));
+
+                    // Pace the transmission so that the receive socket buffer does not overflow
+                    if (++packets_sent % 32 == 0)
+                    {
+                        usleep(1000);
+                    }
+                }
+            }
+        }
+        close(send_socket);
+
+        // Wait for the frame ready notification from the RX thread
+        bool frame_ready = false;
+        int timeoutCount = 0;
+        while (!frame_ready && (timeoutCount < 20))
+        {
+            if (rx_channel.poll(100))
+            {
+                std::string ready_encoded = rx_channel.recv();
+                BOOST_REQUIRE(FrameReceiver::IpcFrameNotification::is_binary(ready_encoded));
+                FrameReceiver::IpcFrameNotification ready_msg(ready_encoded);
+                frame_ready = (ready_msg.get_msg_val() == FrameReceiver::IpcMessage::MsgValNotifyFrameReady);
+                BOOST_CHECK_EQUAL(ready_msg.get_buffer_id(), 0);
+                BOOST_CHECK_EQUAL(ready_msg.get_frame_number(), 1);
+                BOOST_CHECK_EQUAL(ready_msg.get_frame_state(), FrameReceiver::FrameDecoder::FrameReceiveStateComplete);
+                BOOST_CHECK(ready_msg.get_frame_start_time_ns() > 0);
+            }
+            else
+            {
+                timeoutCount++;
+            }
+        }
+        BOOST_CHECK_EQUAL(frame_ready, true);
+
+        Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(frame_buffers->get_metadata_address(0));
+        BOOST_CHECK_EQUAL(frame_header->packets_received, static_cast<uint32_t>(Decoder::num_frame_packets));
+        BOOST_CHECK_EQUAL(frame_header->frame_state, FrameReceiver::FrameDecoder::FrameReceiveStateComplete);
+
+        // The statistics block is read while the RX thread is still running
+        FrameReceiver::FrameReceiverRxStats::Snapshot stats;
+        rxThread.get_stats().snapshot(stats);
+        BOOST_CHECK_EQUAL(stats.packets_received, static_cast<uint64_t>(Decoder::num_frame_packets));
+        BOOST_CHECK(stats.receive_calls > 0);
+        BOOST_CHECK_EQUAL(stats.frames_complete, 1);
+        BOOST_CHECK_EQUAL(stats.frames_released, 1);
+        BOOST_REQUIRE_EQUAL(stats.ports.size(), 1);
+        BOOST_CHECK_EQUAL(stats.ports[0].port, rx_port);
+        BOOST_CHECK_EQUAL(stats.ports[0].packets_received, stats.packets_received);
+    }
+    catch (FrameReceiver::FrameReceiverException& e)
+    {
+        initOK = false;
+        BOOST_TEST_MESSAGE("Creation of FrameReceiverRxThread failed: " << e.what());
+    }
+    BOOST_REQUIRE_EQUAL(initOK, true);
+}
+
+BOOST_AUTO_TEST_CASE( ReceiveFrameWithMultipleRxThreads )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+
+    // Two RX threads, each receiving on one port, with decoders sharing a frame buffer table
+    const uint16_t rx_ports[] = {8991, 8992};
+    proxy.set_rx_ports("8991,8992");
+    proxy.set_rx_threads(2);
+
+    FrameReceiver::IpcChannel thread_channel_0(ZMQ_PAIR);
+    FrameReceiver::IpcChannel thread_channel_1(ZMQ_PAIR);
+    std::string thread_endpoint_0 = config.get_rx_channel_endpoint(0);
+    std::string thread_endpoint_1 = config.get_rx_channel_endpoint(1);
+    thread_channel_0.bind(thread_endpoint_0);
+    thread_channel_1.bind(thread_endpoint_1);
+    FrameReceiver::IpcChannel* thread_channels[] = {&thread_channel_0, &thread_channel_1};
+
+    FrameReceiver::SharedBufferManagerPtr frame_buffers(
+            new FrameReceiver::SharedBufferManager("TestMultiRxSharedBuffer", Decoder::total_frame_size, Decoder::total_frame_size,
+                    true, 0, sizeof(Decoder::FrameHeader)));
+    FrameReceiver::FrameBufferTablePtr frame_buffer_table(new FrameReceiver::FrameBufferTable());
+    FrameReceiver::FrameDecoderPtr decoders[2];
+    for (int rx_thread = 0; rx_thread < 2; rx_thread++)
+    {
+        decoders[rx_thread].reset(new Decoder(logger));
+        decoders[rx_thread]->register_buffer_manager(frame_buffers);
+        decoders[rx_thread]->register_frame_buffer_table(frame_buffer_table);
+    }
+
+    bool initOK = true;
+
+    try {
+        FrameReceiver::FrameReceiverRxThread rxThread0(config, logger, frame_buffers, decoders[0], 1, 0);
+        FrameReceiver::FrameReceiverRxThread rxThread1(config, logger, frame_buffers, decoders[1], 1, 1);
+
+        // Hand the only frame buffer to the first RX thread's empty buffer queue, it is then
+        // available to both
+        BOOST_CHECK_EQUAL(rxThread0.push_empty_buffer(0), true);
+        while (frame_buffer_table->get_num_empty_buffers() == 0)
+        {
+            usleep(1000);
+        }
+
+        int send_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        BOOST_REQUIRE(send_socket >= 0);
+
+        // Send the sample packets of the frame to one port and the reset packets to the other
+        std::vector<uint8_t> packet(sizeof(Decoder::PacketHeader) + Decoder::primary_packet_size, 0);
+        int packets_sent = 0;
+        for (uint8_t type = 0; type < Decoder::num_data_types; type++)
+        {
+            struct sockaddr_in dest_addr;
+            memset(&dest_addr, 0, sizeof(dest_addr));
+            dest_addr.sin_family      = AF_INET;
+            dest_addr.sin_port        = htons(rx_ports[type]);
+            dest_addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+            uint32_t frame_number = htonl(type);
+            for (uint8_t subframe = 0; subframe < Decoder::num_subframes; subframe++)
+            {
+                for (uint16_t packet_number = 0; packet_number < Decoder::num_primary_packets + Decoder::num_tail_packets; packet_number++)
+                {
+                    size_t payload_size = (packet_number < Decoder::num_primary_packets) ?
+                            Decoder::primary_packet_size : Decoder::tail_packet_size;
+                    uint16_t packet_number_be = htons(packet_number);
+
+                    packet[0] = type;
+                    packet[1] = subframe;
+                    memcpy(&packet[2], &frame_number, sizeof(frame_number));
+                    memcpy(&packet[6], &packet_number_be, sizeof(packet_number_be));
+
+                    sendto(send_socket, &packet[0], sizeof(Decoder::PacketHeader) + payload_size, 0,
+                            (struct sockaddr*)&dest_addr, sizeof(dest_addr));
+
+                    if (++packets_sent % 32 == 0)
+                    {
+                        usleep(1000);
+                    }
+                }
+            }
+        }
+        close(send_socket);
+
+        // Exactly one of the threads should notify that the frame is ready
+        int frames_ready = 0;
+        int timeoutCount = 0;
+        while (timeoutCount < 10)
+        {
+            bool msg_received = false;
+            for (int rx_thread = 0; rx_thread < 2; rx_thread++)
+            {
+                if (thread_channels[rx_thread]->poll(50))
+                {
+                    FrameReceiver::IpcMessage ready_msg(thread_channels[rx_thread]->recv().c_str());
+                    if (ready_msg.get_msg_val() == FrameReceiver::IpcMessage::MsgValNotifyFrameReady)
+                    {
+                        frames_ready++;
+                        BOOST_CHECK_EQUAL(ready_msg.get_param<int>("buffer_id", -1), 0);
+                        BOOST_CHECK_EQUAL(ready_msg.get_param<int>("frame", -1), 1);
+                    }
+                    msg_received = true;
+                }
+            }
+            timeoutCount = msg_received ? 0 : timeoutCount + 1;
+        }
+        BOOST_CHECK_EQUAL(frames_ready, 1);
+
+        Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(frame_buffers->get_metadata_address(0));
+        BOOST_CHECK_EQUAL(frame_header->packets_received, static_cast<uint32_t>(Decoder::num_frame_packets));
+        BOOST_CHECK_EQUAL(frame_header->frame_state, FrameReceiver::FrameDecoder::FrameReceiveStateComplete);
+    }
+    catch (FrameReceiver::FrameReceiverException& e)
+    {
+        initOK = false;
+        BOOST_TEST_MESSAGE("Creation of FrameReceiverRxThread failed: " << e.what());
+    }
+    BOOST_REQUIRE_EQUAL(initOK, true);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 
@@ -0,0 +1,115 @@
+/*!
+ * FrameSlotTableUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+
+#include "FrameSlotTable.h"
+
+BOOST_AUTO_TEST_SUITE(FrameSlotTableUnitTest);
+
+BOOST_AUTO_TEST_CASE( InsertFindAndErase )
+{
+    FrameReceiver::FrameSlotTable table(4);
+    BOOST_CHECK_EQUAL(table.capacity(), 8);
+
+    BOOST_CHECK_EQUAL(table.insert(10, 1), true);
+    BOOST_CHECK_EQUAL(table.insert(11, 2), true);
+    BOOST_CHECK_EQUAL(table.insert(10, 3), false);
+    BOOST_CHECK_EQUAL(table.size(), 2);
+
+    BOOST_CHECK_EQUAL(table.find(10), 1);
+    BOOST_CHECK_EQUAL(table.find(11), 2);
+    BOOST_CHECK_EQUAL(table.find(12), -1);
+
+    BOOST_CHECK_EQUAL(table.erase(10), true);
+    BOOST_CHECK_EQUAL(table.erase(10), false);
+    BOOST_CHECK_EQUAL(table.find(10), -1);
+    BOOST_CHECK_EQUAL(table.find(11), 2);
+    BOOST_CHECK_EQUAL(table.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( CollisionsAndWraparound )
+{
+    FrameReceiver::FrameSlotTable table(4);
+
+    // Frame numbers either side of wraparound and with the same home slot all remain reachable
+    const uint32_t frames[] = {0xFFFFFFFE, 0xFFFFFFFF, 0, 6, 14, 22};
+    const int num_frames = sizeof(frames) / sizeof(frames[0]);
+
+    for (int i = 0; i < num_frames; i++)
+    {
+        BOOST_CHECK_EQUAL(table.insert(frames[i], i), true);
+    }
+    BOOST_CHECK(table.get_num_collisions() > 0);
+
+    // The table always keeps a free slot to terminate probe sequences
+    BOOST_CHECK_EQUAL(table.insert(100, 100), true);
+    BOOST_CHECK_EQUAL(table.insert(101, 101), false);
+    BOOST_CHECK_EQUAL(table.erase(100), true);
+
+    for (int i = 0; i < num_frames; i++)
+    {
+        BOOST_CHECK_EQUAL(table.find(frames[i]), i);
+    }
+
+    // Erase entries from the middle of probe runs and check the remainder are still found
+    BOOST_CHECK_EQUAL(table.erase(0xFFFFFFFE), true);
+    BOOST_CHECK_EQUAL(table.erase(6), true);
+    BOOST_CHECK_EQUAL(table.find(0xFFFFFFFF), 1);
+    BOOST_CHECK_EQUAL(table.find(0), 2);
+    BOOST_CHECK_EQUAL(table.find(14), 4);
+    BOOST_CHECK_EQUAL(table.find(22), 5);
+    BOOST_CHECK_EQUAL(table.size(), 4);
+
+    // Growing the table preserves the entries
+    table.reserve(100);
+    BOOST_CHECK_EQUAL(table.capacity(), 256);
+    BOOST_CHECK_EQUAL(table.find(22), 5);
+
+    std::vector<std::pair<uint32_t, int> > entries;
+    table.get_entries(entries);
+    BOOST_CHECK_EQUAL(entries.size(), 4);
+}
+
+BOOST_AUTO_TEST_CASE( RandomisedAgainstMap )
+{
+    FrameReceiver::FrameSlotTable table(64);
+    std::map<uint32_t, int> reference;
+
+    uint32_t seed = 12345;
+    for (int op = 0; op < 100000; op++)
+    {
+        seed = seed * 1103515245 + 12345;
+        uint32_t frame = (seed >> 8) & 0xFF;
+
+        if (seed & 0x80000000)
+        {
+            bool inserted = table.insert(frame, op & 0xFFFF);
+            if (inserted)
+            {
+                reference[frame] = op & 0xFFFF;
+            }
+            else
+            {
+                BOOST_REQUIRE(reference.count(frame) || (reference.size() == table.capacity() - 1));
+            }
+        }
+        else
+        {
+            BOOST_REQUIRE_EQUAL(table.erase(frame), reference.erase(frame) == 1);
+        }
+        BOOST_REQUIRE_EQUAL(table.size(), reference.size());
+    }
+
+    for (std::map<uint32_t, int>::iterator itr = reference.begin(); itr != reference.end(); itr++)
+    {
+        BOOST_CHECK_EQUAL(table.find(itr->first), itr->second);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
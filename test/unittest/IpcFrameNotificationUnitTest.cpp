@@ -0,0 +1,93 @@
+/*!
+ * IpcFrameNotificationUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "IpcFrameNotification.h"
+#include "FrameDecoder.h"
+
+BOOST_AUTO_TEST_SUITE(IpcFrameNotificationUnitTest);
+
+BOOST_AUTO_TEST_CASE( EncodeAndDecodeRoundTrip )
+{
+    uint64_t frame_start_time_ns = 1234567890123456789ULL;
+    FrameReceiver::IpcFrameNotification ready(FrameReceiver::IpcMessage::MsgValNotifyFrameReady, 0x12345678, 7,
+            FrameReceiver::FrameDecoder::FrameReceiveStateComplete, frame_start_time_ns);
+
+    std::string encoded = ready.encode();
+    BOOST_CHECK_EQUAL(encoded.size(), static_cast<size_t>(FrameReceiver::IpcFrameNotification::encoded_size));
+    BOOST_CHECK_EQUAL(FrameReceiver::IpcFrameNotification::is_binary(encoded), true);
+
+    FrameReceiver::IpcFrameNotification decoded(encoded);
+    BOOST_CHECK_EQUAL(decoded.get_msg_type(), FrameReceiver::IpcMessage::MsgTypeNotify);
+    BOOST_CHECK_EQUAL(decoded.get_msg_val(), FrameReceiver::IpcMessage::MsgValNotifyFrameReady);
+    BOOST_CHECK_EQUAL(decoded.get_frame_number(), 0x12345678);
+    BOOST_CHECK_EQUAL(decoded.get_buffer_id(), 7);
+    BOOST_CHECK_EQUAL(decoded.get_frame_state(), FrameReceiver::FrameDecoder::FrameReceiveStateComplete);
+    BOOST_CHECK_EQUAL(decoded.get_frame_start_time_ns(), frame_start_time_ns);
+    BOOST_CHECK_EQUAL(decoded.get_msg_timestamp_ns(), ready.get_msg_timestamp_ns());
+    BOOST_CHECK(decoded.get_msg_timestamp_ns() > 0);
+}
+
+BOOST_AUTO_TEST_CASE( DecodeKnownLayout )
+{
+    // Check the layout field by field against a hand-built little-endian message, as decoded by
+    // the Python tools
+    const unsigned char raw[] = {
+            0xF5, 0x46, 0x52, 0x4E,  0x01, 0x00,  0x03,  0x03,
+            0x2A, 0x00, 0x00, 0x00,  0x05, 0x00, 0x00, 0x00,
+            0x03, 0x00, 0x00, 0x00,  0x00, 0x00, 0x00, 0x00,
+            0x01, 0x00, 0x00, 0x00,  0x00, 0x00, 0x00, 0x00,
+            0x02, 0x00, 0x00, 0x00,  0x00, 0x00, 0x00, 0x00,
+    };
+    std::string encoded(reinterpret_cast<const char*>(raw), sizeof(raw));
+
+    FrameReceiver::IpcFrameNotification decoded(encoded);
+    BOOST_CHECK_EQUAL(decoded.get_msg_type(), FrameReceiver::IpcMessage::MsgTypeNotify);
+    BOOST_CHECK_EQUAL(decoded.get_msg_val(), FrameReceiver::IpcMessage::MsgValNotifyFrameRelease);
+    BOOST_CHECK_EQUAL(decoded.get_frame_number(), 42);
+    BOOST_CHECK_EQUAL(decoded.get_buffer_id(), 5);
+    BOOST_CHECK_EQUAL(decoded.get_frame_state(), FrameReceiver::FrameDecoder::FrameReceiveStateTimedout);
+    BOOST_CHECK_EQUAL(decoded.get_frame_start_time_ns(), 1);
+    BOOST_CHECK_EQUAL(decoded.get_msg_timestamp_ns(), 2);
+    BOOST_CHECK(decoded.encode() == encoded);
+}
+
+BOOST_AUTO_TEST_CASE( ConvertToJson )
+{
+    FrameReceiver::IpcFrameNotification ready(FrameReceiver::IpcMessage::MsgValNotifyFrameReady, 10, 3,
+            FrameReceiver::FrameDecoder::FrameReceiveStateTimedout);
+
+    std::string json = ready.encode_json();
+    BOOST_CHECK_EQUAL(FrameReceiver::IpcFrameNotification::is_binary(json), false);
+
+    FrameReceiver::IpcMessage msg(json.c_str());
+    BOOST_CHECK_EQUAL(msg.get_msg_type(), FrameReceiver::IpcMessage::MsgTypeNotify);
+    BOOST_CHECK_EQUAL(msg.get_msg_val(), FrameReceiver::IpcMessage::MsgValNotifyFrameReady);
+    BOOST_CHECK_EQUAL(msg.get_param<int>("frame"), 10);
+    BOOST_CHECK_EQUAL(msg.get_param<int>("buffer_id"), 3);
+    BOOST_CHECK_EQUAL(msg.get_param<int>("frame_state"), FrameReceiver::FrameDecoder::FrameReceiveStateTimedout);
+}
+
+BOOST_AUTO_TEST_CASE( RejectInvalidMessages )
+{
+    // JSON messages and short strings are not binary notifications
+    FrameReceiver::IpcMessage json_msg(FrameReceiver::IpcMessage::MsgTypeNotify, FrameReceiver::IpcMessage::MsgValNotifyFrameRelease);
+    BOOST_CHECK_EQUAL(FrameReceiver::IpcFrameNotification::is_binary(std::string(json_msg.encode())), false);
+    BOOST_CHECK_EQUAL(FrameReceiver::IpcFrameNotification::is_binary(std::string("\xF5\x46")), false);
+    BOOST_CHECK_THROW(FrameReceiver::IpcFrameNotification not_binary(std::string(json_msg.encode())), FrameReceiver::IpcMessageException);
+
+    // Truncated message
+    FrameReceiver::IpcFrameNotification ready(FrameReceiver::IpcMessage::MsgValNotifyFrameReady, 1, 1);
+    std::string encoded = ready.encode();
+    BOOST_CHECK_THROW(FrameReceiver::IpcFrameNotification truncated(encoded.substr(0, encoded.size() - 1)), FrameReceiver::IpcMessageException);
+
+    // Unsupported version
+    encoded[4] = 2;
+    BOOST_CHECK_THROW(FrameReceiver::IpcFrameNotification bad_version(encoded), FrameReceiver::IpcMessageException);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
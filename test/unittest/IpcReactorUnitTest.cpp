@@ -13,6 +13,8 @@
 
 #include <stdlib.h>
 #include <sstream>
+#include <vector>
+#include <unistd.h>
 
 class ReactorTestFixture
 {
@@ -21,6 +23,9 @@ public:
         send_channel(ZMQ_PAIR),
         recv_channel(ZMQ_PAIR),
         timer_count(0),
+        recv_count(0),
+        reply_count(0),
+        num_messages(0),
         test_message("This is a test message")
     {
         BOOST_TEST_MESSAGE("Setup test fixture");
@@ -29,11 +34,11 @@ public:
         int endpoint_id = random();
         std::stringstream ss;
         ss << "inproc://reactor_channel_" << endpoint_id;
-        const char* random_endpoint = ss.str().c_str();
+        std::string random_endpoint = ss.str();
 
         // Bind the send channel and connect the receive channel
-        send_channel.bind(random_endpoint);
-        recv_channel.connect(random_endpoint);
+        send_channel.bind(random_endpoint.c_str());
+        recv_channel.connect(random_endpoint.c_str());
     }
 
     ~ReactorTestFixture()
@@ -60,10 +65,59 @@ public:
         send_channel.send(test_message);
     }
 
+    void count_handler(void)
+    {
+        // Receive a single message per callback, leaving any others to be dispatched again
+        recv_channel.recv();
+        if (++recv_count == num_messages)
+        {
+            reactor.stop();
+        }
+    }
+
+    void echo_handler(void)
+    {
+        std::string message = recv_channel.recv();
+        recv_channel.send(message);
+        recv_count++;
+    }
+
+    void reply_handler(void)
+    {
+        send_channel.recv();
+        if (++reply_count == num_messages)
+        {
+            reactor.stop();
+        }
+        else
+        {
+            send_channel.send(test_message);
+        }
+    }
+
+    void stop_handler(void)
+    {
+        reactor.stop();
+    }
+
+    void order_handler(int timer_tag)
+    {
+        timer_order.push_back(timer_tag);
+    }
+
+    void remove_timer_handler(int timer_id)
+    {
+        reactor.remove_timer(timer_id);
+    }
+
     FrameReceiver::IpcChannel send_channel;
     FrameReceiver::IpcChannel recv_channel;
     FrameReceiver::IpcReactor reactor;
     unsigned int timer_count;
+    int recv_count;
+    int reply_count;
+    int num_messages;
+    std::vector<int> timer_order;
     std::string  test_message;
     std::string  received_message;
 };
@@ -100,7 +154,161 @@ BOOST_AUTO_TEST_CASE( ReactorSendFromTimerTest )
     BOOST_CHECK_EQUAL(test_message, received_message);
 
 }
+BOOST_AUTO_TEST_CASE( ReactorChannelBurstTest )
+{
+    // Messages queued before the reactor runs must all be dispatched, although the channel
+    // notification descriptor only signals once and the callback receives one message at a time
+    num_messages = 100;
+    for (int msg = 0; msg < num_messages; msg++)
+    {
+        send_channel.send(test_message);
+    }
+
+    reactor.register_channel(recv_channel, boost::bind(&ReactorTestFixture::count_handler, this));
+    reactor.register_timer(1000, 1, boost::bind(&ReactorTestFixture::stop_handler, this));
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(recv_count, num_messages);
+}
+
+BOOST_AUTO_TEST_CASE( ReactorChannelPingPongTest )
+{
+    // Exchange messages between two channels registered with the same reactor, each callback
+    // sending on its own channel, which can consume the state change signalled for it
+    num_messages = 1000;
+    reactor.register_channel(recv_channel, boost::bind(&ReactorTestFixture::echo_handler, this));
+    reactor.register_channel(send_channel, boost::bind(&ReactorTestFixture::reply_handler, this));
+    reactor.register_timer(5000, 1, boost::bind(&ReactorTestFixture::stop_handler, this));
+
+    send_channel.send(test_message);
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(recv_count, num_messages);
+    BOOST_CHECK_EQUAL(reply_count, num_messages);
+}
+
+BOOST_AUTO_TEST_CASE( ReactorTimerOrderTest )
+{
+    // Timers registered out of order fire in order of their due time, and a timer removed by
+    // the callback of an earlier timer never fires
+    reactor.register_timer(30, 1, boost::bind(&ReactorTestFixture::order_handler, this, 3));
+    reactor.register_timer(10, 1, boost::bind(&ReactorTestFixture::order_handler, this, 1));
+    int removed_id = reactor.register_timer(40, 1, boost::bind(&ReactorTestFixture::order_handler, this, 4));
+    reactor.register_timer(20, 1, boost::bind(&ReactorTestFixture::order_handler, this, 2));
+    reactor.register_timer(25, 1, boost::bind(&ReactorTestFixture::remove_timer_handler, this, removed_id));
+    reactor.run();
+
+    BOOST_REQUIRE_EQUAL(timer_order.size(), 3);
+    for (int idx = 0; idx < 3; idx++)
+    {
+        BOOST_CHECK_EQUAL(timer_order[idx], idx + 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ReactorMicrosecondTimerTest )
+{
+    int max_count = 50;
+    FrameReceiver::TimeNs start = FrameReceiver::IpcReactorTimer::clock_mono_ns();
+    reactor.register_timer_us(200, max_count, boost::bind(&ReactorTestFixture::timer_handler, this));
+    reactor.run();
+    FrameReceiver::TimeNs elapsed_ns = FrameReceiver::IpcReactorTimer::clock_mono_ns() - start;
+
+    // The timer period is shorter than a millisecond. The elapsed time is reported rather than
+    // bounded above, since it depends on the load on the host.
+    BOOST_CHECK_EQUAL(timer_count, max_count);
+    BOOST_CHECK(elapsed_ns >= (FrameReceiver::TimeNs)max_count * 200000);
+    BOOST_TEST_MESSAGE("Microsecond timer fired " << max_count << " times in " << elapsed_ns / 1000 << " us");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
+class ReactorSocketTestFixture
+{
+public:
+    ReactorSocketTestFixture() :
+        num_sockets(48),
+        pipe_fds(num_sockets, std::vector<int>(2)),
+        recv_counts(num_sockets, 0)
+    {
+        for (int idx = 0; idx < num_sockets; idx++)
+        {
+            BOOST_REQUIRE_EQUAL(pipe(&(pipe_fds[idx][0])), 0);
+            reactor.register_socket(pipe_fds[idx][0], boost::bind(&ReactorSocketTestFixture::socket_handler, this, idx));
+        }
+    }
+
+    ~ReactorSocketTestFixture()
+    {
+        for (int idx = 0; idx < num_sockets; idx++)
+        {
+            close(pipe_fds[idx][0]);
+            close(pipe_fds[idx][1]);
+        }
+    }
+
+    void socket_handler(int idx)
+    {
+        // Read a single byte per callback, leaving any others to be dispatched again
+        char byte;
+        if (read(pipe_fds[idx][0], &byte, 1) == 1)
+        {
+            recv_counts[idx]++;
+        }
+    }
+
+    void remove_handler(int idx, int remove_idx)
+    {
+        socket_handler(idx);
+        reactor.remove_socket(pipe_fds[remove_idx][0]);
+    }
+
+    void stop_handler(void)
+    {
+        reactor.stop();
+    }
+
+    int num_sockets;
+    std::vector<std::vector<int> > pipe_fds;
+    std::vector<int> recv_counts;
+    FrameReceiver::IpcReactor reactor;
+};
 
+BOOST_FIXTURE_TEST_SUITE( IpcReactorSocketUnitTest, ReactorSocketTestFixture);
 
+BOOST_AUTO_TEST_CASE( ReactorManySocketTest )
+{
+    // Write a different number of bytes to every third socket, each of which must be dispatched
+    // until read, since callbacks are not required to drain sockets
+    for (int idx = 0; idx < num_sockets; idx += 3)
+    {
+        for (int byte = 0; byte <= (idx % 4); byte++)
+        {
+            BOOST_REQUIRE_EQUAL(write(pipe_fds[idx][1], "x", 1), 1);
+        }
+    }
+
+    reactor.register_timer(50, 1, boost::bind(&ReactorSocketTestFixture::stop_handler, this));
+    reactor.run();
+
+    for (int idx = 0; idx < num_sockets; idx++)
+    {
+        BOOST_CHECK_EQUAL(recv_counts[idx], (idx % 3) ? 0 : (idx % 4) + 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ReactorRemoveSocketInCallbackTest )
+{
+    // Make two sockets ready at once, with the callback of each removing the other. Only one
+    // callback must be called, whichever is dispatched first.
+    reactor.register_socket(pipe_fds[0][0], boost::bind(&ReactorSocketTestFixture::remove_handler, this, 0, 1));
+    reactor.register_socket(pipe_fds[1][0], boost::bind(&ReactorSocketTestFixture::remove_handler, this, 1, 0));
+    BOOST_REQUIRE_EQUAL(write(pipe_fds[0][1], "x", 1), 1);
+    BOOST_REQUIRE_EQUAL(write(pipe_fds[1][1], "x", 1), 1);
+
+    reactor.register_timer(50, 1, boost::bind(&ReactorSocketTestFixture::stop_handler, this));
+    reactor.run();
+
+    BOOST_CHECK_EQUAL(recv_counts[0] + recv_counts[1], 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,209 @@
+/*!
+ * NotificationRingUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "NotificationRing.h"
+#include "SharedBufferManager.h"
+#include "gettime.h"
+
+namespace
+{
+    FrameReceiver::NotificationRing::Entry make_entry(uint32_t frame_number, int32_t buffer_id)
+    {
+        FrameReceiver::NotificationRing::Entry entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.frame_number = frame_number;
+        entry.buffer_id = buffer_id;
+        return entry;
+    }
+
+    double elapsed_secs(struct timespec* start, struct timespec* end)
+    {
+        return (end->tv_sec - start->tv_sec) + ((double)(end->tv_nsec - start->tv_nsec) / 1000000000);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(NotificationRingUnitTest);
+
+BOOST_AUTO_TEST_CASE( PushPopAndWraparound )
+{
+    std::vector<uint8_t> region(FrameReceiver::NotificationRing::get_region_size(3));
+    FrameReceiver::NotificationRing ring(&region[0], 3);
+    BOOST_CHECK_EQUAL(ring.capacity(), 4);
+    BOOST_CHECK_EQUAL(ring.get_region_size(), region.size());
+
+    FrameReceiver::NotificationRing::Entry entry;
+    BOOST_CHECK_EQUAL(ring.pop(entry), false);
+    BOOST_CHECK_EQUAL(ring.wait(0), false);
+
+    // Cycle entries through the ring several times, filling it on each pass
+    uint32_t next_push = 0, next_pop = 0;
+    for (int pass = 0; pass < 5; pass++)
+    {
+        while (ring.push(make_entry(next_push, next_push % 7)))
+        {
+            next_push++;
+        }
+        BOOST_CHECK_EQUAL(ring.size(), 4);
+        BOOST_CHECK_EQUAL(ring.wait(0), true);
+
+        for (int i = 0; i < 3; i++)
+        {
+            BOOST_REQUIRE_EQUAL(ring.pop(entry), true);
+            BOOST_CHECK_EQUAL(entry.frame_number, next_pop);
+            BOOST_CHECK_EQUAL(entry.buffer_id, static_cast<int32_t>(next_pop % 7));
+            next_pop++;
+        }
+    }
+    BOOST_CHECK_EQUAL(ring.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( AttachToExistingRing )
+{
+    std::vector<uint8_t> region(FrameReceiver::NotificationRing::get_region_size(16), 0);
+
+    // An uninitialised region is rejected
+    BOOST_CHECK_THROW(FrameReceiver::NotificationRing missing_ring(&region[0]), FrameReceiver::NotificationRingException);
+
+    FrameReceiver::NotificationRing producer(&region[0], 16);
+    FrameReceiver::NotificationRing consumer(&region[0]);
+    BOOST_CHECK_EQUAL(consumer.capacity(), 16);
+
+    BOOST_CHECK_EQUAL(producer.push(make_entry(42, 3)), true);
+    FrameReceiver::NotificationRing::Entry entry;
+    BOOST_REQUIRE_EQUAL(consumer.pop(entry), true);
+    BOOST_CHECK_EQUAL(entry.frame_number, 42);
+    BOOST_CHECK_EQUAL(entry.buffer_id, 3);
+}
+
+BOOST_AUTO_TEST_CASE( AttachConsumerKeepsEntries )
+{
+    std::vector<uint8_t> region(FrameReceiver::NotificationRing::get_region_size(16), 0);
+    FrameReceiver::NotificationRing producer(&region[0], 16);
+    FrameReceiver::NotificationRing consumer(&region[0]);
+    BOOST_CHECK_EQUAL(producer.has_consumer(), false);
+
+    consumer.attach_consumer();
+    BOOST_CHECK_EQUAL(producer.has_consumer(), true);
+    BOOST_CHECK_EQUAL(producer.push(make_entry(1, 1)), true);
+    BOOST_CHECK_EQUAL(producer.push(make_entry(2, 2)), true);
+
+    // Entries still on the ring are drained by the consumer after detaching
+    FrameReceiver::NotificationRing::Entry entry;
+    consumer.detach_consumer();
+    BOOST_CHECK_EQUAL(producer.has_consumer(), false);
+    BOOST_REQUIRE_EQUAL(consumer.pop(entry), true);
+    BOOST_CHECK_EQUAL(entry.frame_number, 1);
+
+    // Entries left on the ring, e.g. pushed as the previous consumer detached, are handed to the
+    // next consumer to attach
+    FrameReceiver::NotificationRing next_consumer(&region[0]);
+    next_consumer.attach_consumer();
+    BOOST_REQUIRE_EQUAL(next_consumer.pop(entry), true);
+    BOOST_CHECK_EQUAL(entry.frame_number, 2);
+    BOOST_CHECK_EQUAL(next_consumer.pop(entry), false);
+    next_consumer.detach_consumer();
+}
+
+BOOST_AUTO_TEST_CASE( WaitForPushWithoutPopping )
+{
+    std::vector<uint8_t> region(FrameReceiver::NotificationRing::get_region_size(16), 0);
+    FrameReceiver::NotificationRing ring(&region[0], 16);
+
+    uint32_t head = 0;
+    BOOST_CHECK_EQUAL(ring.wait_for_push(head, 0), false);
+
+    BOOST_CHECK_EQUAL(ring.push(make_entry(1, 1)), true);
+    BOOST_CHECK_EQUAL(ring.wait_for_push(head, 0), true);
+    BOOST_CHECK_EQUAL(head, 1);
+
+    // The entry is left on the ring, but is not reported again
+    BOOST_CHECK_EQUAL(ring.wait_for_push(head, 0), false);
+    BOOST_CHECK_EQUAL(ring.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE( WaitAcrossProcesses )
+{
+    // Exchange entries with a child process through a ring pair in the auxiliary region of a
+    // shared buffer, as a frame processor would, the child echoing each ready entry as a release
+    const size_t num_entries = 64;
+    const int num_frames = 20000;
+    size_t ring_size = FrameReceiver::NotificationRing::get_region_size(num_entries);
+
+    FrameReceiver::SharedBufferManager manager("TestRingSharedBuffer", 1000, 100, true, 2 * ring_size);
+    uint8_t* aux_address = reinterpret_cast<uint8_t*>(manager.get_aux_address());
+    BOOST_REQUIRE_NE(aux_address, (uint8_t*)0);
+
+    FrameReceiver::NotificationRing ready_ring(aux_address, num_entries);
+    FrameReceiver::NotificationRing release_ring(aux_address + ring_size, num_entries);
+
+    int pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+        FrameReceiver::SharedBufferManager child_manager("TestRingSharedBuffer");
+        uint8_t* child_aux_address = reinterpret_cast<uint8_t*>(child_manager.get_aux_address());
+        FrameReceiver::NotificationRing child_ready_ring(child_aux_address);
+        FrameReceiver::NotificationRing child_release_ring(child_aux_address + ring_size);
+
+        int rc = 0;
+        int frames_echoed = 0;
+        FrameReceiver::NotificationRing::Entry entry;
+        while (frames_echoed < num_frames)
+        {
+            if (!child_ready_ring.wait(1000))
+            {
+                rc = -1;
+                break;
+            }
+            while (child_ready_ring.pop(entry))
+            {
+                if (entry.frame_number != static_cast<uint32_t>(frames_echoed))
+                {
+                    rc = -1;
+                }
+                child_release_ring.push(entry);
+                frames_echoed++;
+            }
+        }
+        _exit(rc);
+    }
+
+    // Send one frame at a time and wait for its release, measuring the round trip latency
+    struct timespec start, end;
+    int frames_released = 0;
+    gettime(&start, true);
+    for (int frame = 0; frame < num_frames; frame++)
+    {
+        BOOST_REQUIRE(ready_ring.push(make_entry(frame, frame % num_entries)));
+        if (!release_ring.wait(1000))
+        {
+            break;
+        }
+        FrameReceiver::NotificationRing::Entry entry;
+        while (release_ring.pop(entry))
+        {
+            BOOST_CHECK_EQUAL(entry.frame_number, static_cast<uint32_t>(frames_released));
+            frames_released++;
+        }
+    }
+    gettime(&end, true);
+
+    int child_rc = -1;
+    waitpid(pid, &child_rc, 0);
+    BOOST_CHECK_EQUAL(child_rc, 0);
+    BOOST_CHECK_EQUAL(frames_released, num_frames);
+
+    BOOST_TEST_MESSAGE("Notification ring round trip between processes: "
+            << (elapsed_secs(&start, &end) * 1.0e6 / num_frames) << " us/frame");
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,109 @@
+/*!
+ * NotificationRingWatcherUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "NotificationRingWatcher.h"
+#include "SharedBufferManager.h"
+
+namespace
+{
+    FrameReceiver::NotificationRing::Entry make_entry(uint32_t frame_number, int32_t buffer_id)
+    {
+        FrameReceiver::NotificationRing::Entry entry;
+        memset(&entry, 0, sizeof(entry));
+        entry.frame_number = frame_number;
+        entry.buffer_id = buffer_id;
+        return entry;
+    }
+
+    bool wait_readable(int fd, int timeout_ms)
+    {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        return (poll(&pfd, 1, timeout_ms) == 1) && (pfd.revents & POLLIN);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(NotificationRingWatcherUnitTest);
+
+BOOST_AUTO_TEST_CASE( NotifyOnPush )
+{
+    std::vector<uint8_t> region(FrameReceiver::NotificationRing::get_region_size(16), 0);
+    FrameReceiver::NotificationRing ring(&region[0], 16);
+    FrameReceiver::NotificationRingWatcher watcher(ring, 10);
+
+    BOOST_CHECK_EQUAL(wait_readable(watcher.get_notify_fd(), 50), false);
+
+    BOOST_CHECK_EQUAL(ring.push(make_entry(1, 1)), true);
+    BOOST_REQUIRE_EQUAL(wait_readable(watcher.get_notify_fd(), 1000), true);
+
+    // The watcher does not pop entries, and only notifies again when further entries are pushed
+    watcher.clear_notification();
+    BOOST_CHECK_EQUAL(ring.size(), 1);
+    BOOST_CHECK_EQUAL(wait_readable(watcher.get_notify_fd(), 50), false);
+
+    BOOST_CHECK_EQUAL(ring.push(make_entry(2, 2)), true);
+    BOOST_CHECK_EQUAL(wait_readable(watcher.get_notify_fd(), 1000), true);
+}
+
+BOOST_AUTO_TEST_CASE( NotifyOnPushFromOtherProcess )
+{
+    const size_t num_entries = 64;
+    const int num_frames = 100;
+    size_t ring_size = FrameReceiver::NotificationRing::get_region_size(num_entries);
+
+    FrameReceiver::SharedBufferManager manager("TestRingWatcherSharedBuffer", 1000, 100, true, ring_size);
+    FrameReceiver::NotificationRing ring(manager.get_aux_address(), num_entries);
+    ring.attach_consumer();
+
+    // Use a long wait timeout, so that the entries can only be seen promptly through the futex wakeup
+    FrameReceiver::NotificationRingWatcher watcher(ring, 10000);
+
+    int pid = fork();
+    BOOST_REQUIRE(pid >= 0);
+    if (pid == 0)
+    {
+        FrameReceiver::SharedBufferManager child_manager("TestRingWatcherSharedBuffer");
+        FrameReceiver::NotificationRing child_ring(child_manager.get_aux_address());
+        for (int frame = 0; frame < num_frames; frame++)
+        {
+            while (!child_ring.push(make_entry(frame, frame % num_entries)))
+            {
+                usleep(100);
+            }
+            usleep(100);
+        }
+        _exit(0);
+    }
+
+    // Drain the ring as a reactor would whenever the descriptor becomes readable
+    int frames_received = 0;
+    while ((frames_received < num_frames) && wait_readable(watcher.get_notify_fd(), 1000))
+    {
+        watcher.clear_notification();
+        FrameReceiver::NotificationRing::Entry entry;
+        while (ring.pop(entry))
+        {
+            BOOST_CHECK_EQUAL(entry.frame_number, static_cast<uint32_t>(frames_received));
+            frames_received++;
+        }
+    }
+
+    int child_rc = -1;
+    waitpid(pid, &child_rc, 0);
+    BOOST_CHECK_EQUAL(child_rc, 0);
+    BOOST_CHECK_EQUAL(frames_received, num_frames);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,88 @@
+/*!
+ * PacketBitmapUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "PacketBitmap.h"
+
+BOOST_AUTO_TEST_SUITE(PacketBitmapUnitTest);
+
+BOOST_AUTO_TEST_CASE( SetTestAndCount )
+{
+    // A bitmap size that is not a multiple of the word size
+    FrameReceiver::PacketBitmap<130> bitmap;
+    BOOST_CHECK_EQUAL(sizeof(bitmap), 3 * sizeof(uint64_t));
+
+    memset(&bitmap, 0xff, sizeof(bitmap));
+    bitmap.clear();
+    BOOST_CHECK_EQUAL(bitmap.count(), 0);
+    BOOST_CHECK_EQUAL(bitmap.complete(), false);
+    BOOST_CHECK_EQUAL(bitmap.find_missing(0), 0);
+    BOOST_CHECK_EQUAL(bitmap.find_received(0), 130);
+
+    BOOST_CHECK_EQUAL(bitmap.set(0), false);
+    BOOST_CHECK_EQUAL(bitmap.set(63), false);
+    BOOST_CHECK_EQUAL(bitmap.set(64), false);
+    BOOST_CHECK_EQUAL(bitmap.set(129), false);
+    BOOST_CHECK_EQUAL(bitmap.set(64), true);
+
+    BOOST_CHECK_EQUAL(bitmap.test(0), true);
+    BOOST_CHECK_EQUAL(bitmap.test(1), false);
+    BOOST_CHECK_EQUAL(bitmap.test(129), true);
+    BOOST_CHECK_EQUAL(bitmap.count(), 4);
+    BOOST_CHECK_EQUAL(bitmap.find_received(1), 63);
+    BOOST_CHECK_EQUAL(bitmap.find_received(65), 129);
+    BOOST_CHECK_EQUAL(bitmap.find_missing(63), 65);
+
+    for (size_t packet = 0; packet < 130; packet++)
+    {
+        bitmap.set(packet);
+    }
+    BOOST_CHECK_EQUAL(bitmap.count(), 130);
+    BOOST_CHECK_EQUAL(bitmap.complete(), true);
+    BOOST_CHECK_EQUAL(bitmap.find_missing(0), 130);
+}
+
+BOOST_AUTO_TEST_CASE( MissingRanges )
+{
+    FrameReceiver::PacketBitmap<1024> bitmap;
+    bitmap.clear();
+
+    std::vector<FrameReceiver::PacketRange> ranges;
+    BOOST_CHECK_EQUAL(bitmap.get_missing_ranges(ranges), 1024);
+    BOOST_REQUIRE_EQUAL(ranges.size(), 1);
+    BOOST_CHECK_EQUAL(ranges[0].first, 0);
+    BOOST_CHECK_EQUAL(ranges[0].second, 1024);
+
+    // Receive everything except packet 5, packets 60 to 69 and the last packet
+    for (size_t packet = 0; packet < 1023; packet++)
+    {
+        if ((packet != 5) && ((packet < 60) || (packet >= 70)))
+        {
+            bitmap.set(packet);
+        }
+    }
+    BOOST_CHECK_EQUAL(bitmap.get_missing_ranges(ranges), 12);
+    BOOST_REQUIRE_EQUAL(ranges.size(), 3);
+    BOOST_CHECK_EQUAL(ranges[0].first, 5);
+    BOOST_CHECK_EQUAL(ranges[0].second, 1);
+    BOOST_CHECK_EQUAL(ranges[1].first, 60);
+    BOOST_CHECK_EQUAL(ranges[1].second, 10);
+    BOOST_CHECK_EQUAL(ranges[2].first, 1023);
+    BOOST_CHECK_EQUAL(ranges[2].second, 1);
+
+    bitmap.set(5);
+    bitmap.set(1023);
+    for (size_t packet = 60; packet < 70; packet++)
+    {
+        bitmap.set(packet);
+    }
+    BOOST_CHECK_EQUAL(bitmap.get_missing_ranges(ranges), 0);
+    BOOST_CHECK_EQUAL(ranges.size(), 0);
+    BOOST_CHECK_EQUAL(bitmap.complete(), true);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
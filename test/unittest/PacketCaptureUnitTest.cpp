@@ -0,0 +1,291 @@
+/*!
+ * PacketCaptureUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <boost/filesystem.hpp>
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <arpa/inet.h>
+
+#include "PacketCapture.h"
+#include "PacketReplayer.h"
+#include "PercivalEmulatorFrameDecoder.h"
+#include "SharedBufferManager.h"
+
+namespace
+{
+    void append_be16(std::vector<uint8_t>& buffer, uint16_t value)
+    {
+        buffer.push_back(value >> 8);
+        buffer.push_back(value & 0xff);
+    }
+
+    void append_be32(std::vector<uint8_t>& buffer, uint32_t value)
+    {
+        append_be16(buffer, value >> 16);
+        append_be16(buffer, value & 0xffff);
+    }
+
+    // Appends a big-endian pcap record holding an Ethernet frame with the specified EtherType,
+    // followed by an IPv4 header with the specified protocol and an 8-byte transport header
+    void append_ethernet_record(std::vector<uint8_t>& buffer, uint32_t ts_usec, uint16_t ether_type,
+            bool vlan_tagged, uint8_t protocol, const std::vector<uint8_t>& payload)
+    {
+        std::vector<uint8_t> frame(12, 0xaa);
+        if (vlan_tagged)
+        {
+            append_be16(frame, 0x8100);
+            append_be16(frame, 42);
+        }
+        append_be16(frame, ether_type);
+
+        frame.push_back(0x45);
+        frame.push_back(0);
+        append_be16(frame, 28 + payload.size());
+        append_be32(frame, 0);
+        frame.push_back(64);
+        frame.push_back(protocol);
+        append_be16(frame, 0);
+        append_be32(frame, 0x0a000001);
+        append_be32(frame, 0x0a000002);
+
+        append_be16(frame, 40000);
+        append_be16(frame, 8989);
+        append_be16(frame, 8 + payload.size());
+        append_be16(frame, 0);
+        frame.insert(frame.end(), payload.begin(), payload.end());
+
+        append_be32(buffer, 100);
+        append_be32(buffer, ts_usec);
+        append_be32(buffer, frame.size());
+        append_be32(buffer, frame.size());
+        buffer.insert(buffer.end(), frame.begin(), frame.end());
+    }
+}
+
+class PacketCaptureTestFixture
+{
+public:
+    PacketCaptureTestFixture() :
+        logger(log4cxx::Logger::getLogger("PacketCaptureUnitTest")),
+        capture_file((boost::filesystem::temp_directory_path() /
+                boost::filesystem::unique_path("frame_receiver_capture_%%%%%%%%.pcap")).string())
+    {
+    }
+
+    ~PacketCaptureTestFixture()
+    {
+        remove(capture_file.c_str());
+    }
+
+    void frame_ready(int buffer_id, int frame_number)
+    {
+        ready_frames.push_back(std::make_pair(buffer_id, frame_number));
+    }
+
+    log4cxx::LoggerPtr logger;
+    std::string capture_file;
+    std::vector<std::pair<int, int> > ready_frames;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PacketCaptureUnitTest, PacketCaptureTestFixture);
+
+BOOST_AUTO_TEST_CASE( WriteAndReadCapture )
+{
+    const size_t num_datagrams = 3;
+    const size_t header_sizes[num_datagrams]  = {22, 22, 10};
+    const size_t payload_sizes[num_datagrams] = {8192, 0, 0};
+
+    struct sockaddr_in from_addr;
+    memset(&from_addr, 0, sizeof(from_addr));
+    from_addr.sin_family = AF_INET;
+    from_addr.sin_addr.s_addr = inet_addr("192.168.0.10");
+    from_addr.sin_port = htons(40000);
+
+    std::vector<uint8_t> header(22), payload(8192);
+    {
+        FrameReceiver::PacketCaptureWriter writer(capture_file, "192.168.0.1", 1024);
+        for (size_t idx = 0; idx < num_datagrams; idx++)
+        {
+            struct timespec timestamp = {1000 + static_cast<time_t>(idx), static_cast<long>(idx * 1000 + 1)};
+            memset(&header[0], idx + 1, header.size());
+            memset(&payload[0], idx + 0x10, payload.size());
+            writer.write(timestamp, &from_addr, 8989 + idx, &header[0], header_sizes[idx], &payload[0], payload_sizes[idx]);
+        }
+        BOOST_CHECK_EQUAL(writer.get_num_packets(), num_datagrams);
+        BOOST_CHECK_EQUAL(writer.get_num_bytes(), 22 + 8192 + 22 + 10);
+    }
+
+    FrameReceiver::PacketCaptureReader reader(capture_file);
+    BOOST_CHECK_EQUAL(reader.get_link_type(), 101);
+
+    // Read the capture twice to check that it can be rewound for repeated replay
+    for (int pass = 0; pass < 2; pass++)
+    {
+        FrameReceiver::CapturedDatagram datagram;
+        for (size_t idx = 0; idx < num_datagrams; idx++)
+        {
+            BOOST_REQUIRE(reader.read(datagram));
+            BOOST_CHECK_EQUAL(datagram.timestamp.tv_sec, static_cast<time_t>(1000 + idx));
+            BOOST_CHECK_EQUAL(datagram.timestamp.tv_nsec, static_cast<long>(idx * 1000 + 1));
+            BOOST_CHECK_EQUAL(datagram.from_addr.sin_addr.s_addr, from_addr.sin_addr.s_addr);
+            BOOST_CHECK_EQUAL(datagram.from_addr.sin_port, from_addr.sin_port);
+            BOOST_CHECK_EQUAL(datagram.port, static_cast<int>(8989 + idx));
+            BOOST_CHECK_EQUAL(datagram.length, header_sizes[idx] + payload_sizes[idx]);
+            BOOST_CHECK_EQUAL(datagram.original_length, datagram.length);
+            BOOST_CHECK_EQUAL(datagram.data[0], idx + 1);
+            BOOST_CHECK_EQUAL(datagram.data[datagram.length - 1], payload_sizes[idx] ? idx + 0x10 : idx + 1);
+        }
+        BOOST_CHECK_EQUAL(reader.read(datagram), false);
+        reader.rewind();
+    }
+    BOOST_CHECK_EQUAL(reader.get_num_skipped(), 0);
+}
+
+BOOST_AUTO_TEST_CASE( ReadEthernetCapture )
+{
+    // Build a big-endian microsecond capture of Ethernet frames, as taken by tcpdump on another host
+    std::vector<uint8_t> file;
+    append_be32(file, 0xa1b2c3d4);
+    append_be16(file, 2);
+    append_be16(file, 4);
+    append_be32(file, 0);
+    append_be32(file, 0);
+    append_be32(file, 65535);
+    append_be32(file, 1);
+
+    std::vector<uint8_t> payload(100, 0x5a);
+    append_ethernet_record(file, 1, 0x0806, false, 17, payload);   // ARP
+    append_ethernet_record(file, 2, 0x0800, false, 6, payload);    // TCP
+    append_ethernet_record(file, 3, 0x0800, true, 17, payload);    // VLAN tagged UDP
+    append_ethernet_record(file, 4, 0x0800, false, 17, payload);   // UDP
+
+    // Finish with a record truncated by the end of the file
+    append_ethernet_record(file, 5, 0x0800, false, 17, payload);
+    file.resize(file.size() - 10);
+
+    FILE* fp = fopen(capture_file.c_str(), "wb");
+    BOOST_REQUIRE(fp != 0);
+    fwrite(&file[0], file.size(), 1, fp);
+    fclose(fp);
+
+    FrameReceiver::PacketCaptureReader reader(capture_file);
+    BOOST_CHECK_EQUAL(reader.get_link_type(), 1);
+
+    FrameReceiver::CapturedDatagram datagram;
+    for (int record = 3; record <= 4; record++)
+    {
+        BOOST_REQUIRE(reader.read(datagram));
+        BOOST_CHECK_EQUAL(datagram.timestamp.tv_nsec, record * 1000);
+        BOOST_CHECK_EQUAL(ntohl(datagram.from_addr.sin_addr.s_addr), 0x0a000001);
+        BOOST_CHECK_EQUAL(ntohs(datagram.from_addr.sin_port), 40000);
+        BOOST_CHECK_EQUAL(datagram.port, 8989);
+        BOOST_CHECK_EQUAL(datagram.length, payload.size());
+        BOOST_CHECK_EQUAL(datagram.data[0], 0x5a);
+    }
+    BOOST_CHECK_EQUAL(reader.read(datagram), false);
+    BOOST_CHECK_EQUAL(reader.get_num_skipped(), 2);
+}
+
+BOOST_AUTO_TEST_CASE( RejectInvalidCapture )
+{
+    BOOST_CHECK_THROW(FrameReceiver::PacketCaptureReader missing_reader("/nonexistent/capture.pcap"),
+            FrameReceiver::PacketCaptureException);
+
+    FILE* fp = fopen(capture_file.c_str(), "wb");
+    BOOST_REQUIRE(fp != 0);
+    fprintf(fp, "this is not a packet capture file");
+    fclose(fp);
+    BOOST_CHECK_THROW(FrameReceiver::PacketCaptureReader bad_reader(capture_file), FrameReceiver::PacketCaptureException);
+}
+
+BOOST_AUTO_TEST_CASE( ReplayCaptureIntoDecoder )
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+
+    // Capture two complete frames, sending the packets of each subframe in reverse order and
+    // repeating a packet of the first frame
+    {
+        FrameReceiver::PacketCaptureWriter writer(capture_file);
+        std::vector<uint8_t> header(sizeof(Decoder::PacketHeader));
+        std::vector<uint8_t> payload(Decoder::primary_packet_size);
+        struct timespec timestamp = {0, 0};
+
+        for (uint32_t frame = 0; frame < 2; frame++)
+        {
+            for (uint8_t type = 0; type < Decoder::num_data_types; type++)
+            {
+                for (uint8_t subframe = 0; subframe < Decoder::num_subframes; subframe++)
+                {
+                    for (int packet = Decoder::num_subframe_packets - 1; packet >= 0; packet--)
+                    {
+                        // Sample packets carry the preceding frame number in the emulator firmware
+                        uint32_t frame_number_be = htonl((type == Decoder::PacketTypeSample) ? frame : frame + 1);
+                        uint16_t packet_number_be = htons(packet);
+                        header[0] = type;
+                        header[1] = subframe;
+                        memcpy(&header[2], &frame_number_be, sizeof(frame_number_be));
+                        memcpy(&header[6], &packet_number_be, sizeof(packet_number_be));
+                        memset(&payload[0], packet & 0xff, payload.size());
+
+                        size_t payload_size = (packet < static_cast<int>(Decoder::num_primary_packets)) ?
+                                Decoder::primary_packet_size : Decoder::tail_packet_size;
+                        int repeats = ((frame == 0) && (type == 0) && (subframe == 0) && (packet == 7)) ? 2 : 1;
+                        for (int repeat = 0; repeat < repeats; repeat++)
+                        {
+                            timestamp.tv_nsec += 1000;
+                            writer.write(timestamp, 0, 8989, &header[0], header.size(), &payload[0], payload_size);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Replay the capture through both the per-packet and batched decoder entry points
+    const unsigned int batch_sizes[] = {1, 16};
+    for (int idx = 0; idx < 2; idx++)
+    {
+        ready_frames.clear();
+
+        boost::shared_ptr<Decoder> decoder(new Decoder(logger));
+        FrameReceiver::SharedBufferManagerPtr buffer_manager(
+                new FrameReceiver::SharedBufferManager("TestReplaySharedBuffer", 2 * Decoder::total_frame_size,
+                        Decoder::total_frame_size, true, 0, sizeof(Decoder::FrameHeader)));
+        decoder->register_buffer_manager(buffer_manager);
+        decoder->register_frame_ready_callback(boost::bind(&PacketCaptureTestFixture::frame_ready, this, _1, _2));
+        decoder->push_empty_buffer(0);
+        decoder->push_empty_buffer(1);
+
+        FrameReceiver::PacketReplayer replayer(logger, decoder, batch_sizes[idx]);
+        replayer.replay(capture_file);
+
+        BOOST_CHECK_EQUAL(replayer.get_num_packets(), (2 * Decoder::num_frame_packets) + 1);
+        BOOST_CHECK_EQUAL(replayer.get_num_truncated(), 0);
+        BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(), 1);
+        BOOST_CHECK_EQUAL(decoder->get_num_dropped_packets(Decoder::PacketDropDuplicate), 1);
+
+        BOOST_REQUIRE_EQUAL(ready_frames.size(), 2);
+        for (int frame = 0; frame < 2; frame++)
+        {
+            int buffer_id = ready_frames[frame].first;
+            BOOST_CHECK_EQUAL(ready_frames[frame].second, frame + 1);
+
+            Decoder::FrameHeader* frame_header = reinterpret_cast<Decoder::FrameHeader*>(buffer_manager->get_metadata_address(buffer_id));
+            BOOST_CHECK_EQUAL(frame_header->frame_state, FrameReceiver::FrameDecoder::FrameReceiveStateComplete);
+            BOOST_CHECK_EQUAL(frame_header->packets_received, Decoder::num_frame_packets);
+
+            uint8_t* frame_data = reinterpret_cast<uint8_t*>(buffer_manager->get_buffer_address(buffer_id));
+            BOOST_CHECK_EQUAL(frame_data[Decoder::primary_packet_size * 7], 7);
+            BOOST_CHECK_EQUAL(frame_data[Decoder::data_type_size + Decoder::subframe_size - 1], Decoder::num_primary_packets);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -160,6 +160,100 @@ BOOST_AUTO_TEST_CASE( BufferBiggerThanSharedMemTest)
             FrameReceiver::SharedBufferManagerException);
 }
 
+BOOST_AUTO_TEST_CASE( AuxiliaryRegionTest )
+{
+    // Buffers exactly fill the fixture shared memory, so there is no auxiliary region
+    BOOST_CHECK_EQUAL(shared_buffer_manager.get_aux_size(), 0);
+    BOOST_CHECK_EQUAL(shared_buffer_manager.get_aux_address(), (void*)0);
+
+    const size_t aux_size = 1000;
+    FrameReceiver::SharedBufferManager aux_manager("TestAuxSharedBuffer", shared_mem_size, buffer_size, true, aux_size);
+
+    // The auxiliary region follows the last buffer slot on a page boundary
+    char* aux_address = reinterpret_cast<char*>(aux_manager.get_aux_address());
+    char* last_buffer_end = reinterpret_cast<char*>(aux_manager.get_buffer_address(num_buffers - 1)) + buffer_size;
+    BOOST_REQUIRE_NE(aux_address, (char*)0);
+    BOOST_CHECK(aux_address >= last_buffer_end);
+    BOOST_CHECK_EQUAL(reinterpret_cast<size_t>(aux_address) % FrameReceiver::SharedBufferManager::buffer_alignment, 0);
+    BOOST_CHECK(aux_manager.get_aux_size() >= aux_size);
+
+    // A manager mapping the existing shared memory sees the same region
+    memset(aux_address, 0x5A, aux_size);
+    FrameReceiver::SharedBufferManager existing_manager("TestAuxSharedBuffer");
+    BOOST_CHECK_EQUAL(existing_manager.get_aux_size(), aux_manager.get_aux_size());
+    BOOST_CHECK_EQUAL(reinterpret_cast<char*>(existing_manager.get_aux_address())[aux_size - 1], 0x5A);
+}
+
+BOOST_AUTO_TEST_CASE( SegmentLayoutTest )
+{
+    const size_t metadata_size = 100;
+    FrameReceiver::SharedBufferManager layout_manager("TestLayoutSharedBuffer", shared_mem_size, buffer_size, true, 0, metadata_size);
+
+    // Metadata slots are padded to whole cache lines and buffer slots are page aligned, with the
+    // metadata slots ending before the first buffer
+    BOOST_CHECK_EQUAL(layout_manager.get_metadata_size(), 128);
+    BOOST_CHECK_EQUAL(shared_buffer_manager.get_metadata_size(), 0);
+    BOOST_CHECK_THROW(shared_buffer_manager.get_metadata_address(0), FrameReceiver::SharedBufferManagerException);
+
+    char* last_metadata_end = reinterpret_cast<char*>(layout_manager.get_metadata_address(num_buffers - 1)) + metadata_size;
+    BOOST_CHECK(last_metadata_end <= reinterpret_cast<char*>(layout_manager.get_buffer_address(0)));
+    for (unsigned int buffer = 0; buffer < num_buffers; buffer++)
+    {
+        BOOST_CHECK_EQUAL(reinterpret_cast<size_t>(layout_manager.get_metadata_address(buffer)) %
+                FrameReceiver::SharedBufferManager::metadata_alignment, 0);
+        BOOST_CHECK_EQUAL(reinterpret_cast<size_t>(layout_manager.get_buffer_address(buffer)) %
+                FrameReceiver::SharedBufferManager::buffer_alignment, 0);
+    }
+    BOOST_CHECK_THROW(layout_manager.get_metadata_address(num_buffers), FrameReceiver::SharedBufferManagerException);
+
+    // A manager mapping the existing shared memory uses the layout recorded in the header
+    memset(layout_manager.get_metadata_address(3), 0x33, metadata_size);
+    FrameReceiver::SharedBufferManager existing_manager("TestLayoutSharedBuffer");
+    BOOST_CHECK_EQUAL(existing_manager.get_metadata_size(), layout_manager.get_metadata_size());
+    BOOST_CHECK_EQUAL(reinterpret_cast<char*>(existing_manager.get_metadata_address(3))[metadata_size - 1], 0x33);
+
+    // Shared memory without a compatible layout header cannot be mapped
+    boost::interprocess::shared_memory_object incompatible_mem(boost::interprocess::open_or_create,
+            "TestIncompatibleSharedBuffer", boost::interprocess::read_write);
+    incompatible_mem.truncate(4096);
+    BOOST_CHECK_THROW(FrameReceiver::SharedBufferManager incompatible_manager("TestIncompatibleSharedBuffer"),
+            FrameReceiver::SharedBufferManagerException);
+    boost::interprocess::shared_memory_object::remove("TestIncompatibleSharedBuffer");
+}
+
+BOOST_AUTO_TEST_CASE( PrefaultAndLockTest )
+{
+    const size_t prefault_mem_size = 4 * 1024 * 1024;
+    FrameReceiver::SharedBufferManager prefault_manager("TestPrefaultSharedBuffer", prefault_mem_size, prefault_mem_size / 4);
+
+    // Writing through the buffers must preserve existing contents when prefaulting
+    char* buffer = reinterpret_cast<char*>(prefault_manager.get_buffer_address(1));
+    buffer[0] = 0x42;
+
+    FrameReceiver::SharedBufferManager::MemoryStats stats = prefault_manager.get_memory_stats();
+    BOOST_CHECK(stats.mapped_size >= prefault_mem_size);
+
+    prefault_manager.prefault();
+    stats = prefault_manager.get_memory_stats();
+    BOOST_CHECK_EQUAL(buffer[0], 0x42);
+    BOOST_CHECK_GT(stats.kernel_page_size, 0);
+    BOOST_CHECK(stats.resident_size >= prefault_mem_size);
+
+    // Huge pages and locking depend on the kernel configuration and resource limits of the host
+    try {
+        prefault_manager.advise_huge_pages();
+        prefault_manager.lock_memory();
+        stats = prefault_manager.get_memory_stats();
+        BOOST_CHECK(stats.locked_size >= prefault_mem_size);
+    }
+    catch (FrameReceiver::SharedBufferManagerException& e)
+    {
+        BOOST_TEST_MESSAGE("Skipping huge page and lock checks: " << e.what());
+    }
+    BOOST_TEST_MESSAGE("Prefaulted shared buffer: " << (stats.resident_size >> 10) << " KiB resident, "
+            << (stats.huge_page_size >> 10) << " KiB in huge pages, " << (stats.locked_size >> 10) << " KiB locked");
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
 
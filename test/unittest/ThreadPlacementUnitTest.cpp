@@ -0,0 +1,56 @@
+/*!
+ * ThreadPlacementUnitTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <boost/thread.hpp>
+
+#include "ThreadPlacement.h"
+
+#include <errno.h>
+#include <sched.h>
+
+namespace
+{
+    void check_pinned_thread(int cpu, int* rc, int* running_cpu)
+    {
+        *rc = FrameReceiver::set_thread_affinity(cpu);
+#ifdef __linux__
+        *running_cpu = sched_getcpu();
+#endif
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(ThreadPlacementUnitTest);
+
+BOOST_AUTO_TEST_CASE( PinThreadToCpu )
+{
+#ifdef __linux__
+    // Pin a separate thread so that the affinity of the test runner is not changed
+    int rc = -1;
+    int running_cpu = -1;
+    boost::thread pinned_thread(check_pinned_thread, 0, &rc, &running_cpu);
+    pinned_thread.join();
+
+    BOOST_CHECK_EQUAL(rc, 0);
+    BOOST_CHECK_EQUAL(running_cpu, 0);
+    BOOST_CHECK_EQUAL(FrameReceiver::set_thread_affinity(-1), EINVAL);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE( IllegalRealtimePriority )
+{
+    BOOST_CHECK_EQUAL(FrameReceiver::set_thread_realtime_priority(100000), EINVAL);
+}
+
+BOOST_AUTO_TEST_CASE( InterfaceNumaNode )
+{
+    // Neither the wildcard nor the loopback address has a NUMA node
+    BOOST_CHECK_EQUAL(FrameReceiver::get_interface_numa_node("0.0.0.0"), -1);
+    BOOST_CHECK_EQUAL(FrameReceiver::get_interface_numa_node("127.0.0.1"), -1);
+    BOOST_CHECK_EQUAL(FrameReceiver::get_interface_numa_node("not an address"), -1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,58 @@
+/*!
+ * TestFrameDecoderPlugin.cpp - frame decoder plugin used by the decoder registry unit tests
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameDecoderRegistry.h"
+
+#include <cstdlib>
+
+namespace FrameReceiver
+{
+    //! Minimal decoder whose frame buffer size is set by the "framesize" decoder parameter
+    class TestFrameDecoder : public FrameDecoder
+    {
+    public:
+
+        TestFrameDecoder(LoggerPtr& logger, bool enable_packet_logging, unsigned int frame_timeout_ms) :
+            FrameDecoder(logger, enable_packet_logging),
+            frame_size_(0),
+            header_(0)
+        { }
+
+        void configure(const FrameDecoderParams& params)
+        {
+            FrameDecoderParams::const_iterator itr = params.find("framesize");
+            if (itr == params.end())
+            {
+                throw FrameDecoderException("Test frame decoder requires a framesize parameter");
+            }
+            frame_size_ = strtoul(itr->second.c_str(), NULL, 0);
+        }
+
+        const size_t get_frame_buffer_size(void) const { return frame_size_; }
+        const size_t get_frame_header_size(void) const { return 0; }
+
+        const bool requires_header_peek(void) const { return false; }
+        const size_t get_packet_header_size(void) const { return sizeof(header_); }
+        void* get_packet_header_buffer(void) { return &header_; }
+        void process_packet_header(size_t bytes_received, int port, struct sockaddr_in* from_addr) { }
+
+        void* get_next_payload_buffer(void) const { return 0; }
+        size_t get_next_payload_size(void) const { return 0; }
+        const size_t get_max_payload_size(void) const { return 0; }
+        FrameReceiveState process_packet(size_t bytes_received) { return FrameReceiveStateIncomplete; }
+
+        void monitor_buffers(void) { }
+
+    private:
+        size_t   frame_size_;
+        uint32_t header_;
+    };
+}
+
+extern "C" void register_frame_decoders(FrameReceiver::FrameDecoderRegistry& registry)
+{
+    registry.register_decoder("testdecoder", &FrameReceiver::create_frame_decoder<FrameReceiver::TestFrameDecoder>);
+}
@@ -0,0 +1,674 @@
+/*!
+ * frameProcessor.cpp - native frame processor consuming frames from the frame receiver
+ *
+ * This tool maps the shared frame buffer of a running frame receiver, consumes its frame ready
+ * notifications and releases each buffer as soon as the frame has been handled. Notifications are
+ * exchanged over the frame ready and release channels, in JSON or binary format, or
+ * through the notification rings in the shared buffer. Frames can optionally have their data
+ * touched, or validated against the packet index pattern sent by frameProducer. The time each
+ * buffer is held and the frame throughput are reported, so that the receiver can be benchmarked
+ * end to end without the consumer limiting the rate.
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "IpcChannel.h"
+#include "IpcMessage.h"
+#include "IpcFrameNotification.h"
+#include "NotificationRing.h"
+#include "SharedBufferManager.h"
+#include "PercivalEmulatorFrameDecoder.h"
+#include "FrameReceiverDefaults.h"
+#include "gettime.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include <log4cxx/basicconfigurator.h>
+#include <log4cxx/propertyconfigurator.h>
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+using namespace FrameReceiver;
+
+extern void set_debug_level(DebugLevel level);
+
+namespace
+{
+    typedef PercivalEmulatorFrameDecoder Decoder;
+    typedef Decoder::Geometry Geometry;
+
+    volatile bool run_processor = true;
+
+    void intHandler(int sig)
+    {
+        run_processor = false;
+    }
+
+    uint64_t clock_ns(bool monotonic)
+    {
+        struct timespec ts;
+        gettime(&ts, monotonic);
+        return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+    }
+
+    //! Replaces the wildcard address of a bound endpoint with the loopback address to connect to it
+    std::string connect_endpoint(const std::string& endpoint)
+    {
+        std::string connect = endpoint;
+        std::size_t wildcard = connect.find("*");
+        if (wildcard != std::string::npos)
+        {
+            connect.replace(wildcard, 1, "127.0.0.1");
+        }
+        return connect;
+    }
+
+    //! Handling applied to the data of each frame before release
+    typedef enum
+    {
+        FrameModeRelease = 0,  //!< Release without accessing the frame data
+        FrameModeTouch,        //!< Read one word per page of the frame data
+        FrameModeValidate,     //!< Check the frame header and every received payload word
+    } FrameMode;
+
+    //! Hold time statistics over a set of frames
+    class HoldStats
+    {
+    public:
+        HoldStats() { reset(); }
+
+        void reset(void)
+        {
+            frames = 0;
+            bytes = 0;
+            hold_sum_ns = 0;
+            hold_min_ns = 0;
+            hold_max_ns = 0;
+            latency_sum_ns = 0;
+            latency_frames = 0;
+        }
+
+        void add(uint64_t frame_bytes, uint64_t hold_ns, int64_t latency_ns)
+        {
+            if ((frames == 0) || (hold_ns < hold_min_ns))
+            {
+                hold_min_ns = hold_ns;
+            }
+            if (hold_ns > hold_max_ns)
+            {
+                hold_max_ns = hold_ns;
+            }
+            frames++;
+            bytes += frame_bytes;
+            hold_sum_ns += hold_ns;
+            if (latency_ns >= 0)
+            {
+                latency_sum_ns += latency_ns;
+                latency_frames++;
+            }
+        }
+
+        void report(std::ostream& os, double elapsed_secs) const
+        {
+            os << frames << " frames";
+            if (elapsed_secs > 0)
+            {
+                os << " (" << (frames / elapsed_secs) << " frames/s, " << (bytes / elapsed_secs / 1.0e9) << " GB/s)";
+            }
+            if (frames)
+            {
+                os << " hold time us min/mean/max " << (hold_min_ns / 1000.0) << "/"
+                   << (hold_sum_ns / frames / 1000.0) << "/" << (hold_max_ns / 1000.0);
+            }
+            if (latency_frames)
+            {
+                os << " notification latency mean " << (latency_sum_ns / latency_frames / 1000.0) << " us";
+            }
+        }
+
+        uint64_t frames;
+        uint64_t bytes;
+        uint64_t hold_sum_ns;
+        uint64_t hold_min_ns;
+        uint64_t hold_max_ns;
+        uint64_t latency_sum_ns;  //!< Sum of times from notification to receipt, where timestamped
+        uint64_t latency_frames;  //!< Frames with timestamped notifications
+    };
+
+    //! FrameProcessor - consumes frame ready notifications and releases the frame buffers
+    class FrameProcessor
+    {
+    public:
+
+        FrameProcessor(LoggerPtr& logger, const std::string& shared_buffer_name, FrameMode frame_mode,
+                bool binary_notify) :
+            logger_(logger),
+            buffer_manager_(new SharedBufferManager(shared_buffer_name)),
+            frame_mode_(frame_mode),
+            binary_notify_(binary_notify),
+            percival_layout_(false),
+            ctrl_channel_(ZMQ_REQ),
+            ready_channel_(ZMQ_SUB),
+            release_channel_(ZMQ_PUB),
+            first_frame_ns_(0),
+            last_release_ns_(0),
+            frames_timedout_(0),
+            packets_received_(0),
+            frames_invalid_(0),
+            packets_invalid_(0),
+            touch_sum_(0)
+        {
+            LOG4CXX_INFO(logger_, "Mapped shared buffer manager ID " << buffer_manager_->get_manager_id()
+                    << " with " << buffer_manager_->get_num_buffers() << " buffers of size "
+                    << buffer_manager_->get_buffer_size());
+
+            // Frame headers are only decoded from buffers laid out for Percival emulator frames
+            percival_layout_ = (buffer_manager_->get_buffer_size() >= Geometry::total_frame_size) &&
+                    (buffer_manager_->get_metadata_size() >= sizeof(Decoder::FrameHeader));
+            if ((frame_mode_ == FrameModeValidate) && !percival_layout_)
+            {
+                throw FrameReceiverException("Shared buffer layout does not match Percival emulator frames, cannot validate");
+            }
+        }
+
+        void connect(const std::string& ctrl_endpoint, const std::string& ready_endpoint,
+                const std::string& release_endpoint)
+        {
+            std::string ctrl_connect = connect_endpoint(ctrl_endpoint);
+            std::string ready_connect = connect_endpoint(ready_endpoint);
+            std::string release_connect = connect_endpoint(release_endpoint);
+            ctrl_channel_.connect(ctrl_connect);
+            ready_channel_.connect(ready_connect);
+            release_channel_.connect(release_connect);
+            ready_channel_.subscribe("");
+
+            // Negotiate the frame ready notification format, binary releases are always accepted
+            IpcMessage configure_msg(IpcMessage::MsgTypeCmd, IpcMessage::MsgValCmdConfigure);
+            configure_msg.set_param("notification_format", std::string(binary_notify_ ? "binary" : "json"));
+            ctrl_channel_.send(configure_msg.encode());
+
+            if (!ctrl_channel_.poll(Defaults::default_frame_timeout_ms))
+            {
+                throw FrameReceiverException("No reply from frame receiver to notification format configure command");
+            }
+            std::string reply_encoded = ctrl_channel_.recv();
+            IpcMessage reply(reply_encoded.c_str());
+            if (reply.get_msg_type() != IpcMessage::MsgTypeAck)
+            {
+                throw FrameReceiverException("Frame receiver rejected notification format: " + reply_encoded);
+            }
+            LOG4CXX_INFO(logger_, "Frame receiver sending " << reply.get_param<std::string>("notification_format", "")
+                    << " frame ready notifications");
+        }
+
+        ~FrameProcessor()
+        {
+            detach_rings();
+        }
+
+        //! Attaches to the notification rings in the auxiliary region of the shared buffer, laid out
+        //! as by the frame receiver with the ready ring first. Once attached as the consumer of the
+        //! ready ring, the frame receiver delivers frame ready notifications through it instead of
+        //! the frame ready channel.
+        void attach_rings(void)
+        {
+            uint8_t* ring_address = reinterpret_cast<uint8_t*>(buffer_manager_->get_aux_address());
+            if (!ring_address)
+            {
+                throw FrameReceiverException("Shared buffer has no auxiliary region for notification rings");
+            }
+            ready_ring_.reset(new NotificationRing(ring_address));
+            release_ring_.reset(new NotificationRing(ring_address + ready_ring_->get_region_size()));
+            ready_ring_->attach_consumer();
+            LOG4CXX_INFO(logger_, "Attached to frame notification rings with " << ready_ring_->capacity() << " entries");
+        }
+
+        //! Detaches from the notification rings, releasing the frames still on the ready ring
+        //! unprocessed so that their buffers are returned to the frame receiver
+        void detach_rings(void)
+        {
+            if (!ready_ring_)
+            {
+                return;
+            }
+
+            ready_ring_->detach_consumer();
+
+            NotificationRing::Entry entry;
+            unsigned int frames_drained = 0;
+            while (ready_ring_->pop(entry))
+            {
+                release_frame(entry.frame_number, entry.buffer_id);
+                frames_drained++;
+            }
+            if (frames_drained)
+            {
+                LOG4CXX_INFO(logger_, "Released " << frames_drained << " unprocessed frames on detaching from the ready ring");
+            }
+
+            ready_ring_.reset();
+            release_ring_.reset();
+        }
+
+        void set_hold_log(const std::string& file_name)
+        {
+            hold_log_.open(file_name.c_str());
+            if (!hold_log_)
+            {
+                throw FrameReceiverException("Failed to open hold time log file " + file_name);
+            }
+            hold_log_ << "frame,buffer_id,frame_state,hold_ns,latency_ns,valid" << std::endl;
+        }
+
+        //! Processes frames until interrupted or the requested number of frames is reached
+        void run(uint64_t max_frames, unsigned int report_interval_secs)
+        {
+            uint64_t interval_start_ns = clock_ns(true);
+
+            while (run_processor && ((max_frames == 0) || (total_stats_.frames < max_frames)))
+            {
+                if (ready_ring_)
+                {
+                    if (ready_ring_->wait(100))
+                    {
+                        NotificationRing::Entry entry;
+                        while (((max_frames == 0) || (total_stats_.frames < max_frames)) && ready_ring_->pop(entry))
+                        {
+                            handle_frame(entry.frame_number, entry.buffer_id, entry.frame_state, entry.timestamp_ns);
+                        }
+                    }
+                }
+                else
+                {
+                    try {
+                        if (ready_channel_.poll(100))
+                        {
+                            handle_ready_message(ready_channel_.recv());
+                        }
+                    }
+                    catch (zmq::error_t& e)
+                    {
+                        // Polling is interrupted by the signal handler, so stop processing gracefully
+                        if (e.num() != EINTR)
+                        {
+                            throw;
+                        }
+                    }
+                }
+
+                uint64_t now_ns = clock_ns(true);
+                if (report_interval_secs && ((now_ns - interval_start_ns) >= (uint64_t)report_interval_secs * 1000000000))
+                {
+                    std::stringstream ss;
+                    interval_stats_.report(ss, (double)(now_ns - interval_start_ns) / 1.0e9);
+                    LOG4CXX_INFO(logger_, "Processed " << ss.str());
+                    interval_stats_.reset();
+                    interval_start_ns = now_ns;
+                }
+            }
+        }
+
+        void report(std::ostream& os) const
+        {
+            // Throughput is measured from the first frame received to the last released
+            os << "Processed ";
+            total_stats_.report(os, (double)(last_release_ns_ - first_frame_ns_) / 1.0e9);
+            os << std::endl;
+            os << "Frames timed out: " << frames_timedout_;
+            if (percival_layout_)
+            {
+                os << " packets received: " << packets_received_;
+            }
+            os << std::endl;
+            if (frame_mode_ == FrameModeValidate)
+            {
+                os << "Frames failing validation: " << frames_invalid_
+                   << " packets with invalid data: " << packets_invalid_ << std::endl;
+            }
+        }
+
+        uint64_t get_num_invalid_frames(void) const
+        {
+            return frames_invalid_;
+        }
+
+    private:
+
+        void handle_ready_message(const std::string& ready_encoded)
+        {
+            try {
+                if (IpcFrameNotification::is_binary(ready_encoded))
+                {
+                    IpcFrameNotification ready(ready_encoded);
+                    if (ready.get_msg_val() == IpcMessage::MsgValNotifyFrameReady)
+                    {
+                        handle_frame(ready.get_frame_number(), ready.get_buffer_id(), ready.get_frame_state(),
+                                ready.get_msg_timestamp_ns());
+                        return;
+                    }
+                }
+                else
+                {
+                    IpcMessage ready(ready_encoded.c_str());
+                    if ((ready.get_msg_type() == IpcMessage::MsgTypeNotify) &&
+                        (ready.get_msg_val() == IpcMessage::MsgValNotifyFrameReady))
+                    {
+                        handle_frame(ready.get_param<int>("frame", -1), ready.get_param<int>("buffer_id", -1),
+                                ready.get_param<int>("frame_state", 0), 0);
+                        return;
+                    }
+                }
+                LOG4CXX_ERROR(logger_, "Got unexpected message on frame ready channel");
+            }
+            catch (IpcMessageException& e)
+            {
+                LOG4CXX_ERROR(logger_, "Error decoding message on frame ready channel: " << e.what());
+            }
+        }
+
+        //! Handles a ready frame and releases its buffer back to the frame receiver
+        //!
+        //! The hold time runs from receipt of the ready notification to the release being sent. The
+        //! notification latency, from the frame receiver timestamping the notification to its
+        //! receipt, is only available for binary and ring notifications.
+        void handle_frame(int frame_number, int buffer_id, int frame_state, uint64_t notify_timestamp_ns)
+        {
+            uint64_t received_ns = clock_ns(true);
+            int64_t latency_ns = notify_timestamp_ns ? (int64_t)(clock_ns(false) - notify_timestamp_ns) : -1;
+
+            if ((buffer_id < 0) || ((size_t)buffer_id >= buffer_manager_->get_num_buffers()))
+            {
+                LOG4CXX_ERROR(logger_, "Got frame ready notification for frame " << frame_number
+                        << " with illegal buffer ID " << buffer_id);
+                return;
+            }
+            LOG4CXX_DEBUG_LEVEL(2, logger_, "Got frame ready notification for frame " << frame_number
+                    << " in buffer " << buffer_id << " state " << frame_state);
+
+            // The frame header holds the frame state even if the notification does not
+            if (percival_layout_)
+            {
+                const Decoder::FrameHeader* header =
+                        reinterpret_cast<const Decoder::FrameHeader*>(buffer_manager_->get_metadata_address(buffer_id));
+                frame_state = header->frame_state;
+                packets_received_ += header->packets_received;
+            }
+            if (frame_state == FrameDecoder::FrameReceiveStateTimedout)
+            {
+                frames_timedout_++;
+            }
+
+            bool valid = true;
+            switch (frame_mode_)
+            {
+            case FrameModeTouch:
+                touch_frame(buffer_id);
+                break;
+            case FrameModeValidate:
+                valid = validate_frame(frame_number, buffer_id);
+                break;
+            default:
+                break;
+            }
+
+            release_frame(frame_number, buffer_id);
+
+            last_release_ns_ = clock_ns(true);
+            if (total_stats_.frames == 0)
+            {
+                first_frame_ns_ = received_ns;
+            }
+
+            uint64_t hold_ns = last_release_ns_ - received_ns;
+            total_stats_.add(buffer_manager_->get_buffer_size(), hold_ns, latency_ns);
+            interval_stats_.add(buffer_manager_->get_buffer_size(), hold_ns, latency_ns);
+
+            if (hold_log_.is_open())
+            {
+                hold_log_ << frame_number << "," << buffer_id << "," << frame_state << "," << hold_ns << ","
+                          << latency_ns << "," << (valid ? 1 : 0) << "\n";
+            }
+        }
+
+        void release_frame(int frame_number, int buffer_id)
+        {
+            if (release_ring_)
+            {
+                NotificationRing::Entry entry;
+                memset(&entry, 0, sizeof(entry));
+                entry.frame_number = frame_number;
+                entry.buffer_id    = buffer_id;
+                entry.timestamp_ns = clock_ns(false);
+
+                // The release ring holds every buffer, so can only be full transiently
+                while (!release_ring_->push(entry) && run_processor)
+                {
+                    usleep(100);
+                }
+            }
+            else
+            {
+                IpcFrameNotification release(IpcMessage::MsgValNotifyFrameRelease, frame_number, buffer_id);
+                std::string release_encoded = binary_notify_ ? release.encode() : release.encode_json();
+                release_channel_.send(release_encoded);
+            }
+        }
+
+        //! Reads one word from each page of the frame data, so that all pages are faulted in
+        void touch_frame(int buffer_id)
+        {
+            const volatile uint64_t* data =
+                    reinterpret_cast<const volatile uint64_t*>(buffer_manager_->get_buffer_address(buffer_id));
+            size_t stride = SharedBufferManager::buffer_alignment / sizeof(uint64_t);
+            size_t num_words = buffer_manager_->get_buffer_size() / sizeof(uint64_t);
+            for (size_t word = 0; word < num_words; word += stride)
+            {
+                touch_sum_ += data[word];
+            }
+        }
+
+        //! Validates a frame against the frameProducer data pattern, in which every 16-bit word of a
+        //! payload holds the index of its packet in the frame. Only packets marked as received in the
+        //! frame header are checked.
+        bool validate_frame(int frame_number, int buffer_id)
+        {
+            const Decoder::FrameHeader* header =
+                    reinterpret_cast<const Decoder::FrameHeader*>(buffer_manager_->get_metadata_address(buffer_id));
+            const uint8_t* data = reinterpret_cast<const uint8_t*>(buffer_manager_->get_buffer_address(buffer_id));
+
+            bool valid = true;
+            if ((header->frame_number != (uint32_t)frame_number) ||
+                (header->packets_received != header->packet_state.count()))
+            {
+                LOG4CXX_WARN(logger_, "Frame " << frame_number << " in buffer " << buffer_id
+                        << " has inconsistent header: frame number " << header->frame_number << " packets received "
+                        << header->packets_received << " packets marked " << header->packet_state.count());
+                valid = false;
+            }
+
+            for (unsigned int type = 0; type < Geometry::num_data_types; type++)
+            {
+                for (unsigned int subframe = 0; subframe < Geometry::num_subframes; subframe++)
+                {
+                    for (unsigned int packet_number = 0; packet_number < Geometry::num_subframe_packets; packet_number++)
+                    {
+                        size_t packet_index = Geometry::packet_index(type, subframe, packet_number);
+                        if (!header->packet_state.test(packet_index))
+                        {
+                            continue;
+                        }
+                        const uint16_t* payload = reinterpret_cast<const uint16_t*>(
+                                data + Geometry::payload_offset(type, subframe, packet_number));
+                        size_t num_words = Geometry::payload_size(packet_number) / sizeof(uint16_t);
+                        uint16_t expected = static_cast<uint16_t>(packet_index);
+                        for (size_t word = 0; word < num_words; word++)
+                        {
+                            if (payload[word] != expected)
+                            {
+                                LOG4CXX_DEBUG_LEVEL(1, logger_, "Frame " << frame_number << " packet " << packet_index
+                                        << " has invalid data at word " << word << ": " << payload[word]);
+                                packets_invalid_++;
+                                valid = false;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (!valid)
+            {
+                frames_invalid_++;
+            }
+            return valid;
+        }
+
+        LoggerPtr              logger_;
+        SharedBufferManagerPtr buffer_manager_;
+        FrameMode              frame_mode_;
+        bool                   binary_notify_;   //!< Frame notifications are exchanged in binary format
+        bool                   percival_layout_; //!< Shared buffer is laid out for Percival emulator frames
+
+        IpcChannel ctrl_channel_;
+        IpcChannel ready_channel_;
+        IpcChannel release_channel_;
+        boost::scoped_ptr<NotificationRing> ready_ring_;   //!< Ready ring, if notifications are exchanged through rings
+        boost::scoped_ptr<NotificationRing> release_ring_; //!< Release ring, if notifications are exchanged through rings
+
+        std::ofstream hold_log_;         //!< Per-frame hold time log, if enabled
+        HoldStats     total_stats_;
+        HoldStats     interval_stats_;
+        uint64_t      first_frame_ns_;   //!< Monotonic time the first frame was received
+        uint64_t      last_release_ns_;  //!< Monotonic time the last frame was released
+        uint64_t      frames_timedout_;
+        uint64_t      packets_received_; //!< Packets received into frames, from the frame headers
+        uint64_t      frames_invalid_;
+        uint64_t      packets_invalid_;
+        uint64_t      touch_sum_;        //!< Sum of touched words, keeping the reads from being optimised away
+    };
+}
+
+int main(int argc, char** argv)
+{
+    BasicConfigurator::configure();
+    LoggerPtr logger(Logger::getLogger("FrameProcessor"));
+
+    signal(SIGINT, intHandler);
+    signal(SIGTERM, intHandler);
+
+    try
+    {
+        po::options_description options("Options");
+        options.add_options()
+                ("help,h",
+                    "Print this help message")
+                ("debug,d",      po::value<unsigned int>()->default_value(0),
+                    "Set the debug level")
+                ("logconfig,l",  po::value<std::string>(),
+                    "Set the log4cxx logging configuration file")
+                ("ctrl",         po::value<std::string>()->default_value(Defaults::default_ctrl_chan_endpoint),
+                    "Set the frame receiver control channel endpoint")
+                ("ready",        po::value<std::string>()->default_value(Defaults::default_frame_ready_endpoint),
+                    "Set the frame ready notification channel endpoint")
+                ("release",      po::value<std::string>()->default_value(Defaults::default_frame_release_endpoint),
+                    "Set the frame release notification channel endpoint")
+                ("sharedbuf",    po::value<std::string>()->default_value(Defaults::default_shared_buffer_name),
+                    "Set the name of the shared memory frame buffer")
+                ("notifyformat", po::value<std::string>()->default_value(Defaults::default_notify_format),
+                    "Set the frame notification format to request from the frame receiver (json or binary), which applies to all its processors")
+                ("notifyring",   po::value<bool>()->default_value(false),
+                    "Exchange frame ready and release notifications through the rings in the shared buffer")
+                ("mode",         po::value<std::string>()->default_value("release"),
+                    "Set the frame handling before release (release, touch or validate)")
+                ("frames,n",     po::value<uint64_t>()->default_value(0),
+                    "Set the number of frames to process before exiting (0 runs until interrupted)")
+                ("interval",     po::value<unsigned int>()->default_value(1),
+                    "Set the interval in seconds between throughput reports (0 disables them)")
+                ("holdlog",      po::value<std::string>(),
+                    "Write the hold time of each frame to the specified CSV file")
+                ;
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, options), vm);
+        po::notify(vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << "usage: frameProcessor [options]" << std::endl << std::endl << options << std::endl;
+            return 0;
+        }
+
+        if (vm.count("logconfig"))
+        {
+            PropertyConfigurator::configure(vm["logconfig"].as<std::string>());
+        }
+        set_debug_level(vm["debug"].as<unsigned int>());
+
+        std::string mode_name = vm["mode"].as<std::string>();
+        FrameMode frame_mode;
+        if (mode_name == "release")
+        {
+            frame_mode = FrameModeRelease;
+        }
+        else if (mode_name == "touch")
+        {
+            frame_mode = FrameModeTouch;
+        }
+        else if (mode_name == "validate")
+        {
+            frame_mode = FrameModeValidate;
+        }
+        else
+        {
+            LOG4CXX_ERROR(logger, "Illegal frame handling mode specified: " << mode_name);
+            return 1;
+        }
+
+        std::string notify_format = vm["notifyformat"].as<std::string>();
+        if ((notify_format != "json") && (notify_format != "binary"))
+        {
+            LOG4CXX_ERROR(logger, "Illegal notification format specified: " << notify_format);
+            return 1;
+        }
+
+        FrameProcessor processor(logger, vm["sharedbuf"].as<std::string>(), frame_mode, notify_format == "binary");
+
+        // Attach to the rings before connecting, so that no frame ready notifications are published
+        // on the channel, which is not read once the rings are attached
+        if (vm["notifyring"].as<bool>())
+        {
+            processor.attach_rings();
+        }
+        processor.connect(vm["ctrl"].as<std::string>(), vm["ready"].as<std::string>(), vm["release"].as<std::string>());
+        if (vm.count("holdlog"))
+        {
+            processor.set_hold_log(vm["holdlog"].as<std::string>());
+        }
+
+        processor.run(vm["frames"].as<uint64_t>(), vm["interval"].as<unsigned int>());
+        processor.detach_rings();
+        processor.report(std::cout);
+
+        if (processor.get_num_invalid_frames())
+        {
+            return 2;
+        }
+    }
+    catch (std::exception& e)
+    {
+        LOG4CXX_ERROR(logger, "Frame processor failed: " << e.what());
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,524 @@
+/*!
+ * frameProducer.cpp - high-rate Percival emulator frame producer
+ *
+ * This tool generates a simulated Percival emulator UDP frame data stream at rates high enough to
+ * stress the frame receiver. Frames are laid out with the geometry compiled into the
+ * PercivalEmulatorFrameDecoder, their subframes distributed over the destination ports, and sent
+ * with sendmmsg from one or more threads, each handling a share of the ports. Packet loss,
+ * reordering and duplication can be injected to exercise the receive path under realistic
+ * conditions.
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "PercivalEmulatorFrameDecoder.h"
+#include "FrameReceiverConfig.h"
+#include "ThreadPlacement.h"
+#include "gettime.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+
+#include <boost/bind.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace
+{
+    typedef FrameReceiver::PercivalEmulatorFrameDecoder Decoder;
+    typedef Decoder::Geometry Geometry;
+
+    volatile bool stop_producer = false;
+
+    void intHandler(int sig)
+    {
+        stop_producer = true;
+    }
+
+    uint64_t clock_mono_ns(void)
+    {
+        struct timespec ts;
+        gettime(&ts, true);
+        return ((uint64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+    }
+
+    //! Producer configuration shared by all sending threads
+    typedef struct
+    {
+        std::string           dest_address;    //!< Destination IP address
+        std::vector<uint16_t> ports;           //!< Destination ports, subframes being distributed over them
+        unsigned int          threads;         //!< Number of sending threads
+        std::vector<int>      cpus;            //!< CPUs to pin sending threads to, in turn
+        unsigned int          frames;          //!< Number of frames to send
+        uint32_t              first_frame;     //!< Frame number of the first frame
+        double                rate;            //!< Frames per second, 0 to send as fast as possible
+        unsigned int          batch_size;      //!< Maximum datagrams per sendmmsg call
+        int                   send_buffer_size;//!< Socket send buffer size, 0 for the system default
+        double                loss;            //!< Probability of dropping each packet
+        double                reorder;         //!< Probability of moving each packet later in the stream
+        unsigned int          reorder_window;  //!< Maximum number of packets a packet is moved by
+        double                duplicate;       //!< Probability of sending each packet twice
+        unsigned int          seed;            //!< Random number seed for impairment injection
+    } ProducerConfig;
+
+    //! Counters accumulated by each sending thread
+    typedef struct
+    {
+        uint64_t frames_sent;
+        uint64_t packets_sent;
+        uint64_t bytes_sent;
+        uint64_t packets_lost;
+        uint64_t packets_duplicated;
+        uint64_t packets_reordered;
+        uint64_t send_calls;
+        uint64_t send_retries;
+        uint64_t frames_late;
+    } ProducerStats;
+
+    //! Packet of a frame, identified by its data type, subframe and packet number
+    typedef struct
+    {
+        uint8_t  type;
+        uint8_t  subframe;
+        uint16_t packet_number;
+    } FramePacket;
+
+    //! ProducerThread - sends the packets of each frame destined to a share of the ports
+    class ProducerThread
+    {
+    public:
+
+        ProducerThread(const ProducerConfig& config, const uint8_t* frame_data, unsigned int thread_index) :
+            config_(config),
+            frame_data_(frame_data),
+            thread_index_(thread_index),
+            seed_(config.seed + thread_index),
+            socket_(-1),
+            msgs_(config.batch_size),
+            iovecs_(config.batch_size * 2),
+            headers_(config.batch_size * Geometry::packet_header_size, 0)
+        {
+            memset(&stats_, 0, sizeof(stats_));
+            memset(&msgs_[0], 0, sizeof(struct mmsghdr) * msgs_.size());
+
+            // Each thread sends to the ports whose index it owns
+            for (unsigned int port_index = 0; port_index < config_.ports.size(); port_index++)
+            {
+                if ((port_index % config_.threads) == thread_index_)
+                {
+                    struct sockaddr_in addr;
+                    memset(&addr, 0, sizeof(addr));
+                    addr.sin_family = AF_INET;
+                    addr.sin_port = htons(config_.ports[port_index]);
+                    addr.sin_addr.s_addr = inet_addr(config_.dest_address.c_str());
+                    dest_addrs_.push_back(addr);
+                }
+                else
+                {
+                    dest_addrs_.push_back(sockaddr_in());
+                }
+            }
+        }
+
+        ~ProducerThread()
+        {
+            if (socket_ >= 0)
+            {
+                close(socket_);
+            }
+        }
+
+        //! Opens the sending socket, throwing a std::runtime_error on failure
+        void open_socket(void)
+        {
+            socket_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+            if (socket_ < 0)
+            {
+                throw std::runtime_error(std::string("Failed to create send socket: ") + strerror(errno));
+            }
+            if ((config_.send_buffer_size > 0) &&
+                (setsockopt(socket_, SOL_SOCKET, SO_SNDBUF, &config_.send_buffer_size, sizeof(config_.send_buffer_size)) < 0))
+            {
+                throw std::runtime_error(std::string("Failed to set send socket buffer size: ") + strerror(errno));
+            }
+        }
+
+        //! Sends all frames, pacing them from the common start time
+        void run(uint64_t start_ns)
+        {
+            if (!config_.cpus.empty())
+            {
+                int cpu = config_.cpus[thread_index_ % config_.cpus.size()];
+                int rc = FrameReceiver::set_thread_affinity(cpu);
+                if (rc != 0)
+                {
+                    std::cerr << "Producer thread " << thread_index_ << " failed to pin to CPU " << cpu << ": "
+                              << strerror(rc) << std::endl;
+                }
+            }
+
+            uint64_t frame_period_ns = (config_.rate > 0.0) ? (uint64_t)(1.0e9 / config_.rate) : 0;
+
+            for (unsigned int frame = 0; (frame < config_.frames) && !stop_producer; frame++)
+            {
+                if (frame_period_ns)
+                {
+                    uint64_t due_ns = start_ns + (frame * frame_period_ns);
+                    uint64_t now_ns = clock_mono_ns();
+                    if (now_ns < due_ns)
+                    {
+                        uint64_t wait_ns = due_ns - now_ns;
+                        struct timespec wait_time;
+                        wait_time.tv_sec  = wait_ns / 1000000000;
+                        wait_time.tv_nsec = wait_ns % 1000000000;
+                        nanosleep(&wait_time, 0);
+                    }
+                    else if (frame > 0)
+                    {
+                        stats_.frames_late++;
+                    }
+                }
+
+                build_frame_packets();
+                send_frame_packets(config_.first_frame + frame);
+                stats_.frames_sent++;
+            }
+        }
+
+        const ProducerStats& get_stats(void) const
+        {
+            return stats_;
+        }
+
+    private:
+
+        bool chance(double probability)
+        {
+            return (probability > 0.0) && (((double)rand_r(&seed_) / ((double)RAND_MAX + 1.0)) < probability);
+        }
+
+        //! Builds the list of packets this thread sends for a frame, injecting impairments
+        void build_frame_packets(void)
+        {
+            packets_.clear();
+            for (uint8_t type = 0; type < Geometry::num_data_types; type++)
+            {
+                for (uint8_t subframe = 0; subframe < Geometry::num_subframes; subframe++)
+                {
+                    if ((port_index(type, subframe) % config_.threads) != thread_index_)
+                    {
+                        continue;
+                    }
+                    for (uint16_t packet_number = 0; packet_number < Geometry::num_subframe_packets; packet_number++)
+                    {
+                        if (chance(config_.loss))
+                        {
+                            stats_.packets_lost++;
+                            continue;
+                        }
+                        FramePacket packet = {type, subframe, packet_number};
+                        packets_.push_back(packet);
+                        if (chance(config_.duplicate))
+                        {
+                            packets_.push_back(packet);
+                            stats_.packets_duplicated++;
+                        }
+                    }
+                }
+            }
+
+            // Move packets later in the stream by up to the reorder window
+            if ((config_.reorder > 0.0) && (config_.reorder_window > 0))
+            {
+                for (size_t idx = 0; idx + 1 < packets_.size(); idx++)
+                {
+                    if (chance(config_.reorder))
+                    {
+                        size_t swap_idx = idx + 1 + (rand_r(&seed_) % config_.reorder_window);
+                        if (swap_idx >= packets_.size())
+                        {
+                            swap_idx = packets_.size() - 1;
+                        }
+                        std::swap(packets_[idx], packets_[swap_idx]);
+                        stats_.packets_reordered++;
+                    }
+                }
+            }
+        }
+
+        //! Sends the packets of a frame in batches. Sample packets carry the preceding frame number,
+        //! as sent by the emulator firmware.
+        void send_frame_packets(uint32_t frame_number)
+        {
+            for (size_t first = 0; first < packets_.size(); first += config_.batch_size)
+            {
+                size_t batch_depth = std::min(packets_.size() - first, (size_t)config_.batch_size);
+
+                for (size_t msg = 0; msg < batch_depth; msg++)
+                {
+                    const FramePacket& packet = packets_[first + msg];
+                    uint8_t* header = &headers_[msg * Geometry::packet_header_size];
+
+                    uint32_t frame_number_be = htonl((packet.type == Decoder::PacketTypeSample) ? frame_number - 1 : frame_number);
+                    uint16_t packet_number_be = htons(packet.packet_number);
+                    header[Geometry::packet_type_offset] = packet.type;
+                    header[Geometry::subframe_number_offset] = packet.subframe;
+                    memcpy(header + Geometry::frame_number_offset, &frame_number_be, sizeof(frame_number_be));
+                    memcpy(header + Geometry::packet_number_offset, &packet_number_be, sizeof(packet_number_be));
+
+                    size_t payload_size = Geometry::payload_size(packet.packet_number);
+                    iovecs_[msg*2].iov_base   = header;
+                    iovecs_[msg*2].iov_len    = Geometry::packet_header_size;
+                    iovecs_[msg*2+1].iov_base = const_cast<uint8_t*>(frame_data_) +
+                            Geometry::payload_offset(packet.type, packet.subframe, packet.packet_number);
+                    iovecs_[msg*2+1].iov_len  = payload_size;
+
+                    msgs_[msg].msg_hdr.msg_iov     = &iovecs_[msg*2];
+                    msgs_[msg].msg_hdr.msg_iovlen  = 2;
+                    msgs_[msg].msg_hdr.msg_name    = &dest_addrs_[port_index(packet.type, packet.subframe)];
+                    msgs_[msg].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+
+                    stats_.bytes_sent += Geometry::packet_header_size + payload_size;
+                }
+
+                send_batch(batch_depth);
+                stats_.packets_sent += batch_depth;
+            }
+        }
+
+        //! Sends a batch of datagrams, retrying while the socket send buffer is full
+        void send_batch(size_t batch_depth)
+        {
+            size_t sent = 0;
+            while (sent < batch_depth)
+            {
+#ifdef __MACH__
+                // sendmmsg is not available on OS X, so send one datagram per call
+                int rc = (sendmsg(socket_, &msgs_[sent].msg_hdr, 0) < 0) ? -1 : 1;
+#else
+                int rc = sendmmsg(socket_, &msgs_[sent], batch_depth - sent, 0);
+#endif
+                if (rc < 0)
+                {
+                    if ((errno == ENOBUFS) || (errno == EAGAIN) || (errno == EINTR))
+                    {
+                        stats_.send_retries++;
+                        sched_yield();
+                        continue;
+                    }
+                    throw std::runtime_error(std::string("Send failed: ") + strerror(errno));
+                }
+                sent += rc;
+                stats_.send_calls++;
+            }
+        }
+
+        unsigned int port_index(unsigned int type, unsigned int subframe) const
+        {
+            return ((type * Geometry::num_subframes) + subframe) % config_.ports.size();
+        }
+
+        const ProducerConfig&           config_;
+        const uint8_t*                  frame_data_;  //!< Frame payload data, laid out as in a frame buffer
+        unsigned int                    thread_index_;
+        unsigned int                    seed_;        //!< Random number state for impairment injection
+        int                             socket_;
+        std::vector<struct sockaddr_in> dest_addrs_;  //!< Destination addresses by port index
+        std::vector<FramePacket>        packets_;     //!< Packets to send for the current frame
+        std::vector<struct mmsghdr>     msgs_;
+        std::vector<struct iovec>       iovecs_;
+        std::vector<uint8_t>            headers_;     //!< Packet headers of the current batch
+        ProducerStats                   stats_;
+    };
+
+    void run_thread(boost::shared_ptr<ProducerThread> thread, uint64_t start_ns, bool* error)
+    {
+        try {
+            thread->run(start_ns);
+        }
+        catch (std::exception& e) {
+            std::cerr << "Producer thread failed: " << e.what() << std::endl;
+            *error = true;
+            stop_producer = true;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    signal(SIGINT, intHandler);
+    signal(SIGTERM, intHandler);
+
+    ProducerConfig config;
+    FrameReceiver::FrameReceiverConfig parser;
+
+    try
+    {
+        po::options_description options("Options");
+        options.add_options()
+                ("help,h",
+                    "Print this help message")
+                ("destaddr,a",   po::value<std::string>(&config.dest_address)->default_value("127.0.0.1"),
+                    "Set the destination IP address")
+                ("port,p",       po::value<std::string>()->default_value(FrameReceiver::Defaults::default_rx_port_list),
+                    "Set the destination port(s), over which subframes are distributed in turn")
+                ("threads,t",    po::value<unsigned int>(&config.threads)->default_value(1),
+                    "Set the number of sending threads, each sending to a share of the ports")
+                ("cpu",          po::value<std::string>()->default_value(""),
+                    "Set the CPU(s) to pin sending threads to, assigned to threads in turn")
+                ("frames,n",     po::value<unsigned int>(&config.frames)->default_value(1),
+                    "Set the number of frames to send")
+                ("firstframe",   po::value<uint32_t>(&config.first_frame)->default_value(1),
+                    "Set the frame number of the first frame")
+                ("rate,r",       po::value<double>(&config.rate)->default_value(10.0),
+                    "Set the frame rate in frames per second (0 sends as fast as possible)")
+                ("batch,b",      po::value<unsigned int>(&config.batch_size)->default_value(64),
+                    "Set the maximum number of datagrams sent per sendmmsg call")
+                ("sndbuf",       po::value<int>(&config.send_buffer_size)->default_value(0),
+                    "Set the socket send buffer size (0 uses the system default)")
+                ("loss",         po::value<double>(&config.loss)->default_value(0.0),
+                    "Set the probability of dropping each packet")
+                ("reorder",      po::value<double>(&config.reorder)->default_value(0.0),
+                    "Set the probability of moving each packet later in the stream")
+                ("reorderwindow", po::value<unsigned int>(&config.reorder_window)->default_value(16),
+                    "Set the maximum number of packets a reordered packet is moved by")
+                ("duplicate",    po::value<double>(&config.duplicate)->default_value(0.0),
+                    "Set the probability of sending each packet twice")
+                ("seed",         po::value<unsigned int>(&config.seed)->default_value(1),
+                    "Set the random number seed for impairment injection")
+                ;
+
+        po::variables_map vm;
+        po::store(po::parse_command_line(argc, argv, options), vm);
+        po::notify(vm);
+
+        if (vm.count("help"))
+        {
+            std::cout << "usage: frameProducer [options]" << std::endl << std::endl << options << std::endl;
+            return 0;
+        }
+
+        parser.tokenize_port_list(config.ports, vm["port"].as<std::string>());
+        parser.tokenize_cpu_list(config.cpus, vm["cpu"].as<std::string>());
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "Error parsing options: " << e.what() << std::endl;
+        return 1;
+    }
+
+    if (config.ports.empty())
+    {
+        std::cerr << "No destination ports specified" << std::endl;
+        return 1;
+    }
+    if (inet_addr(config.dest_address.c_str()) == INADDR_NONE)
+    {
+        std::cerr << "Illegal destination address specified: " << config.dest_address << std::endl;
+        return 1;
+    }
+    if (config.batch_size == 0)
+    {
+        config.batch_size = 1;
+    }
+
+    // Threads without a port to send to would be idle
+    if (config.threads == 0)
+    {
+        config.threads = 1;
+    }
+    if (config.threads > config.ports.size())
+    {
+        std::cerr << "Limiting number of sending threads to the number of ports: " << config.ports.size() << std::endl;
+        config.threads = config.ports.size();
+    }
+
+    // Fill each payload with its packet index in the frame, so that consumers can check that frames
+    // were assembled correctly
+    std::vector<uint8_t> frame_data(Geometry::total_frame_size);
+    for (unsigned int type = 0; type < Geometry::num_data_types; type++)
+    {
+        for (unsigned int subframe = 0; subframe < Geometry::num_subframes; subframe++)
+        {
+            for (unsigned int packet_number = 0; packet_number < Geometry::num_subframe_packets; packet_number++)
+            {
+                uint16_t* payload = reinterpret_cast<uint16_t*>(&frame_data[Geometry::payload_offset(type, subframe, packet_number)]);
+                uint16_t value = static_cast<uint16_t>(Geometry::packet_index(type, subframe, packet_number));
+                std::fill(payload, payload + (Geometry::payload_size(packet_number) / sizeof(uint16_t)), value);
+            }
+        }
+    }
+
+    std::vector<boost::shared_ptr<ProducerThread> > producers;
+    try
+    {
+        for (unsigned int thread = 0; thread < config.threads; thread++)
+        {
+            producers.push_back(boost::shared_ptr<ProducerThread>(new ProducerThread(config, &frame_data[0], thread)));
+            producers.back()->open_socket();
+        }
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Sending " << config.frames << " frames of " << Geometry::num_frame_packets << " packets to "
+              << config.dest_address << " on " << config.ports.size() << " port(s) from " << config.threads
+              << " thread(s)" << std::endl;
+
+    bool thread_error = false;
+    uint64_t start_ns = clock_mono_ns();
+    boost::thread_group threads;
+    for (unsigned int thread = 0; thread < config.threads; thread++)
+    {
+        threads.create_thread(boost::bind(&run_thread, producers[thread], start_ns, &thread_error));
+    }
+    threads.join_all();
+    double elapsed = (double)(clock_mono_ns() - start_ns) / 1.0e9;
+
+    ProducerStats total;
+    memset(&total, 0, sizeof(total));
+    for (unsigned int thread = 0; thread < config.threads; thread++)
+    {
+        const ProducerStats& stats = producers[thread]->get_stats();
+        total.frames_sent = std::max(total.frames_sent, stats.frames_sent);
+        total.packets_sent += stats.packets_sent;
+        total.bytes_sent += stats.bytes_sent;
+        total.packets_lost += stats.packets_lost;
+        total.packets_duplicated += stats.packets_duplicated;
+        total.packets_reordered += stats.packets_reordered;
+        total.send_calls += stats.send_calls;
+        total.send_retries += stats.send_retries;
+        total.frames_late += stats.frames_late;
+    }
+
+    std::cout << "Sent " << total.frames_sent << " frames, " << total.packets_sent << " packets, "
+              << total.bytes_sent << " bytes in " << elapsed << " secs";
+    if (elapsed > 0)
+    {
+        std::cout << " (" << (total.frames_sent / elapsed) << " frames/s, "
+                  << (total.packets_sent / elapsed) << " packets/s, "
+                  << ((total.bytes_sent * 8) / elapsed / 1.0e9) << " Gbit/s)";
+    }
+    std::cout << std::endl;
+    std::cout << "Packets lost: " << total.packets_lost << " duplicated: " << total.packets_duplicated
+              << " reordered: " << total.packets_reordered << std::endl;
+    std::cout << "Send calls: " << total.send_calls << " (average batch "
+              << (total.send_calls ? ((double)total.packets_sent / total.send_calls) : 0.0)
+              << ") retries: " << total.send_retries << " late frames: " << total.frames_late << std::endl;
+
+    return thread_error ? 1 : 0;
+}
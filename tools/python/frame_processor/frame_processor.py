@@ -1,6 +1,7 @@
 from frame_receiver.ipc_channel import IpcChannel, IpcChannelException
 from frame_receiver.ipc_message import IpcMessage, IpcMessageException
 from frame_receiver.shared_buffer_manager import SharedBufferManager, SharedBufferManagerException
+from frame_receiver.notification_ring import NotificationRing, NotificationRingException
 from frame_processor_config import FrameProcessorConfig
 from percival_emulator_frame_decoder import PercivalEmulatorFrameDecoder, PercivalFrameHeader, PercivalFrameData
 
@@ -51,6 +52,10 @@ class FrameProcessor(object):
         
         self.frame_decoder = PercivalEmulatorFrameDecoder(self.shared_buffer_manager)
         
+        # Notification rings, attached on request when run
+        self.ready_ring = None
+        self.release_ring = None
+        
         # Zero frames recevied counter
         self.frames_received = 0
         
@@ -77,6 +82,30 @@ class FrameProcessor(object):
         # Ready channel subscribes to all topics
         self.ready_channel.subscribe(b'')
         
+        # Negotiate binary frame notifications if requested
+        if self.config.binary_notify:
+            configure_msg = IpcMessage(msg_type='cmd', msg_val='configure')
+            configure_msg.set_param('notification_format', 'binary')
+            self.ctrl_channel.send(configure_msg.encode())
+            
+            reply = IpcMessage(from_str=self.ctrl_channel.recv())
+            if reply.get_msg_type() == 'ack':
+                self.logger.info("Frame receiver sending binary frame notifications")
+            else:
+                self.logger.error("Frame receiver rejected binary frame notifications")
+        
+        # Attach to the frame notification rings in the shared buffer if requested, in which case
+        # frame ready and release notifications are exchanged through them instead of the channels
+        if self.config.notify_ring:
+            self.ready_ring = NotificationRing(self.shared_buffer_manager.mapfile, 
+                                               self.shared_buffer_manager.get_aux_offset())
+            self.release_ring = NotificationRing(self.shared_buffer_manager.mapfile, 
+                                                 self.ready_ring.get_end_offset())
+            self.ready_ring.attach_consumer()
+            self.logger.info("Attached to frame notification rings with %d entries" % self.ready_ring.capacity)
+            self.frame_processor = threading.Thread(target=self.process_frames_ring)
+            self.frame_processor.daemon = True
+        
         # Launch the frame processing thread
         self.frame_processor.start()
         
@@ -103,8 +132,28 @@ class FrameProcessor(object):
             self._run = False;
             
         self.frame_processor.join()
+        if self.ready_ring is not None:
+            self.detach_rings()
         self.logger.info("Frame processor shutting down")
         
+    def detach_rings(self):
+        
+        # Release the frames still on the ready ring unprocessed, so that their buffers are returned
+        # to the frame receiver
+        self.ready_ring.detach_consumer()
+        
+        frames_drained = 0
+        entry = self.ready_ring.pop()
+        while entry is not None:
+            (frame_number, buffer_id) = entry[0:2]
+            while not self.release_ring.push(frame_number, buffer_id):
+                time.sleep(0.0001)
+            frames_drained += 1
+            entry = self.ready_ring.pop()
+            
+        if frames_drained:
+            self.logger.info("Released %d unprocessed frames on detaching from the ready ring" % frames_drained)
+        
     def process_frames(self):
         
         self.frame_header = Struct('<LLQQL')
@@ -128,7 +177,10 @@ class FrameProcessor(object):
                     release_msg = IpcMessage(msg_type='notify', msg_val='frame_release')
                     release_msg.set_param('frame', frame_number)
                     release_msg.set_param('buffer_id', buffer_id)
-                    self.release_channel.send(release_msg.encode())
+                    if self.config.binary_notify:
+                        self.release_channel.send(release_msg.encode_binary())
+                    else:
+                        self.release_channel.send(release_msg.encode())
                     
                     self.frames_received += 1
                     
@@ -138,6 +190,29 @@ class FrameProcessor(object):
         
         self.logger.info("Frame processing thread interrupted, terminating")
         
+    def process_frames_ring(self):
+        
+        while self._run:
+            
+            if self.ready_ring.wait(100):
+                
+                entry = self.ready_ring.pop()
+                while entry is not None:
+                    
+                    (frame_number, buffer_id) = entry[0:2]
+                    self.logger.debug("Got frame ready ring entry for frame %d buffer ID %d" %(frame_number, buffer_id))
+                    
+                    if not self.config.bypass_mode:
+                        self.handle_frame(frame_number, buffer_id)
+                    
+                    while not self.release_ring.push(frame_number, buffer_id):
+                        time.sleep(0.0001)
+                    
+                    self.frames_received += 1
+                    entry = self.ready_ring.pop()
+                    
+        self.logger.info("Frame processing thread interrupted, terminating")
+        
     def handle_frame(self, frame_number, buffer_id):
         
         self.frame_decoder.decode_header(buffer_id)
@@ -145,6 +220,9 @@ class FrameProcessor(object):
                       (frame_number, buffer_id, self.frame_decoder.header.frame_number, 
                        self.frame_decoder.header.frame_state, self.frame_decoder.header.frame_start_time.isoformat(),
                        self.frame_decoder.header.packets_received))
+        if not self.frame_decoder.header.packet_state.complete():
+            self.logger.debug("Frame %d missing packet ranges: %s" %
+                              (frame_number, str(self.frame_decoder.header.packet_state.missing_ranges())))
 
         self.frame_decoder.decode_data(buffer_id)
         self.logger.debug("Frame start: " + ' '.join("0x{:04x}".format(val) for val in self.frame_decoder.data.pixels[:32]))
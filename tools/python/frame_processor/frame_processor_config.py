@@ -12,6 +12,8 @@ class FrameProcessorConfig(object):
         defaults['release_endpoint'] = "tcp://127.0.0.1:5002"
         defaults['sharedbuf']        = "FrameReceiverBuffer"
         defaults['bypass_mode']      = False
+        defaults['binary_notify']    = False
+        defaults['notify_ring']      = False
         defaults['frames']       = 0
 
         # Parse the command-line argument list        
@@ -43,6 +45,10 @@ class FrameProcessorConfig(object):
                             help='Specify the name of the shared memory frame buffer')
         parser.add_argument('--bypass_mode', action="store_true",
                             help="Enable frame decoding bypass mode" )
+        parser.add_argument('--binary_notify', action="store_true",
+                            help="Request binary frame ready and release notifications from the frame receiver, which applies to all its processors")
+        parser.add_argument('--notify_ring', action="store_true",
+                            help="Exchange frame ready and release notifications through the rings in the shared buffer")
         parser.add_argument('--frames', type=int, default=None, dest='frames',
                             help="Specify the number of frames to receive before shutting down")
         
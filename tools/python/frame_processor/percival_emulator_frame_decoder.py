@@ -1,9 +1,11 @@
 from datetime import datetime
 from struct import calcsize, Struct
+from frame_receiver.packet_bitmap import PacketBitmap
 
 class PercivalFrameHeader(Struct):
     
-    frame_header_format = '<LLQQL1024BL'
+    num_frame_packets = 1024
+    frame_header_format = '<LLQQL4x' + str(PacketBitmap.num_words(num_frame_packets)) + 'Q'
     
     @classmethod
     def size(cls):       
@@ -19,7 +21,7 @@ class PercivalFrameHeader(Struct):
         self.frame_state = header_vals[1]
         self.frame_start_time = datetime.fromtimestamp(float(header_vals[2]) + float(header_vals[3])/1000000000)
         self.packets_received = header_vals[4]
-        self.packet_state = header_vals[5:-1]
+        self.packet_state = PacketBitmap(header_vals[5:], PercivalFrameHeader.num_frame_packets)
         
 class PercivalFrameData(Struct):
     
@@ -57,10 +59,10 @@ class PercivalEmulatorFrameDecoder(object):
     
     def decode_header(self, buffer_id):
         
-        header_raw = self.shared_buffer_manager.read_buffer(buffer_id, PercivalFrameHeader.size())
+        header_raw = self.shared_buffer_manager.read_metadata(buffer_id, PercivalFrameHeader.size())
         self.header = PercivalFrameHeader(header_raw)
         
     def decode_data(self, buffer_id):
         
-        data_raw = self.shared_buffer_manager.read_buffer(buffer_id, PercivalFrameData.size(), PercivalFrameHeader.size())
+        data_raw = self.shared_buffer_manager.read_buffer(buffer_id, PercivalFrameData.size())
         self.data = PercivalFrameData(data_raw) 
\ No newline at end of file
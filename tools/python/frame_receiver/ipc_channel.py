@@ -45,9 +45,13 @@ class IpcChannel(object):
         
     def send(self, data):
         
-        if data[-1] != '\0':
-            data = data + '\0'
-        self.socket.send_string(data)
+        # Always terminate the message as the C++ IpcChannel does, since binary messages may 
+        # legitimately end with a null byte which the receiver would otherwise strip. Messages
+        # are sent as raw bytes, as binary messages are not valid text in any encoding
+        if isinstance(data, unicode):
+            data = data.encode('utf-8')
+        data = data + '\0'
+        self.socket.send(data)
         
     def recv(self):
         
@@ -1,5 +1,7 @@
 import json
 import datetime
+import time
+from struct import Struct
 
 class IpcMessageException(Exception):
     
@@ -12,6 +14,14 @@ class IpcMessageException(Exception):
     
 class IpcMessage(object):
     
+    # Binary frame notification format, see IpcFrameNotification.h
+    BINARY_MAGIC   = 0x4E5246F5
+    BINARY_VERSION = 1
+    BINARY_FORMAT  = Struct('<LHBBLlLLQQ')
+    
+    MSG_TYPES = ['cmd', 'ack', 'nack', 'notify']
+    MSG_VALS  = ['reset', 'status', 'frame_ready', 'frame_release', 'configure']
+    
     def __init__(self, msg_type=None, msg_val=None, from_str=None):
         
         self.attrs = {}
@@ -22,12 +32,20 @@ class IpcMessage(object):
             self.attrs['timestamp'] = datetime.datetime.now().isoformat()
             self.attrs['params'] = {}
             
+        elif IpcMessage.is_binary(from_str):
+            self._decode_binary(from_str)
+            
         else:
             try:
                 self.attrs = json.loads(from_str)
                 
             except ValueError, e:
                 raise IpcMessageException("Illegal message JSON format: " + str(e))
+    
+    @staticmethod
+    def is_binary(data):
+        
+        return len(data) >= 4 and Struct('<L').unpack_from(data)[0] == IpcMessage.BINARY_MAGIC
             
     def is_valid(self):
         
@@ -87,6 +105,19 @@ class IpcMessage(object):
         
         return json.dumps(self.attrs)
     
+    def encode_binary(self):
+        
+        try:
+            msg_type = IpcMessage.MSG_TYPES.index(self.attrs['msg_type'])
+            msg_val  = IpcMessage.MSG_VALS.index(self.attrs['msg_val'])
+        except (KeyError, ValueError), e:
+            raise IpcMessageException("Message cannot be encoded in binary format: " + str(e))
+        
+        return IpcMessage.BINARY_FORMAT.pack(
+            IpcMessage.BINARY_MAGIC, IpcMessage.BINARY_VERSION, msg_type, msg_val,
+            self.get_param('frame', 0), self.get_param('buffer_id', -1), self.get_param('frame_state', 0), 0,
+            self.get_param('frame_start_time', 0), int(time.time() * 1e9))
+    
     def __eq__(self, other):
         
         return self.attrs == other.attrs
@@ -110,4 +141,29 @@ class IpcMessage(object):
             else:
                 attr_value = default_value
                 
-        return attr_value
\ No newline at end of file
+        return attr_value
+    
+    def _decode_binary(self, data):
+        
+        if len(data) < IpcMessage.BINARY_FORMAT.size:
+            raise IpcMessageException("Binary frame notification too short: %d bytes" % len(data))
+        
+        (magic, version, msg_type, msg_val, frame, buffer_id, frame_state, reserved, 
+         frame_start_time, timestamp) = IpcMessage.BINARY_FORMAT.unpack_from(data)
+        
+        if version != IpcMessage.BINARY_VERSION:
+            raise IpcMessageException("Unsupported binary frame notification version: %d" % version)
+        
+        try:
+            self.attrs['msg_type'] = IpcMessage.MSG_TYPES[msg_type]
+            self.attrs['msg_val']  = IpcMessage.MSG_VALS[msg_val]
+        except IndexError:
+            raise IpcMessageException("Illegal binary frame notification type %d value %d" % (msg_type, msg_val))
+        
+        self.attrs['timestamp'] = datetime.datetime.fromtimestamp(timestamp / 1e9).isoformat()
+        self.attrs['params'] = {
+            'frame'            : frame,
+            'buffer_id'        : buffer_id,
+            'frame_state'      : frame_state,
+            'frame_start_time' : frame_start_time,
+        }
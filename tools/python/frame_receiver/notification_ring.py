@@ -0,0 +1,159 @@
+import time
+import ctypes
+import platform
+from struct import Struct
+
+class NotificationRingException(Exception):
+    
+    def __init__(self, msg, errno=None):
+        self.msg = msg
+        self.errno = errno
+        
+    def __str__(self):
+        return str(self.msg)
+    
+class NotificationRing(object):
+    """
+    Frame notification ring in a shared memory map, compatible with the NotificationRing class of
+    the frame receiver. This attaches to a ring already initialised by the frame receiver and
+    waits for entries by polling, as Python has no direct access to the futex the ring uses for
+    wakeups. Pushing an entry wakes a waiting consumer through the futex where the system call
+    number is known. The ring is single-producer, single-consumer, so a process must only push 
+    to or pop from each ring once. A consumer must call attach_consumer() before popping entries
+    and detach_consumer() when done, as the frame receiver only pushes to an attached ring, then
+    pop and release the entries still on the ring so that their frame buffers are not lost.
+    """
+    
+    MAGIC    = 0x474E4952
+    VERSION  = 2
+    
+    Control  = Struct('<LLLL')
+    Index    = Struct('<L')
+    Entry    = Struct('<LlLLQQ')
+    
+    CONTROL_SIZE     = 256
+    CONSUMER_OFFSET  = 16
+    HEAD_OFFSET      = 64
+    TAIL_OFFSET      = 128
+    WAKE_SEQ_OFFSET  = 192
+    WAITERS_OFFSET   = 196
+    
+    FUTEX_WAKE       = 1
+    SYS_FUTEX        = {'x86_64': 202, 'aarch64': 98, 'i686': 240, 'i386': 240}.get(platform.machine())
+    
+    _libc            = None
+    
+    def __init__(self, mapfile, offset):
+        
+        self.mapfile = mapfile
+        self.offset = offset
+        
+        (magic, version, capacity, entry_size) = NotificationRing.Control.unpack_from(mapfile, offset)
+        if magic != NotificationRing.MAGIC:
+            raise NotificationRingException("No notification ring found at offset " + str(offset))
+        if version != NotificationRing.VERSION or entry_size != NotificationRing.Entry.size:
+            raise NotificationRingException("Incompatible notification ring version %d entry size %d" % (version, entry_size))
+        
+        self.capacity = capacity
+        self.mask = capacity - 1
+        self.entries_offset = offset + NotificationRing.CONTROL_SIZE
+        
+    @staticmethod
+    def get_region_size(capacity):
+        
+        rounded = 1
+        while rounded < capacity:
+            rounded <<= 1
+        return NotificationRing.CONTROL_SIZE + (rounded * NotificationRing.Entry.size)
+    
+    def get_end_offset(self):
+        
+        return self.entries_offset + (self.capacity * NotificationRing.Entry.size)
+    
+    def _get_index(self, index_offset):
+        
+        return NotificationRing.Index.unpack_from(self.mapfile, self.offset + index_offset)[0]
+    
+    def _set_index(self, index_offset, value):
+        
+        NotificationRing.Index.pack_into(self.mapfile, self.offset + index_offset, value & 0xFFFFFFFF)
+        
+    def attach_consumer(self):
+        """
+        Register as the consumer of the ring. Any entries left on it, e.g. pushed while a previous
+        consumer was detaching, are kept for this consumer to pop.
+        """
+        self._set_index(NotificationRing.CONSUMER_OFFSET, 1)
+        
+    def detach_consumer(self):
+        """
+        Deregister as the consumer of the ring. The entries remaining on the ring should then be
+        popped and released.
+        """
+        self._set_index(NotificationRing.CONSUMER_OFFSET, 0)
+        
+    def has_consumer(self):
+        
+        return self._get_index(NotificationRing.CONSUMER_OFFSET) != 0
+    
+    def _wake_consumer(self):
+        
+        if self._get_index(NotificationRing.WAITERS_OFFSET) == 0:
+            return
+        
+        self._set_index(NotificationRing.WAKE_SEQ_OFFSET, self._get_index(NotificationRing.WAKE_SEQ_OFFSET) + 1)
+        if NotificationRing.SYS_FUTEX is not None:
+            try:
+                wake_seq = ctypes.c_int32.from_buffer(self.mapfile, self.offset + NotificationRing.WAKE_SEQ_OFFSET)
+                if NotificationRing._libc is None:
+                    NotificationRing._libc = ctypes.CDLL(None, use_errno=True)
+                NotificationRing._libc.syscall(NotificationRing.SYS_FUTEX, ctypes.byref(wake_seq),
+                                               NotificationRing.FUTEX_WAKE, 0x7FFFFFFF, None, None, 0)
+                del wake_seq
+            except (TypeError, OSError, AttributeError):
+                pass
+        
+    def size(self):
+        
+        return (self._get_index(NotificationRing.HEAD_OFFSET) - self._get_index(NotificationRing.TAIL_OFFSET)) & 0xFFFFFFFF
+    
+    def pop(self):
+        """
+        Pop an entry from the ring, returning a tuple of (frame_number, buffer_id, frame_state, 
+        frame_start_time_ns, timestamp_ns), or None if the ring is empty.
+        """
+        tail = self._get_index(NotificationRing.TAIL_OFFSET)
+        if tail == self._get_index(NotificationRing.HEAD_OFFSET):
+            return None
+        
+        entry = NotificationRing.Entry.unpack_from(self.mapfile, self.entries_offset + ((tail & self.mask) * NotificationRing.Entry.size))
+        self._set_index(NotificationRing.TAIL_OFFSET, tail + 1)
+        
+        return (entry[0], entry[1], entry[2], entry[4], entry[5])
+    
+    def push(self, frame_number, buffer_id, frame_state=0, frame_start_time_ns=0):
+        """
+        Push an entry onto the ring, returning False if the ring is full.
+        """
+        head = self._get_index(NotificationRing.HEAD_OFFSET)
+        if ((head - self._get_index(NotificationRing.TAIL_OFFSET)) & 0xFFFFFFFF) > self.mask:
+            return False
+        
+        NotificationRing.Entry.pack_into(self.mapfile, self.entries_offset + ((head & self.mask) * NotificationRing.Entry.size),
+                                         frame_number, buffer_id, frame_state, 0, frame_start_time_ns, int(time.time() * 1e9))
+        self._set_index(NotificationRing.HEAD_OFFSET, head + 1)
+        self._wake_consumer()
+        
+        return True
+    
+    def wait(self, timeout_ms, poll_interval_ms=0.1):
+        """
+        Wait for entries to become available on the ring by polling, returning True if the ring is
+        not empty.
+        """
+        deadline = time.time() + (timeout_ms / 1000.0)
+        while self.size() == 0:
+            if time.time() >= deadline:
+                return False
+            time.sleep(poll_interval_ms / 1000.0)
+        return True
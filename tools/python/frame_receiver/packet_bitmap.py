@@ -0,0 +1,58 @@
+class PacketBitmap(object):
+    """
+    Bit-packed map of the packets received into a frame, compatible with the PacketBitmap class of
+    the frame receiver. The bitmap is built from the 64-bit words of a frame header, packet n being
+    received if bit (n % 64) of word (n / 64) is set.
+    """
+    
+    BITS_PER_WORD = 64
+    
+    @staticmethod
+    def num_words(num_packets):
+        
+        return (num_packets + PacketBitmap.BITS_PER_WORD - 1) // PacketBitmap.BITS_PER_WORD
+    
+    def __init__(self, words, num_packets):
+        
+        self.num_packets = num_packets
+        
+        # Combine the words into a single integer, masking off bits beyond the last packet
+        self.bits = 0
+        for (word_idx, word) in enumerate(words[:PacketBitmap.num_words(num_packets)]):
+            self.bits |= word << (word_idx * PacketBitmap.BITS_PER_WORD)
+        self.bits &= (1 << num_packets) - 1
+        
+    def test(self, packet):
+        
+        return (self.bits >> packet) & 1 == 1
+    
+    def count(self):
+        
+        return bin(self.bits).count('1')
+    
+    def complete(self):
+        
+        return self.bits == (1 << self.num_packets) - 1
+    
+    def missing_ranges(self):
+        """
+        Returns a list of (first, count) tuples of the ranges of consecutive missing packets
+        """
+        ranges = []
+        missing = ~self.bits & ((1 << self.num_packets) - 1)
+        packet = 0
+        while missing:
+            
+            # Skip to the next missing packet and measure the run of missing packets there
+            skip = (missing & -missing).bit_length() - 1
+            missing >>= skip
+            packet += skip
+            run = (~missing & (missing + 1)).bit_length() - 1
+            ranges.append((packet, run))
+            missing >>= run
+            packet += run
+        return ranges
+    
+    def num_missing(self):
+        
+        return self.num_packets - self.count()
@@ -13,14 +13,35 @@ class SharedBufferManagerException(Exception):
         return str(self.msg)
     
 class SharedBufferManager(object):
+    """
+    Shared memory frame buffer manager, compatible with the SharedBufferManager class of the frame
+    receiver. The segment holds a versioned header, followed by cache-line padded per-buffer metadata
+    slots, page-aligned buffer slots and an optional auxiliary region. The offsets of each are 
+    recorded in the header.
+    """
     
-    Header = Struct('QQQ')
+    Header = Struct('QQQLLQQQQQ')
+    LAYOUT_MAGIC = 0x46425253
+    LAYOUT_VERSION = 2
+    metadata_alignment = 64
+    buffer_alignment = 4096
     _last_manager_id = 0x100
     
-    def __init__(self, shared_mem_name, shared_mem_size=0, buffer_size=0, remove_when_deleted=False):
+    @staticmethod
+    def _align_up(value, alignment):
+        
+        return (value + alignment - 1) & ~(alignment - 1)
+    
+    def __init__(self, shared_mem_name, shared_mem_size=0, buffer_size=0, remove_when_deleted=False, metadata_size=0):
         
         if shared_mem_size:
-            total_size = shared_mem_size + SharedBufferManager.Header.size
+            num_buffers = int(shared_mem_size / buffer_size)
+            metadata_offset = self._align_up(SharedBufferManager.Header.size, SharedBufferManager.metadata_alignment)
+            metadata_stride = self._align_up(metadata_size, SharedBufferManager.metadata_alignment)
+            buffer_offset = self._align_up(metadata_offset + (num_buffers * metadata_stride), SharedBufferManager.buffer_alignment)
+            buffer_stride = self._align_up(buffer_size, SharedBufferManager.buffer_alignment)
+            aux_offset = buffer_offset + (num_buffers * buffer_stride)
+            total_size = aux_offset
         else:
             total_size = 0
             
@@ -33,12 +54,17 @@ class SharedBufferManager(object):
         self.buffer_size = ctypes.c_int64.from_buffer(self.mapfile, 16)
         
         if shared_mem_size:
-                       
-            self.manager_id.value = self.__class__._last_manager_id
+            
+            SharedBufferManager.Header.pack_into(self.mapfile, 0, self.__class__._last_manager_id, num_buffers, buffer_size,
+                                                 SharedBufferManager.LAYOUT_MAGIC, SharedBufferManager.LAYOUT_VERSION,
+                                                 metadata_offset, metadata_stride, buffer_offset, buffer_stride, aux_offset)
             self.__class__._last_manager_id += 1
-            self.num_buffers.value = int(shared_mem_size / buffer_size)
-            self.buffer_size.value = buffer_size
             
+        (magic, version, self.metadata_offset, self.metadata_stride, self.buffer_offset, 
+         self.buffer_stride, self.aux_offset) = SharedBufferManager.Header.unpack_from(self.mapfile, 0)[3:]
+        
+        if magic != SharedBufferManager.LAYOUT_MAGIC or version != SharedBufferManager.LAYOUT_VERSION:
+            raise SharedBufferManagerException("Shared memory " + shared_mem_name + " does not have a compatible shared buffer layout")
             
         self.mapfile.seek(0)
         
@@ -59,7 +85,33 @@ class SharedBufferManager(object):
         if buffer_index < 0 or buffer_index >= self.num_buffers.value:
             raise SharedBufferManagerException("Illegal buffer index specified: " + str(buffer_index))
         
-        return SharedBufferManager.Header.size + (self.buffer_size.value * buffer_index)
+        return self.buffer_offset + (self.buffer_stride * buffer_index)
+    
+    def get_metadata_address(self, buffer_index):
+        
+        if buffer_index < 0 or buffer_index >= self.num_buffers.value:
+            raise SharedBufferManagerException("Illegal buffer index specified: " + str(buffer_index))
+        if not self.metadata_stride:
+            raise SharedBufferManagerException("Shared buffer has no metadata slots")
+        
+        return self.metadata_offset + (self.metadata_stride * buffer_index)
+    
+    def get_metadata_size(self):
+        
+        return self.metadata_stride
+    
+    def get_aux_offset(self):
+        
+        return self.aux_offset
+    
+    def get_aux_size(self):
+        
+        return max(self.shared_mem.size - self.aux_offset, 0)
+    
+    def read_metadata(self, buffer_index, num_bytes=1):
+        
+        start_addr = self.get_metadata_address(buffer_index)
+        return self.mapfile[start_addr:start_addr + num_bytes]
     
     def read_buffer(self, buffer_index, num_bytes=1, offset=0):
         
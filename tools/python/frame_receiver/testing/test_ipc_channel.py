@@ -1,4 +1,5 @@
 from frame_receiver.ipc_channel import IpcChannel, IpcChannelException
+from frame_receiver.ipc_message import IpcMessage
 from nose.tools import assert_equal
 
 class TestIpcChannel:
@@ -25,4 +26,21 @@ class TestIpcChannel:
         self.send_channel.send(msg)
         
         reply = self.recv_channel.recv()
-        assert_equal(msg, reply)
\ No newline at end of file
+        assert_equal(msg, reply)
+        
+    def test_binary_send_receive(self):
+        
+        # Binary frame notifications are not valid text and must be sent as raw bytes
+        release_msg = IpcMessage(msg_type='notify', msg_val='frame_release')
+        release_msg.set_param('frame', 1234)
+        release_msg.set_param('buffer_id', 7)
+        msg = release_msg.encode_binary()
+        self.send_channel.send(msg)
+        
+        reply = self.recv_channel.recv()
+        assert_equal(msg, reply)
+        
+        decoded = IpcMessage(from_str=reply)
+        assert_equal(decoded.get_msg_val(), 'frame_release')
+        assert_equal(decoded.get_param('frame'), 1234)
+        assert_equal(decoded.get_param('buffer_id'), 7)
@@ -177,4 +177,46 @@ def test_invalid_msg_from_string():
     ex = cm.exception
     assert_regexp_matches(ex.msg, "Illegal message JSON format*")
                             
-       
\ No newline at end of file
+       
+def test_binary_frame_notification_round_trip():
+    
+    # Encode a frame ready notification in binary format and decode it again
+    ready_msg = IpcMessage(msg_type='notify', msg_val='frame_ready')
+    ready_msg.set_param('frame', 1234)
+    ready_msg.set_param('buffer_id', 7)
+    ready_msg.set_param('frame_state', 2)
+    
+    encoded = ready_msg.encode_binary()
+    assert_equal(len(encoded), IpcMessage.BINARY_FORMAT.size)
+    assert_true(IpcMessage.is_binary(encoded))
+    assert_false(IpcMessage.is_binary(ready_msg.encode()))
+    
+    decoded = IpcMessage(from_str=encoded)
+    assert_true(decoded.is_valid())
+    assert_equal(decoded.get_msg_type(), 'notify')
+    assert_equal(decoded.get_msg_val(), 'frame_ready')
+    assert_equal(decoded.get_param('frame'), 1234)
+    assert_equal(decoded.get_param('buffer_id'), 7)
+    assert_equal(decoded.get_param('frame_state'), 2)
+    
+def test_binary_frame_notification_known_layout():
+    
+    # Decode a frame release notification laid out as by the C++ IpcFrameNotification class
+    encoded = ('\xF5\x46\x52\x4E\x01\x00\x03\x03'
+               '\x2A\x00\x00\x00\x05\x00\x00\x00'
+               '\x03\x00\x00\x00\x00\x00\x00\x00'
+               '\x01\x00\x00\x00\x00\x00\x00\x00'
+               '\x02\x00\x00\x00\x00\x00\x00\x00')
+    
+    decoded = IpcMessage(from_str=encoded)
+    assert_equal(decoded.get_msg_type(), 'notify')
+    assert_equal(decoded.get_msg_val(), 'frame_release')
+    assert_equal(decoded.get_param('frame'), 42)
+    assert_equal(decoded.get_param('buffer_id'), 5)
+    assert_equal(decoded.get_param('frame_state'), 3)
+    assert_equal(decoded.get_param('frame_start_time'), 1)
+    
+    # Truncated notifications are rejected
+    with assert_raises(IpcMessageException) as cm:
+        truncated_msg = IpcMessage(from_str=encoded[:-1])
+    assert_regexp_matches(cm.exception.msg, "Binary frame notification too short*")
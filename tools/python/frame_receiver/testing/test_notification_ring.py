@@ -0,0 +1,78 @@
+from frame_receiver.notification_ring import NotificationRing, NotificationRingException
+from nose.tools import assert_equal, assert_true, assert_false, assert_raises, assert_regexp_matches
+
+ring_offset   = 64
+ring_capacity = 4
+
+def make_ring_region():
+    
+    # Initialise a ring control block as the frame receiver would
+    region = bytearray(ring_offset + NotificationRing.get_region_size(ring_capacity))
+    NotificationRing.Control.pack_into(region, ring_offset, NotificationRing.MAGIC, 
+                                       NotificationRing.VERSION, ring_capacity, NotificationRing.Entry.size)
+    return region
+
+def test_ring_region_size():
+    
+    assert_equal(NotificationRing.get_region_size(3), 256 + (4 * 32))
+    assert_equal(NotificationRing.get_region_size(4), 256 + (4 * 32))
+    
+def test_attach_missing_ring():
+    
+    region = bytearray(NotificationRing.get_region_size(ring_capacity))
+    with assert_raises(NotificationRingException) as cm:
+        ring = NotificationRing(region, 0)
+    assert_regexp_matches(cm.exception.msg, "No notification ring found")
+    
+def test_ring_push_pop_wraparound():
+    
+    region = make_ring_region()
+    producer = NotificationRing(region, ring_offset)
+    consumer = NotificationRing(region, ring_offset)
+    assert_equal(consumer.capacity, ring_capacity)
+    assert_equal(producer.get_end_offset(), len(region))
+    
+    assert_equal(consumer.pop(), None)
+    assert_false(consumer.wait(0))
+    
+    next_push = 0
+    next_pop = 0
+    for ring_pass in range(5):
+        while producer.push(next_push, next_push % 7, 2, 1000 + next_push):
+            next_push += 1
+        assert_equal(consumer.size(), ring_capacity)
+        assert_true(consumer.wait(0))
+        
+        for i in range(ring_capacity - 1):
+            (frame_number, buffer_id, frame_state, frame_start_time, timestamp) = consumer.pop()
+            assert_equal(frame_number, next_pop)
+            assert_equal(buffer_id, next_pop % 7)
+            assert_equal(frame_state, 2)
+            assert_equal(frame_start_time, 1000 + next_pop)
+            next_pop += 1
+    
+    assert_equal(consumer.size(), 1)
+
+def test_attach_consumer_keeps_entries():
+    
+    region = make_ring_region()
+    producer = NotificationRing(region, ring_offset)
+    consumer = NotificationRing(region, ring_offset)
+    assert_false(producer.has_consumer())
+    
+    consumer.attach_consumer()
+    assert_true(producer.has_consumer())
+    assert_true(producer.push(1, 1))
+    assert_true(producer.push(2, 2))
+    
+    # Entries still on the ring are drained by the consumer after detaching
+    consumer.detach_consumer()
+    assert_false(producer.has_consumer())
+    assert_equal(consumer.pop()[0:2], (1, 1))
+    
+    # Entries left on the ring, e.g. pushed as the previous consumer detached, are handed to the
+    # next consumer to attach
+    next_consumer = NotificationRing(region, ring_offset)
+    next_consumer.attach_consumer()
+    assert_equal(next_consumer.pop()[0:2], (2, 2))
+    assert_equal(next_consumer.pop(), None)
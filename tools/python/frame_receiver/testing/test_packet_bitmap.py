@@ -0,0 +1,35 @@
+from frame_receiver.packet_bitmap import PacketBitmap
+from nose.tools import assert_equal, assert_true, assert_false
+
+def make_words(num_packets, received):
+    
+    words = [0] * PacketBitmap.num_words(num_packets)
+    for packet in received:
+        words[packet // 64] |= 1 << (packet % 64)
+    return words
+
+def test_bitmap_empty():
+    
+    bitmap = PacketBitmap(make_words(130, []), 130)
+    assert_equal(bitmap.count(), 0)
+    assert_false(bitmap.complete())
+    assert_equal(bitmap.missing_ranges(), [(0, 130)])
+    
+def test_bitmap_ignores_bits_beyond_last_packet():
+    
+    words = make_words(130, range(130))
+    words[-1] |= 1 << 63
+    bitmap = PacketBitmap(words, 130)
+    assert_equal(bitmap.count(), 130)
+    assert_true(bitmap.complete())
+    assert_equal(bitmap.missing_ranges(), [])
+    
+def test_bitmap_missing_ranges():
+    
+    received = [packet for packet in range(1023) if packet != 5 and (packet < 60 or packet >= 70)]
+    bitmap = PacketBitmap(make_words(1024, received), 1024)
+    assert_true(bitmap.test(0))
+    assert_false(bitmap.test(5))
+    assert_equal(bitmap.count(), 1012)
+    assert_equal(bitmap.num_missing(), 12)
+    assert_equal(bitmap.missing_ranges(), [(5, 1), (60, 10), (1023, 1)])
@@ -57,4 +57,21 @@ class TestSharedBufferManager:
         read_raw = self.shared_buffer_manager.read_buffer(0, data_block.size)
         read_values = data_block.unpack(read_raw)
         
-        assert_equal(values, read_values)
\ No newline at end of file
+        assert_equal(values, read_values)
+        
+    def test_segment_layout(self):
+        
+        metadata_size = 100
+        layout_manager = SharedBufferManager("TestLayoutSharedBuffer", shared_mem_size, buffer_size, True, metadata_size)
+        
+        assert_equal(layout_manager.get_metadata_size(), 128)
+        assert_equal(self.shared_buffer_manager.get_metadata_size(), 0)
+        assert_equal(layout_manager.get_buffer_address(0) % SharedBufferManager.buffer_alignment, 0)
+        assert_equal(layout_manager.get_buffer_address(1) - layout_manager.get_buffer_address(0), 
+                     SharedBufferManager.buffer_alignment)
+        assert_equal(layout_manager.get_metadata_address(1) - layout_manager.get_metadata_address(0), 128)
+        assert_equal(layout_manager.get_metadata_address(num_buffers-1) + metadata_size <= layout_manager.get_buffer_address(0), True)
+        
+        with assert_raises(SharedBufferManagerException) as cm:
+            self.shared_buffer_manager.get_metadata_address(0)
+        assert_regexp_matches(cm.exception.msg, "no metadata slots")
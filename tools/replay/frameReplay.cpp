@@ -0,0 +1,221 @@
+/*!
+ * frameReplay.cpp - replays a packet capture into a frame decoder
+ *
+ * This tool injects the datagrams of a capture file, written by the frame receiver with the
+ * --capture option or taken with tcpdump, into a frame decoder without sockets. Frame buffers
+ * are released as soon as frames are handed on, and the frames completed, timed out and the
+ * packets dropped by the decoder are reported along with the replay rate, so that receive
+ * behaviour with real loss and reordering patterns can be benchmarked and regression tested.
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include "FrameDecoderRegistry.h"
+#include "FrameReceiverConfig.h"
+#include "FrameReceiverDefaults.h"
+#include "PacketReplayer.h"
+#include "SharedBufferManager.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <log4cxx/basicconfigurator.h>
+#include <log4cxx/propertyconfigurator.h>
+
+#include <boost/bind.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+using namespace FrameReceiver;
+
+extern void set_debug_level(DebugLevel level);
+
+namespace
+{
+    //! Counts frames handed on by the decoder and releases their buffers back to it immediately
+    class FrameReleaser
+    {
+    public:
+        FrameReleaser(FrameDecoderPtr frame_decoder) :
+            frame_decoder_(frame_decoder),
+            frames_complete_(0),
+            frames_timedout_(0)
+        { }
+
+        void frame_ready(int buffer_id, int frame_number)
+        {
+            FrameDecoder::FrameReceiveState frame_state = FrameDecoder::FrameReceiveStateComplete;
+            struct timespec frame_start_time;
+            frame_decoder_->get_frame_status(buffer_id, frame_state, frame_start_time);
+
+            if (frame_state == FrameDecoder::FrameReceiveStateTimedout)
+            {
+                frames_timedout_++;
+            }
+            else
+            {
+                frames_complete_++;
+            }
+            frame_decoder_->push_empty_buffer(buffer_id);
+        }
+
+        FrameDecoderPtr frame_decoder_;
+        uint64_t        frames_complete_;
+        uint64_t        frames_timedout_;
+    };
+}
+
+int main(int argc, char** argv)
+{
+    BasicConfigurator::configure();
+    LoggerPtr logger(Logger::getLogger("FrameReplay"));
+
+    try
+    {
+        po::options_description options("Options");
+        options.add_options()
+                ("help,h",
+                    "Print this help message")
+                ("debug,d",      po::value<unsigned int>()->default_value(0),
+                    "Set the debug level")
+                ("logconfig,l",  po::value<std::string>(),
+                    "Set the log4cxx logging configuration file")
+                ("file",         po::value<std::string>(),
+                    "Set the packet capture file to replay")
+                ("sensortype,s", po::value<std::string>()->default_value("percivalemulator"),
+                    "Set the sensor type selecting the frame decoder")
+                ("decoderplugin", po::value<std::vector<std::string> >()->composing(),
+                    "Load frame decoder plugin library, may be given more than once")
+                ("decoderparam", po::value<std::vector<std::string> >()->composing(),
+                    "Set a frame decoder specific parameter as name=value, may be given more than once")
+                ("port,p",       po::value<std::string>()->default_value(""),
+                    "Only replay datagrams sent to the specified ports (default all ports)")
+                ("maxmem,m",     po::value<std::size_t>()->default_value(Defaults::default_max_buffer_mem),
+                    "Set the amount of memory to allocate for frame buffers")
+                ("rxbatch",      po::value<unsigned int>()->default_value(Defaults::default_rx_batch_size),
+                    "Set the number of datagrams handed to the decoder per call (1 uses the per-packet decoder methods)")
+                ("speed",        po::value<double>()->default_value(0.0),
+                    "Set the replay rate relative to the original capture (0 replays as fast as possible)")
+                ("loops",        po::value<unsigned int>()->default_value(1),
+                    "Set the number of times to replay the capture")
+                ("frametimeout", po::value<unsigned int>()->default_value(Defaults::default_frame_timeout_ms),
+                    "Set the incomplete frame timeout in ms")
+                ;
+
+        po::positional_options_description positional;
+        positional.add("file", 1);
+
+        po::variables_map vm;
+        po::store(po::command_line_parser(argc, argv).options(options).positional(positional).run(), vm);
+        po::notify(vm);
+
+        if (vm.count("help") || !vm.count("file"))
+        {
+            std::cout << "usage: frameReplay [options] capture_file" << std::endl << std::endl << options << std::endl;
+            return vm.count("help") ? 0 : 1;
+        }
+
+        if (vm.count("logconfig"))
+        {
+            PropertyConfigurator::configure(vm["logconfig"].as<std::string>());
+        }
+        set_debug_level(vm["debug"].as<unsigned int>());
+
+        // Create the decoder from the registry, as the frame receiver does
+        FrameReceiverConfig config;
+        FrameDecoderParams decoder_params;
+        if (vm.count("decoderparam"))
+        {
+            std::vector<std::string> params = vm["decoderparam"].as<std::vector<std::string> >();
+            for (std::vector<std::string>::iterator itr = params.begin(); itr != params.end(); ++itr)
+            {
+                std::size_t separator = itr->find('=');
+                if ((separator == std::string::npos) || (separator == 0))
+                {
+                    LOG4CXX_ERROR(logger, "Illegal decoder parameter specified: " << *itr);
+                    return 1;
+                }
+                decoder_params[itr->substr(0, separator)] = itr->substr(separator + 1);
+            }
+        }
+
+        FrameDecoderRegistry decoder_registry;
+        if (vm.count("decoderplugin"))
+        {
+            std::vector<std::string> plugins = vm["decoderplugin"].as<std::vector<std::string> >();
+            for (std::vector<std::string>::iterator itr = plugins.begin(); itr != plugins.end(); ++itr)
+            {
+                decoder_registry.load_plugin(*itr);
+            }
+        }
+
+        std::string sensor_name = vm["sensortype"].as<std::string>();
+        if (!decoder_registry.has_decoder(sensor_name))
+        {
+            LOG4CXX_ERROR(logger, "No frame decoder available for sensor type " << sensor_name);
+            return 1;
+        }
+        FrameDecoderPtr frame_decoder = decoder_registry.create_decoder(sensor_name, logger, false,
+                vm["frametimeout"].as<unsigned int>(), decoder_params);
+
+        // Frame buffers are held in a private shared buffer, released as soon as each frame is ready
+        std::stringstream buffer_name;
+        buffer_name << "FrameReplayBuffer_" << getpid();
+        SharedBufferManagerPtr buffer_manager(new SharedBufferManager(buffer_name.str(), vm["maxmem"].as<std::size_t>(),
+                frame_decoder->get_frame_buffer_size(), true, 0, frame_decoder->get_frame_header_size()));
+        frame_decoder->register_buffer_manager(buffer_manager);
+        for (size_t buffer_id = 0; buffer_id < buffer_manager->get_num_buffers(); buffer_id++)
+        {
+            frame_decoder->push_empty_buffer(buffer_id);
+        }
+
+        FrameReleaser releaser(frame_decoder);
+        frame_decoder->register_frame_ready_callback(boost::bind(&FrameReleaser::frame_ready, &releaser, _1, _2));
+
+        PacketReplayer replayer(logger, frame_decoder, vm["rxbatch"].as<unsigned int>(), vm["speed"].as<double>());
+        std::vector<uint16_t> ports;
+        config.tokenize_port_list(ports, vm["port"].as<std::string>());
+        replayer.set_ports(ports);
+
+        PacketCaptureReader reader(vm["file"].as<std::string>());
+        unsigned int loops = vm["loops"].as<unsigned int>();
+        for (unsigned int loop = 0; loop < loops; loop++)
+        {
+            reader.rewind();
+            replayer.replay(reader);
+        }
+
+        // Let incomplete frames at the end of the capture time out, as they would in the receiver
+        if (frame_decoder->get_num_mapped_buffers())
+        {
+            usleep(vm["frametimeout"].as<unsigned int>() * 1000);
+            frame_decoder->check_frame_timeouts();
+        }
+
+        double elapsed = replayer.get_elapsed_secs();
+        std::cout << "Replayed " << replayer.get_num_packets() << " datagrams, " << replayer.get_num_bytes()
+                  << " bytes in " << elapsed << " secs";
+        if (elapsed > 0)
+        {
+            std::cout << " (" << (replayer.get_num_packets() / elapsed) << " packets/s, "
+                      << ((replayer.get_num_bytes() * 8) / elapsed / 1.0e9) << " Gbit/s)";
+        }
+        std::cout << std::endl;
+        std::cout << "Frames complete: " << releaser.frames_complete_
+                  << " timed out: " << releaser.frames_timedout_ << std::endl;
+        std::cout << "Datagrams truncated in capture: " << replayer.get_num_truncated()
+                  << " non-UDP records skipped: " << reader.get_num_skipped() << std::endl;
+
+        frame_decoder->monitor_buffers();
+    }
+    catch (std::exception& e)
+    {
+        LOG4CXX_ERROR(logger, "Replay failed: " << e.what());
+        return 1;
+    }
+
+    return 0;
+}